@@ -11,12 +11,11 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 TARGET = BaseButton
 TEMPLATE = app
 
+include(basetoolbutton.pri)
 
 SOURCES += main.cpp\
-        widget.cpp \
-    basetoolbutton.cpp
+        widget.cpp
 
-HEADERS  += widget.h \
-    basetoolbutton.h
+HEADERS  += widget.h
 
 FORMS    += widget.ui
@@ -0,0 +1,164 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  共享的逐帧动画驱动
+ */
+#include "baseanimationdriver.h"
+#include "basetimerwheel.h"
+#include <QCoreApplication>
+#include <QPointer>
+
+#define ANIMATION_FRAME_INTERVAL_MS 16 //默认帧间隔 ms
+
+/*
+ *@brief:   获取动画驱动单例(父对象为应用程序对象，随应用程序一起析构)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseAnimationDriver*:动画驱动单例指针
+ */
+BaseAnimationDriver *BaseAnimationDriver::instance()
+{
+    static QPointer<BaseAnimationDriver> animationDriver;
+    if(animationDriver.isNull())
+    {
+        animationDriver = new BaseAnimationDriver(QCoreApplication::instance());
+    }
+    return animationDriver.data();
+}
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseAnimationDriver::BaseAnimationDriver(QObject *parent)
+    :QObject(parent)
+{
+    frameIntervalMs = ANIMATION_FRAME_INTERVAL_MS;
+    lastFrameMs = -1;
+    frames = 0;
+    skippedFrames = 0;
+
+    frameTimer = new QTimer(this);
+    frameTimer->setTimerType(Qt::PreciseTimer);
+    frameTimer->setInterval(frameIntervalMs);
+    connect(frameTimer,SIGNAL(timeout()),this,SLOT(frameTimerSlot()));
+}
+/*
+ *@brief:   启动接收者的逐帧动画，已启动时不重复注册
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   receiver:接收者，析构时会自动停止
+ *@param:   member:帧槽函数名(不带参数及SLOT宏)，如"animationFrameSlot"，槽函数参数为(qint64 frameMs)
+ */
+void BaseAnimationDriver::start(QObject *receiver, const char *member)
+{
+    if(receiver == NULL || receiverHash.contains(receiver))
+    {
+        return;
+    }
+    //注册时查找一次槽函数，每帧直接调用，不再按名称查找
+    QByteArray signature = QByteArray(member)+"(qint64)";
+    int methodIndex = receiver->metaObject()->indexOfMethod(signature.constData());
+    if(methodIndex < 0)
+    {
+        qWarning("BaseAnimationDriver::start: no such method %s",signature.constData());
+        return;
+    }
+    receiverHash.insert(receiver,receiver->metaObject()->method(methodIndex));
+    connect(receiver,SIGNAL(destroyed(QObject*)),this,SLOT(receiverDestroyedSlot(QObject*)),
+            Qt::UniqueConnection);
+
+    if(!frameTimer->isActive())
+    {
+        lastFrameMs = -1;
+        frameTimer->start();
+    }
+}
+/*
+ *@brief:   停止接收者的逐帧动画，没有活动动画时停止帧定时器
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   receiver:接收者
+ */
+void BaseAnimationDriver::stop(QObject *receiver)
+{
+    if(receiverHash.remove(receiver) == 0)
+    {
+        return;
+    }
+    disconnect(receiver,SIGNAL(destroyed(QObject*)),this,SLOT(receiverDestroyedSlot(QObject*)));
+    if(receiverHash.isEmpty())
+    {
+        frameTimer->stop();
+    }
+}
+/*
+ *@brief:   设置帧间隔
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   frameIntervalMs:帧间隔 ms
+ */
+void BaseAnimationDriver::setFrameInterval(uint frameIntervalMs)
+{
+    this->frameIntervalMs = qMax(frameIntervalMs,1u);
+    frameTimer->setInterval(this->frameIntervalMs);
+}
+/*
+ *@brief:   获取当前时刻 与时间轮使用同一单调时钟，动画和长按定时的时间一致
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  qint64:时刻 ms
+ */
+qint64 BaseAnimationDriver::now()
+{
+    return BaseTimerWheel::instance()->now();
+}
+/*
+ *@brief:   帧定时器的响应槽 依次调用各接收者的帧槽函数
+ * 注:接收者在帧槽函数中可以停止/启动任意动画(包括自身)，这里遍历的是本帧开始时的接收者快照。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseAnimationDriver::frameTimerSlot()
+{
+    qint64 frameMs = now();
+    //定时器延迟(负载较高)时跳过中间帧，动画按时刻计算进度，直接推进到当前时刻
+    if(lastFrameMs >= 0 && frameMs-lastFrameMs >= 2*qint64(frameIntervalMs))
+    {
+        skippedFrames += quint64((frameMs-lastFrameMs)/frameIntervalMs-1);
+    }
+    lastFrameMs = frameMs;
+    frames++;
+    QList<QObject *> receivers = receiverHash.keys();
+    for(int i=0;i<receivers.size();i++)
+    {
+        QHash<QObject *,QMetaMethod>::const_iterator it = receiverHash.constFind(receivers.at(i));
+        if(it == receiverHash.constEnd())
+        {
+            continue;
+        }
+        QMetaMethod method = it.value();//槽函数中可能修改receiverHash，先复制出来
+        method.invoke(receivers.at(i),Qt::DirectConnection,Q_ARG(qint64,frameMs));
+    }
+}
+/*
+ *@brief:   接收者析构时移除其动画
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   receiver:接收者
+ */
+void BaseAnimationDriver::receiverDestroyedSlot(QObject *receiver)
+{
+    receiverHash.remove(receiver);
+    if(receiverHash.isEmpty())
+    {
+        frameTimer->stop();
+    }
+}
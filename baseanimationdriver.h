@@ -0,0 +1,63 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  共享的逐帧动画驱动
+ *
+ * 1.按钮的按下波纹、选中渐变、长按进度环等反馈动画如果各自使用QPropertyAnimation或定时器，按钮较多时
+ * 会产生大量动画对象和定时器。这里提供一个进程内共享的动画驱动，整个进程只有一个帧定时器(默认16ms)，
+ * 每帧依次调用所有活动接收者注册的帧槽函数，由接收者推进自己的动画并只重绘变化的区域。
+ * 2.帧槽函数的参数为当前帧时刻(ms，与BaseTimerWheel::now()同一时钟)，动画应根据时刻而不是帧数计算进度，
+ * 这样负载较高、定时器延迟时只是跳过中间帧，动画的时长不受影响。跳过的帧数可以通过skippedFrameCount()查看。
+ * 3.没有活动动画时帧定时器自动停止，不占用事件循环。
+ * 注:该类只能在GUI(主)线程使用。
+ */
+#ifndef BASEANIMATIONDRIVER_H
+#define BASEANIMATIONDRIVER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QHash>
+#include <QMetaMethod>
+
+class BaseAnimationDriver : public QObject
+{
+    Q_OBJECT
+public:
+    static BaseAnimationDriver *instance();
+
+    //启动/停止接收者的逐帧动画 member为帧槽函数名(不带参数及SLOT宏)，槽函数参数为(qint64 frameMs)
+    void start(QObject *receiver,const char *member);
+    void stop(QObject *receiver);
+    bool isActive(QObject *receiver){return receiverHash.contains(receiver);}
+
+    //设置/获取帧间隔 ms
+    void setFrameInterval(uint frameIntervalMs);
+    uint getFrameInterval(){return frameIntervalMs;}
+    int activeCount(){return receiverHash.size();}//活动的动画接收者数
+    int timerCount(){return frameTimer->isActive()?1:0;}//实际运行的QTimer数(0或1)
+    quint64 frameCount(){return frames;}//已处理的帧数
+    quint64 skippedFrameCount(){return skippedFrames;}//因定时器延迟跳过的帧数
+    qint64 now();//当前时刻 ms
+
+private:
+    explicit BaseAnimationDriver(QObject *parent=0);
+
+    QTimer *frameTimer;//驱动所有动画的唯一帧定时器
+    uint frameIntervalMs;//帧间隔 ms
+    qint64 lastFrameMs;//上一帧的时刻 ms 小于0表示还没有处理过帧
+    quint64 frames;//已处理的帧数
+    quint64 skippedFrames;//跳过的帧数
+    QHash<QObject *,QMetaMethod> receiverHash;//接收者->帧槽函数
+
+private slots:
+    void frameTimerSlot();
+    void receiverDestroyedSlot(QObject *receiver);
+};
+
+#endif // BASEANIMATIONDRIVER_H
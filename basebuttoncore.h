@@ -0,0 +1,536 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  与界面无关的按钮状态机核心(仅头文件)
+ *
+ * 1.按下、防抖、长按和自动切换选中的判断逻辑原先分散在BaseToolButton的鼠标事件处理和定时器槽函数中，
+ * 无法在其他前端复用，也无法脱离QApplication单独测试。这里将其抽取为模板类BaseButtonCore，只依赖QtCore
+ * 的基本类型，不使用事件、定时器和信号:前端调用press()/release()/advance()输入动作和时刻，根据返回的
+ * 事件掩码(BaseButtonEvent)发出自己的信号。
+ * 2.模板参数:
+ *   Clock:时钟，提供静态函数nowMs()返回单调时刻(ms)，用于时间戳为0时的防抖判断。默认为BaseSteadyClock，
+ *   BaseToolButton使用时间轮的时钟(BaseTimerWheelClock)，回放时也可使用虚拟时钟。
+ *   Features:编译期功能特性(BaseButtonFeature的组合)。未包含的特性对应的基类为空类，通过空基类优化不占用
+ *   内存，相关判断均为编译期常量，会被编译器完全消除。包含的特性仍可通过配置的setXxxEnabled()在运行时开关。
+ *   Config:配置(自动选中、防抖及长按参数)，需要提供与BaseToolButtonPolicy相同的getXxx()常函数。核心按值
+ *   保存一份配置，使用时直接读取，自身只保存按下、长按计时等运行状态。默认为每个核心独立的
+ *   BaseButtonCoreConfig；BaseToolButton使用显式共享的行为策略(BaseToolButtonPolicy)作为配置，核心中只有
+ *   一个指针，相同配置的按钮共享同一份数据。没有任何功能特性时不保存配置。
+ * 3.长按不持有定时器:press()后由前端按longPressIntervalMs()定时调用longPressTick()(如注册到时间轮)，
+ * 或者在帧回调等时机调用advance(当前时刻)补齐期间到期的长按响应。
+ * 4.BaseDebounceCore为防抖引擎(前沿/后沿/节流)，BaseDebounce直接继承自它。
+ * 注:该类不是线程安全的，每个实例只应在一个线程中使用。
+ */
+#ifndef BASEBUTTONCORE_H
+#define BASEBUTTONCORE_H
+
+#include <QtGlobal>
+#include <chrono>
+
+//编译期功能特性
+struct BaseButtonFeature
+{
+    enum
+    {
+        NoFeature = 0,
+        AntiShake = 0x1,//防抖
+        LongPress = 0x2,//长按
+        AutoCheck = 0x4,//点击时自动切换选中状态
+        AllFeatures = AntiShake|LongPress|AutoCheck
+    };
+};
+
+//状态机事件 press()/release()/longPressTick()/advance()返回其组合
+struct BaseButtonEvent
+{
+    enum
+    {
+        NoEvent = 0,
+        Pressed = 0x1,//按下
+        Released = 0x2,//释放
+        Clicked = 0x4,//在按钮内释放
+        Toggled = 0x8,//选中状态改变
+        LongPressed = 0x10,//长按响应，长按时间见longPressElapsedMs()
+        Rejected = 0x20//按下被防抖丢弃
+    };
+};
+
+//基于std::chrono::steady_clock的单调时钟
+struct BaseSteadyClock
+{
+    static qint64 nowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+//防抖状态(按下/响应记录及丢弃计数) 防抖策略和窗口时间由使用者在判断时提供
+class BaseDebounceState
+{
+public:
+    //防抖策略
+    enum Policy
+    {
+        LeadingEdge = 0,//前沿
+        TrailingEdge,//后沿
+        Throttle//节流 按固定时间片限速，时间片边界两侧的两次按下都会响应(不保证最小间隔)
+    };
+
+    BaseDebounceState()
+    {
+        reset();
+    }
+
+    /*
+     *@brief:   判断一次按下是否被响应(未被防抖丢弃)
+     * 注:如果时间戳比上一次的记录更早(比如时间戳来源发生变化)，视为新的时间基准直接响应。
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   timestampMs:按下事件的单调时间戳 ms
+     *@param:   policy:防抖策略
+     *@param:   windowMs:防抖窗口时间 ms
+     *@return:  bool:true=响应  false=丢弃
+     */
+    bool acceptPress(qint64 timestampMs,Policy policy,uint windowMs)
+    {
+        bool accepted = true;
+        switch(policy)
+        {
+        case LeadingEdge:
+            if(hasAccepted && timestampMs >= lastAcceptedMs)
+            {
+                accepted = (timestampMs-lastAcceptedMs >= windowMs);
+            }
+            break;
+        case TrailingEdge:
+            if(hasPressed && timestampMs >= lastPressMs)
+            {
+                accepted = (timestampMs-lastPressMs >= windowMs);
+            }
+            break;
+        case Throttle:
+            /*以窗口时间为周期划分固定的时间片(与时间戳0对齐)，同一时间片内只响应一次。节流只限制响应速率，
+             * 不保证两次响应之间的最小间隔:时间片边界两侧的两次按下(如199ms和201ms)都会响应，所以不能
+             * 滤除开关抖动，需要滤除抖动时应使用前沿或后沿策略*/
+            if(hasAccepted && windowMs > 0 && timestampMs >= lastAcceptedMs)
+            {
+                accepted = (timestampMs/windowMs != lastAcceptedMs/windowMs);
+            }
+            break;
+        }
+
+        hasPressed = true;
+        lastPressMs = timestampMs;
+        if(accepted)
+        {
+            hasAccepted = true;
+            lastAcceptedMs = timestampMs;
+        }
+        else
+        {
+            rejectedCount++;
+        }
+        return accepted;
+    }
+    quint32 getRejectedCount(){return this->rejectedCount;}//被丢弃的按下次数
+    //清除按下记录和丢弃计数
+    void reset()
+    {
+        hasPressed = false;
+        hasAccepted = false;
+        lastPressMs = 0;
+        lastAcceptedMs = 0;
+        rejectedCount = 0;
+    }
+
+private:
+    bool hasPressed;//是否已有按下记录
+    bool hasAccepted;//是否已有响应记录
+    qint64 lastPressMs;//上一次按下的时间戳 ms
+    qint64 lastAcceptedMs;//上一次响应按下的时间戳 ms
+    quint32 rejectedCount;//被丢弃的按下次数
+};
+
+//防抖引擎(无定时器) 自身保存防抖策略和窗口时间
+class BaseDebounceCore : public BaseDebounceState
+{
+public:
+    BaseDebounceCore(Policy policy = LeadingEdge,uint windowMs = 200)
+        :policy(policy),windowMs(windowMs)
+    {
+    }
+
+    //设置/获取防抖策略和窗口时间
+    void setPolicy(Policy policy){this->policy = policy;}
+    Policy getPolicy(){return this->policy;}
+    void setWindowMs(uint windowMs){this->windowMs = windowMs;}
+    uint getWindowMs(){return this->windowMs;}
+
+    //按自身的防抖策略和窗口时间判断一次按下是否被响应
+    bool acceptPress(qint64 timestampMs){return BaseDebounceState::acceptPress(timestampMs,policy,windowMs);}
+
+private:
+    Policy policy;//防抖策略
+    uint windowMs;//防抖窗口时间 ms
+};
+
+//默认配置 每个核心独立保存一份，接口与BaseToolButtonPolicy一致
+class BaseButtonCoreConfig
+{
+public:
+    BaseButtonCoreConfig()
+        :autoChecked(true),antiShakeEnabled(true),antiShakePolicy(BaseDebounceState::LeadingEdge),
+          antiShakeWindowMs(200),longPressEnabled(true),longPressRespondMs(3000),longPressMaxMs(3000),
+          longPressMinRespondMs(3000),longPressRampFactor(1.0),longPressMaxRate(0)
+    {
+    }
+
+    //设置/获取是否点击时自动切换选中状态
+    void setAutoChecked(bool autoChecked){this->autoChecked = autoChecked;}
+    bool getAutoChecked() const{return autoChecked;}
+    //设置/获取防抖属性
+    void setAntiShakeEnabled(bool antiShakeEnabled){this->antiShakeEnabled = antiShakeEnabled;}
+    bool getAntiShakeEnabled() const{return antiShakeEnabled;}
+    void setAntiShakePolicy(BaseDebounceState::Policy antiShakePolicy){this->antiShakePolicy = antiShakePolicy;}
+    BaseDebounceState::Policy getAntiShakePolicy() const{return antiShakePolicy;}
+    void setAntiShakeWindowMs(uint antiShakeWindowMs){this->antiShakeWindowMs = antiShakeWindowMs;}
+    uint getAntiShakeWindowMs() const{return antiShakeWindowMs;}
+    //设置/获取长按属性
+    void setLongPressEnabled(bool longPressEnabled){this->longPressEnabled = longPressEnabled;}
+    bool getLongPressEnabled() const{return longPressEnabled;}
+    void setLongPressRespondMs(uint longPressRespondMs){this->longPressRespondMs = longPressRespondMs;}
+    uint getLongPressRespondMs() const{return longPressRespondMs;}
+    void setLongPressMaxMs(uint longPressMaxMs){this->longPressMaxMs = longPressMaxMs;}
+    uint getLongPressMaxMs() const{return longPressMaxMs;}
+    void setLongPressRamp(uint longPressMinRespondMs,qreal longPressRampFactor)
+    {
+        this->longPressMinRespondMs = longPressMinRespondMs;
+        this->longPressRampFactor = longPressRampFactor;
+    }
+    uint getLongPressMinRespondMs() const{return longPressMinRespondMs;}
+    qreal getLongPressRampFactor() const{return longPressRampFactor;}
+    void setLongPressMaxRate(uint longPressMaxRate){this->longPressMaxRate = longPressMaxRate;}
+    uint getLongPressMaxRate() const{return longPressMaxRate;}
+
+private:
+    bool autoChecked;//点击时是否自动切换选中状态
+    bool antiShakeEnabled;//防抖使能状态
+    BaseDebounceState::Policy antiShakePolicy;//防抖策略
+    uint antiShakeWindowMs;//防抖窗口时间 ms
+    bool longPressEnabled;//长按使能状态
+    uint longPressRespondMs;//长按响应时间 ms
+    uint longPressMaxMs;//长按最大时间 ms
+    uint longPressMinRespondMs;//加速后的最小定时间隔 ms
+    qreal longPressRampFactor;//加速系数 不小于1时不加速
+    uint longPressMaxRate;//每秒最多响应次数 0表示不限频
+};
+
+//配置 没有任何功能特性时为空类(不读取配置)
+template <typename Config,bool Enabled>
+class BaseButtonCoreConfigHolder
+{
+public:
+    const Config &config() const
+    {
+        static const Config emptyConfig;
+        return emptyConfig;
+    }
+};
+template <typename Config>
+class BaseButtonCoreConfigHolder<Config,true>
+{
+public:
+    Config &config(){return coreConfig;}
+    const Config &config() const{return coreConfig;}
+
+private:
+    Config coreConfig;//配置
+};
+
+//防抖特性 未启用时为空类
+template <bool Enabled>
+class BaseButtonCoreAntiShake
+{
+protected:
+    template <typename Config>
+    bool acceptPress(const Config &,qint64){return true;}
+};
+template <>
+class BaseButtonCoreAntiShake<true>
+{
+public:
+    BaseButtonCoreAntiShake():sharedDebounce(NULL){}
+
+    //按钮自己的防抖状态(按配置的策略和窗口时间判断)
+    BaseDebounceState &debounce(){return ownDebounce;}
+    //设置共享的防抖引擎(如按钮组共享防抖窗口) 为NULL时使用自己的防抖状态
+    void setSharedDebounce(BaseDebounceCore *sharedDebounce){this->sharedDebounce = sharedDebounce;}
+
+protected:
+    template <typename Config>
+    bool acceptPress(const Config &config,qint64 timestampMs)
+    {
+        if(!config.getAntiShakeEnabled())
+        {
+            return true;
+        }
+        return (sharedDebounce != NULL)?sharedDebounce->acceptPress(timestampMs):
+                                        ownDebounce.acceptPress(timestampMs,config.getAntiShakePolicy(),
+                                                                config.getAntiShakeWindowMs());
+    }
+
+private:
+    BaseDebounceState ownDebounce;//自己的防抖状态
+    BaseDebounceCore *sharedDebounce;//共享的防抖引擎
+};
+
+//长按特性 未启用时为空类
+template <bool Enabled>
+class BaseButtonCoreLongPress
+{
+public:
+    bool isLongPressActive() const{return false;}
+    void cancelLongPress(){}
+
+protected:
+    template <typename Config>
+    uint tickLongPress(const Config &,qint64){return BaseButtonEvent::NoEvent;}
+    template <typename Config>
+    void startLongPress(const Config &,qint64){}
+    qint64 longPressDeadline() const{return 0;}
+};
+template <>
+class BaseButtonCoreLongPress<true>
+{
+public:
+    BaseButtonCoreLongPress()
+        :longPressActive(false),longPressElapsed(0),longPressCurrentMs(3000),
+          longPressLastEmitMs(-1),longPressDeadlineMs(0)
+    {
+    }
+
+    bool isLongPressActive() const{return longPressActive;}
+    uint longPressElapsedMs() const{return longPressElapsed;}//已长按的时间(各次定时间隔之和) ms
+    uint longPressIntervalMs() const{return longPressCurrentMs;}//当前的定时间隔 ms
+    /*
+     *@brief:   停止长按(如按钮被拖出区域) 之后不再有长按响应，直到下一次按下
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     */
+    void cancelLongPress()
+    {
+        longPressActive = false;
+    }
+
+protected:
+    /*
+     *@brief:   长按定时到期 按配置的加速曲线计算下一次定时间隔，并按限频判断本次是否响应
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   config:配置
+     *@param:   nowMs:当前时刻 ms 用于限频
+     *@return:  uint:LongPressed=本次响应长按 NoEvent=本次被限频跳过或长按未激活
+     */
+    template <typename Config>
+    uint tickLongPress(const Config &config,qint64 nowMs)
+    {
+        if(!longPressActive)
+        {
+            return BaseButtonEvent::NoEvent;
+        }
+        uint longPressMaxRate = config.getLongPressMaxRate();
+        longPressElapsed += longPressCurrentMs;
+        bool lastRespond = (longPressElapsed >= config.getLongPressMaxMs());
+        if(lastRespond)
+        {
+            longPressActive = false;
+        }
+        else if(config.getLongPressRampFactor() < 1 && longPressCurrentMs > config.getLongPressMinRespondMs())
+        {
+            //按加速曲线缩短定时间隔(限频时不必短于信号的最小间隔)
+            uint minRespondMs = qMax(config.getLongPressMinRespondMs(),1u);
+            if(longPressMaxRate > 0)
+            {
+                minRespondMs = qMax(minRespondMs,1000/longPressMaxRate);
+            }
+            longPressCurrentMs = qMax(uint(longPressCurrentMs*config.getLongPressRampFactor()),minRespondMs);
+        }
+        longPressDeadlineMs += longPressCurrentMs;
+        //限频:距上次响应不足最小间隔时跳过(最后一次响应总是发出)
+        if(longPressMaxRate > 0 && !lastRespond && longPressLastEmitMs >= 0 &&
+                (nowMs-longPressLastEmitMs)*longPressMaxRate < 1000)
+        {
+            return BaseButtonEvent::NoEvent;
+        }
+        longPressLastEmitMs = nowMs;
+        return BaseButtonEvent::LongPressed;
+    }
+    template <typename Config>
+    void startLongPress(const Config &config,qint64 nowMs)
+    {
+        longPressActive = config.getLongPressEnabled();
+        longPressElapsed = 0;
+        longPressCurrentMs = qMax(config.getLongPressRespondMs(),1u);
+        longPressLastEmitMs = -1;
+        longPressDeadlineMs = nowMs+longPressCurrentMs;
+    }
+    qint64 longPressDeadline() const{return longPressDeadlineMs;}
+
+private:
+    bool longPressActive;//长按是否进行中
+    uint longPressElapsed;//已长按的时间 ms
+    uint longPressCurrentMs;//当前的定时间隔 ms
+    qint64 longPressLastEmitMs;//上次响应的时刻 ms
+    qint64 longPressDeadlineMs;//下一次到期的时刻 ms
+};
+
+//自动切换选中特性 未启用时为空类
+template <bool Enabled>
+class BaseButtonCoreAutoCheck
+{
+protected:
+    template <typename Config>
+    uint nextCheckState(const Config &){return BaseButtonEvent::NoEvent;}
+};
+template <>
+class BaseButtonCoreAutoCheck<true>
+{
+public:
+    BaseButtonCoreAutoCheck():checkable(false),checked(false){}
+
+    void setCheckable(bool checkable){this->checkable = checkable;if(!checkable)checked = false;}
+    bool isCheckable(){return checkable;}
+    //手动设置选中状态 返回Toggled表示状态改变
+    uint setChecked(bool checked)
+    {
+        if(!checkable || this->checked == checked)
+        {
+            return BaseButtonEvent::NoEvent;
+        }
+        this->checked = checked;
+        return BaseButtonEvent::Toggled;
+    }
+    bool isChecked(){return checked;}
+
+protected:
+    template <typename Config>
+    uint nextCheckState(const Config &config)
+    {
+        return config.getAutoChecked()?setChecked(!checked):uint(BaseButtonEvent::NoEvent);
+    }
+
+private:
+    bool checkable;//是否可以选中
+    bool checked;//选中状态
+};
+
+template <typename Clock = BaseSteadyClock,uint Features = BaseButtonFeature::AllFeatures,
+          typename Config = BaseButtonCoreConfig>
+class BaseButtonCore : public BaseButtonCoreConfigHolder<Config,Features != BaseButtonFeature::NoFeature>,
+        public BaseButtonCoreAntiShake<(Features & BaseButtonFeature::AntiShake) != 0>,
+        public BaseButtonCoreLongPress<(Features & BaseButtonFeature::LongPress) != 0>,
+        public BaseButtonCoreAutoCheck<(Features & BaseButtonFeature::AutoCheck) != 0>
+{
+    typedef BaseButtonCoreConfigHolder<Config,Features != BaseButtonFeature::NoFeature> ConfigBase;
+    typedef BaseButtonCoreAntiShake<(Features & BaseButtonFeature::AntiShake) != 0> AntiShakeBase;
+    typedef BaseButtonCoreLongPress<(Features & BaseButtonFeature::LongPress) != 0> LongPressBase;
+    typedef BaseButtonCoreAutoCheck<(Features & BaseButtonFeature::AutoCheck) != 0> AutoCheckBase;
+
+public:
+    BaseButtonCore():down(false){}
+
+    static qint64 now(){return Clock::nowMs();}
+    bool isDown() const{return down;}
+
+    /*
+     *@brief:   按下 未被防抖丢弃时进入按下状态并开始长按计时
+     * 注:已处于按下状态时(如释放事件丢失)视为重新按下，长按重新计时。
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   timestampMs:按下的时间戳 ms 为0时使用Clock的当前时刻
+     *@return:  uint:Pressed 或 Rejected(被防抖丢弃)
+     */
+    uint press(qint64 timestampMs = 0)
+    {
+        if((Features & (BaseButtonFeature::AntiShake|BaseButtonFeature::LongPress)) && timestampMs == 0)
+        {
+            timestampMs = Clock::nowMs();
+        }
+        if(!AntiShakeBase::acceptPress(ConfigBase::config(),timestampMs))
+        {
+            return BaseButtonEvent::Rejected;
+        }
+        down = true;
+        LongPressBase::startLongPress(ConfigBase::config(),timestampMs);
+        return BaseButtonEvent::Pressed;
+    }
+    /*
+     *@brief:   释放 停止长按，在按钮内释放时为一次点击并自动切换选中状态
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   inside:是否在按钮内释放
+     *@return:  uint:Released|Clicked|Toggled的组合 未按下时为NoEvent
+     */
+    uint release(bool inside = true)
+    {
+        if(!down)
+        {
+            return BaseButtonEvent::NoEvent;
+        }
+        down = false;
+        LongPressBase::cancelLongPress();
+        uint events = BaseButtonEvent::Released;
+        if(inside)
+        {
+            events |= BaseButtonEvent::Clicked|AutoCheckBase::nextCheckState(ConfigBase::config());
+        }
+        return events;
+    }
+    /*
+     *@brief:   长按定时到期 按加速曲线计算下一次定时间隔，并按限频判断本次是否响应
+     * 注:前端在定时间隔变化(longPressIntervalMs())或长按结束(isLongPressActive())时需要调整自己的定时。
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   nowMs:当前时刻 ms 用于限频
+     *@return:  uint:LongPressed=本次响应长按 NoEvent=本次被限频跳过或长按未激活
+     */
+    uint longPressTick(qint64 nowMs)
+    {
+        return LongPressBase::tickLongPress(ConfigBase::config(),nowMs);
+    }
+    /*
+     *@brief:   推进到指定时刻 依次处理期间到期的长按定时(没有自己定时器的前端使用)
+     * 注:一次推进多个长按间隔时只返回一个LongPressed，长按时间为最后一次响应的时间，所以应至少每个
+     * 定时间隔调用一次。
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   nowMs:当前时刻 ms
+     *@return:  uint:LongPressed或NoEvent
+     */
+    uint advance(qint64 nowMs)
+    {
+        uint events = BaseButtonEvent::NoEvent;
+        while(LongPressBase::isLongPressActive() && LongPressBase::longPressDeadline() <= nowMs)
+        {
+            events |= LongPressBase::tickLongPress(ConfigBase::config(),LongPressBase::longPressDeadline());
+        }
+        return events;
+    }
+    //下一次需要调用advance()的时刻 ms 没有进行中的长按时返回-1
+    qint64 nextDeadline() const
+    {
+        return LongPressBase::isLongPressActive()?LongPressBase::longPressDeadline():-1;
+    }
+
+private:
+    bool down;//是否处于按下状态
+};
+
+#endif // BASEBUTTONCORE_H
@@ -0,0 +1,321 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  BaseToolButton专用的按钮组
+ */
+#include "basebuttongroup.h"
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseButtonGroup::BaseButtonGroup(QObject *parent)
+    :QObject(parent)
+{
+    btnCount = 0;
+    exclusive = true;
+    checkedId = -1;
+}
+/*
+ *@brief:   析构函数 解除成员按钮与组的关联
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseButtonGroup::~BaseButtonGroup()
+{
+    for(int i=0;i<btnVector.size();i++)
+    {
+        if(btnVector.at(i) != NULL)
+        {
+            btnVector.at(i)->baseBtnGroupId = -1;
+        }
+    }
+}
+/*
+ *@brief:   添加按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮 已在其他BaseButtonGroup中时先从原组移除
+ *@param:   id:按钮id 小于0时使用当前最大id+1；id作为数组下标，应尽量连续
+ *@return:  int:按钮的id 失败(按钮为空或id已被占用)时返回-1
+ */
+int BaseButtonGroup::addButton(BaseToolButton *btn, int id)
+{
+    if(btn == NULL)
+    {
+        return -1;
+    }
+    if(btn->baseBtnGroup.data() == this)
+    {
+        return btn->baseBtnGroupId;
+    }
+    if(id < 0)
+    {
+        id = btnVector.size();
+    }
+    if(id < btnVector.size() && btnVector.at(id) != NULL)
+    {
+        return -1;
+    }
+    if(!btn->baseBtnGroup.isNull())
+    {
+        btn->baseBtnGroup->removeButton(btn);
+    }
+    if(id >= btnVector.size())
+    {
+        btnVector.resize(id+1);
+    }
+    btnVector[id] = btn;
+    btnCount++;
+    btn->baseBtnGroup = this;
+    btn->baseBtnGroupId = id;
+
+    //直接以lambda关联，信号中携带按钮指针、id和名称，不需要再查找和转换
+    connect(btn,&QAbstractButton::clicked,this,[this,btn,id](){
+        emit btnClicked(btn,id,btn->getBtnName());
+    });
+    connect(btn,&QAbstractButton::toggled,this,[this,id](bool checked){
+        memberToggled(id,checked);
+    });
+    connect(btn,&QObject::destroyed,this,[this,id](){
+        memberDestroyed(id);
+    });
+    //互斥组中加入已选中的按钮时，取消原来选中的按钮
+    if(btn->isChecked())
+    {
+        memberToggled(id,true);
+    }
+    return id;
+}
+/*
+ *@brief:   移除按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ */
+void BaseButtonGroup::removeButton(BaseToolButton *btn)
+{
+    if(btn == NULL || btn->baseBtnGroup.data() != this)
+    {
+        return;
+    }
+    int id = btn->baseBtnGroupId;
+    disconnect(btn,0,this,0);
+    btn->baseBtnGroup = NULL;
+    btn->baseBtnGroupId = -1;
+    memberDestroyed(id);
+}
+/*
+ *@brief:   根据id获取按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   id:按钮id
+ *@return:  BaseToolButton*:按钮 不存在时返回NULL
+ */
+BaseToolButton *BaseButtonGroup::button(int id)
+{
+    if(id < 0 || id >= btnVector.size())
+    {
+        return NULL;
+    }
+    return btnVector.at(id);
+}
+/*
+ *@brief:   获取按钮的id
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ *@return:  int:按钮id 不在该组中时返回-1
+ */
+int BaseButtonGroup::id(BaseToolButton *btn)
+{
+    if(btn == NULL || btn->baseBtnGroup.data() != this)
+    {
+        return -1;
+    }
+    return btn->baseBtnGroupId;
+}
+/*
+ *@brief:   设置是否互斥 设置为互斥时只保留id最小的选中按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   exclusive:是否互斥
+ */
+void BaseButtonGroup::setExclusive(bool exclusive)
+{
+    if(this->exclusive == exclusive)
+    {
+        return;
+    }
+    this->exclusive = exclusive;
+    checkedId = -1;
+    if(!exclusive)
+    {
+        return;
+    }
+    QList<int> uncheckIdList;
+    for(int i=0;i<btnVector.size();i++)
+    {
+        if(btnVector.at(i) != NULL && btnVector.at(i)->isChecked())
+        {
+            if(checkedId < 0)
+            {
+                checkedId = i;
+            }
+            else
+            {
+                uncheckIdList.append(i);
+            }
+        }
+    }
+    if(!uncheckIdList.isEmpty())
+    {
+        setBtnsChecked(uncheckIdList,false);
+    }
+}
+/*
+ *@brief:   选中指定id的按钮(互斥组中会取消原来选中的按钮) 与点击一样发出btnToggled信号
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   id:按钮id 互斥组中小于0时取消当前选中
+ */
+void BaseButtonGroup::setCheckedId(int id)
+{
+    BaseToolButton *btn = button(id);
+    if(btn != NULL)
+    {
+        btn->setChecked(true);
+    }
+    else if(exclusive && checkedId >= 0)
+    {
+        BaseToolButton *checkedBtn = button(checkedId);
+        checkedId = -1;
+        checkedBtn->setChecked(false);
+    }
+}
+/*
+ *@brief:   批量设置按钮的选中状态 设置过程中屏蔽按钮信号，完成后只发出一次btnsCheckChanged()
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   idList:按钮id列表 互斥组中选中时只有列表中最后一个有效的按钮被选中
+ *@param:   checked:选中状态
+ */
+void BaseButtonGroup::setBtnsChecked(const QList<int> &idList, bool checked)
+{
+    for(int i=0;i<idList.size();i++)
+    {
+        int id = idList.at(i);
+        BaseToolButton *btn = button(id);
+        if(btn == NULL || !btn->isCheckable() || btn->isChecked() == checked)
+        {
+            continue;
+        }
+        if(exclusive && checked && checkedId >= 0 && checkedId != id)
+        {
+            BaseToolButton *checkedBtn = button(checkedId);
+            bool blocked = checkedBtn->blockSignals(true);
+            checkedBtn->setChecked(false);
+            checkedBtn->blockSignals(blocked);
+        }
+        bool blocked = btn->blockSignals(true);
+        btn->setChecked(checked);
+        btn->blockSignals(blocked);
+        if(exclusive)
+        {
+            if(checked)
+            {
+                checkedId = id;
+            }
+            else if(checkedId == id)
+            {
+                checkedId = -1;
+            }
+        }
+    }
+    emit btnsCheckChanged();
+}
+/*
+ *@brief:   批量设置所有按钮的选中状态(互斥组中只能取消全部选中)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   checked:选中状态
+ */
+void BaseButtonGroup::setAllChecked(bool checked)
+{
+    if(exclusive && checked)
+    {
+        return;
+    }
+    QList<int> idList;
+    idList.reserve(btnVector.size());
+    for(int i=0;i<btnVector.size();i++)
+    {
+        idList.append(i);
+    }
+    setBtnsChecked(idList,checked);
+}
+/*
+ *@brief:   成员按钮选中状态改变 互斥组中只取消原来选中的按钮，其他按钮不受影响(不重绘)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   id:按钮id
+ *@param:   checked:选中状态
+ */
+void BaseButtonGroup::memberToggled(int id, bool checked)
+{
+    BaseToolButton *btn = button(id);
+    if(btn == NULL)
+    {
+        return;
+    }
+    if(exclusive)
+    {
+        if(checked && checkedId != id)
+        {
+            int oldCheckedId = checkedId;
+            checkedId = id;
+            BaseToolButton *oldCheckedBtn = button(oldCheckedId);
+            if(oldCheckedBtn != NULL)
+            {
+                oldCheckedBtn->setChecked(false);
+            }
+        }
+        else if(!checked && checkedId == id)
+        {
+            checkedId = -1;
+        }
+    }
+    emit btnToggled(btn,id,checked);
+}
+/*
+ *@brief:   成员按钮析构(或被移除)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   id:按钮id
+ */
+void BaseButtonGroup::memberDestroyed(int id)
+{
+    if(id < 0 || id >= btnVector.size() || btnVector.at(id) == NULL)
+    {
+        return;
+    }
+    btnVector[id] = NULL;
+    btnCount--;
+    if(checkedId == id)
+    {
+        checkedId = -1;
+    }
+    //去掉末尾的空位
+    while(!btnVector.isEmpty() && btnVector.last() == NULL)
+    {
+        btnVector.removeLast();
+    }
+}
@@ -0,0 +1,68 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  BaseToolButton专用的按钮组
+ *
+ * 1.使用QButtonGroup时只能通过buttonClicked(int)拿到id，再经button(id)和qobject_cast转换回
+ * BaseToolButton才能获取btnName。该类以id为下标将成员按钮保存在连续数组中，id查找按钮、按钮查找id
+ * 都是O(1)，并发出直接携带按钮指针、id和btnName的信号。
+ * 2.互斥(单选)切换时只修改旧的和新的选中按钮，所以只有这两个按钮重绘；互斥组中已选中的按钮再次点击
+ * 时保持选中。
+ * 3.setBtnsChecked()批量设置选中状态时屏蔽各按钮的信号，完成后只发出一次btnsCheckChanged()，
+ * 适用于包含几百个按钮的组。
+ * 注:按钮不要同时加入QButtonGroup，否则两个组的互斥逻辑会相互干扰。
+ */
+#ifndef BASEBUTTONGROUP_H
+#define BASEBUTTONGROUP_H
+
+#include <QObject>
+#include <QVector>
+#include <QList>
+#include "basetoolbutton.h"
+
+class BaseButtonGroup : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BaseButtonGroup(QObject *parent=0);
+    ~BaseButtonGroup();
+
+    //添加/移除按钮
+    int addButton(BaseToolButton *btn,int id = -1);
+    void removeButton(BaseToolButton *btn);
+    BaseToolButton *button(int id);
+    int id(BaseToolButton *btn);
+    int getBtnCount(){return btnCount;}
+
+    //设置/获取是否互斥(单选) 默认互斥
+    void setExclusive(bool exclusive);
+    bool getExclusive(){return exclusive;}
+    //选中状态
+    int getCheckedId(){return checkedId;}
+    BaseToolButton *getCheckedBtn(){return button(checkedId);}
+    void setCheckedId(int id);
+    void setBtnsChecked(const QList<int> &idList,bool checked);
+    void setAllChecked(bool checked);
+
+private:
+    void memberToggled(int id,bool checked);
+    void memberDestroyed(int id);
+
+    QVector<BaseToolButton *> btnVector;//id->按钮 移除的位置为NULL
+    int btnCount;//成员按钮数
+    bool exclusive;//是否互斥
+    int checkedId;//互斥组中当前选中按钮的id 没有时为-1
+
+signals:
+    void btnClicked(BaseToolButton *btn,int id,const QString &btnName);
+    void btnToggled(BaseToolButton *btn,int id,bool checked);
+    void btnsCheckChanged();//批量设置选中状态完成
+};
+
+#endif // BASEBUTTONGROUP_H
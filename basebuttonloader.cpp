@@ -0,0 +1,509 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  声明式按钮布局加载器(按页面延迟创建按钮)
+ */
+#include "basebuttonloader.h"
+#include "baseiconloader.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QElapsedTimer>
+#include <QGridLayout>
+#include <QEvent>
+#include <QDebug>
+#if QT_VERSION >= QT_VERSION_CHECK(5,12,0)
+#include <QCborValue>
+#endif
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseButtonLoader::BaseButtonLoader(QObject *parent)
+    :QObject(parent)
+{
+}
+/*
+ *@brief:   从文件加载按钮描述
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   fileName:描述文件(JSON文本或CBOR二进制)
+ *@return:  bool:加载成功返回true
+ */
+bool BaseButtonLoader::loadDescription(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        qWarning()<<"BaseButtonLoader: can't open"<<fileName;
+        return false;
+    }
+    return loadDescription(file.readAll());
+}
+/*
+ *@brief:   加载按钮描述，已加载的同名页面会被替换
+ * 同名页面已创建时删除(deleteLater)其按钮和按钮组，页面仍绑定原来的容器:容器正在显示时立即按新描述
+ * 重新创建，否则在其下一次显示时创建。可以在页面按钮的信号响应中调用。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   data:描述数据 以'{'开头(忽略空白)时按JSON解析，否则按CBOR解析(需要Qt5.12及以上)
+ *@return:  bool:加载成功返回true
+ */
+bool BaseButtonLoader::loadDescription(const QByteArray &data)
+{
+    QJsonObject rootObject;
+    if(data.trimmed().startsWith('{'))
+    {
+        QJsonParseError parseError;
+        QJsonDocument jsonDoc = QJsonDocument::fromJson(data,&parseError);
+        if(parseError.error != QJsonParseError::NoError)
+        {
+            qWarning()<<"BaseButtonLoader: json parse error:"<<parseError.errorString();
+            return false;
+        }
+        rootObject = jsonDoc.object();
+    }
+    else
+    {
+#if QT_VERSION >= QT_VERSION_CHECK(5,12,0)
+        QCborParserError parseError;
+        QCborValue cborValue = QCborValue::fromCbor(data,&parseError);
+        if(parseError.error != QCborError::NoError)
+        {
+            qWarning()<<"BaseButtonLoader: cbor parse error:"<<parseError.errorString();
+            return false;
+        }
+        rootObject = cborValue.toJsonValue().toObject();
+#else
+        qWarning()<<"BaseButtonLoader: cbor description requires Qt 5.12 or later";
+        return false;
+#endif
+    }
+
+    QJsonArray pageArray = rootObject.value("pages").toArray();
+    if(pageArray.isEmpty())
+    {
+        qWarning()<<"BaseButtonLoader: no pages in description";
+        return false;
+    }
+    QStringList rebindNameList;//需要按新描述重新创建的已绑定页面
+    for(int i=0;i<pageArray.size();i++)
+    {
+        QJsonObject pageObject = pageArray.at(i).toObject();
+        QString pageName = pageObject.value("name").toString();
+        if(pageName.isEmpty())
+        {
+            continue;
+        }
+        if(!pageHash.contains(pageName))
+        {
+            pageNameList.append(pageName);
+        }
+        PageItem &page = pageHash[pageName];
+        clearPage(page);
+        page.btnArray = pageObject.value("buttons").toArray();
+        page.columns = pageObject.value("columns").toInt(0);
+        page.built = false;
+        page.buildNs = -1;
+        if(!page.container.isNull() && !rebindNameList.contains(pageName))
+        {
+            rebindNameList.append(pageName);
+        }
+    }
+    for(int i=0;i<rebindNameList.size();i++)
+    {
+        QWidget *container = pageHash.value(rebindNameList.at(i)).container.data();
+        if(container->isVisible())
+        {
+            buildPage(rebindNameList.at(i));
+        }
+        else
+        {
+            container->installEventFilter(this);
+        }
+    }
+    return true;
+}
+/*
+ *@brief:   绑定页面与容器部件，容器已显示时立即创建按钮，否则在其第一次显示时创建
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   pageName:页面名称
+ *@param:   container:容器部件 按钮以其为父对象并加入其布局(没有布局时创建QGridLayout)
+ *@return:  bool:页面不存在或已创建时返回false
+ */
+bool BaseButtonLoader::bindPage(const QString &pageName, QWidget *container)
+{
+    QHash<QString,PageItem>::iterator it = pageHash.find(pageName);
+    if(it == pageHash.end() || it->built || container == NULL)
+    {
+        return false;
+    }
+    if(!it->container.isNull())
+    {
+        it->container->removeEventFilter(this);
+    }
+    it->container = container;
+    if(container->isVisible())
+    {
+        buildPage(pageName);
+    }
+    else
+    {
+        container->installEventFilter(this);
+    }
+    return true;
+}
+/*
+ *@brief:   立即创建页面的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   pageName:页面名称
+ */
+void BaseButtonLoader::buildPage(const QString &pageName)
+{
+    QHash<QString,PageItem>::iterator it = pageHash.find(pageName);
+    if(it == pageHash.end() || it->built || it->container.isNull())
+    {
+        return;
+    }
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    PageItem &page = it.value();
+    QWidget *container = page.container.data();
+    container->removeEventFilter(this);
+    page.built = true;//先置位，避免btnCreated信号的响应中重入
+    //容器没有布局时按列数创建网格布局
+    QLayout *layout = container->layout();
+    if(layout == NULL)
+    {
+        layout = new QGridLayout(container);
+    }
+    QGridLayout *gridLayout = qobject_cast<QGridLayout *>(layout);
+    int columns = (page.columns > 0)?page.columns:page.btnArray.size();
+    bool showNow = container->isVisible();
+
+    for(int i=0;i<page.btnArray.size();i++)
+    {
+        QJsonObject btnObject = page.btnArray.at(i).toObject();
+        BaseToolButton *btn = createButton(btnObject);
+        if(gridLayout != NULL)
+        {
+            gridLayout->addWidget(btn,i/columns,i%columns);
+        }
+        else
+        {
+            layout->addWidget(btn);
+        }
+        //按组号加入单选按钮组
+        if(btnObject.contains("group"))
+        {
+            int group = btnObject.value("group").toInt();
+            QPointer<QButtonGroup> &btnGroup = page.groupMap[group];
+            if(btnGroup.isNull())
+            {
+                btnGroup = new QButtonGroup(container);
+            }
+            btnGroup->addButton(btn,btnObject.value("groupId").toInt(-1));
+        }
+        //容器正在显示时(Show事件中)其子部件已经完成显示，新建的按钮需要主动显示
+        if(showNow)
+        {
+            btn->show();
+        }
+        page.btnList.append(btn);
+        emit btnCreated(btn,pageName);
+    }
+    page.buildNs = elapsedTimer.nsecsElapsed();
+    emit pageBuilt(pageName,page.buildNs,page.btnList.size());
+}
+/*
+ *@brief:   在后台线程预加载所有尚未创建页面的单状态图标，之后创建按钮时直接命中图标缓存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseButtonLoader::prewarmIcons()
+{
+    for(int i=0;i<pageNameList.size();i++)
+    {
+        const PageItem &page = pageHash[pageNameList.at(i)];
+        if(page.built)
+        {
+            continue;
+        }
+        for(int j=0;j<page.btnArray.size();j++)
+        {
+            QJsonObject btnObject = page.btnArray.at(j).toObject();
+            QString iconUrl = btnObject.value("icon").toString();
+            if(!iconUrl.isEmpty())
+            {
+                BaseIconLoader::instance()->prewarmIcon(
+                            iconUrl,jsonSize(btnObject.value("iconSize"),QSize(32,32)),
+                            btnObject.value("scaledUp").toBool(false));
+            }
+        }
+    }
+}
+/*
+ *@brief:   获取页面的创建耗时
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   pageName:页面名称
+ *@return:  qint64:创建耗时 ns，页面不存在或未创建时返回-1
+ */
+qint64 BaseButtonLoader::getPageBuildTime(const QString &pageName)
+{
+    QHash<QString,PageItem>::const_iterator it = pageHash.constFind(pageName);
+    if(it == pageHash.constEnd())
+    {
+        return -1;
+    }
+    return it->buildNs;
+}
+/*
+ *@brief:   获取页面已创建(且未被销毁)的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   pageName:页面名称
+ *@return:  QList<BaseToolButton *>:按钮列表(按描述中的顺序)
+ */
+QList<BaseToolButton *> BaseButtonLoader::getPageButtons(const QString &pageName)
+{
+    QList<BaseToolButton *> btnList;
+    QHash<QString,PageItem>::const_iterator it = pageHash.constFind(pageName);
+    if(it == pageHash.constEnd())
+    {
+        return btnList;
+    }
+    for(int i=0;i<it->btnList.size();i++)
+    {
+        if(!it->btnList.at(i).isNull())
+        {
+            btnList.append(it->btnList.at(i).data());
+        }
+    }
+    return btnList;
+}
+/*
+ *@brief:   获取页面中指定组号的按钮组
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   pageName:页面名称
+ *@param:   group:组号
+ *@return:  QButtonGroup*:按钮组，页面未创建或不存在该组时返回NULL
+ */
+QButtonGroup *BaseButtonLoader::getPageGroup(const QString &pageName, int group)
+{
+    QHash<QString,PageItem>::const_iterator it = pageHash.constFind(pageName);
+    if(it == pageHash.constEnd())
+    {
+        return NULL;
+    }
+    return it->groupMap.value(group).data();
+}
+/*
+ *@brief:   按名称查找已创建的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btnName:按钮名称
+ *@return:  BaseToolButton*:按钮，未创建时返回NULL
+ */
+BaseToolButton *BaseButtonLoader::findButton(const QString &btnName)
+{
+    for(int i=0;i<pageNameList.size();i++)
+    {
+        const PageItem &page = pageHash[pageNameList.at(i)];
+        for(int j=0;j<page.btnList.size();j++)
+        {
+            BaseToolButton *btn = page.btnList.at(j).data();
+            if(btn != NULL && btn->getBtnName() == btnName)
+            {
+                return btn;
+            }
+        }
+    }
+    return NULL;
+}
+/*
+ *@brief:   事件过滤 容器第一次显示时创建其页面的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   watched:被监视的对象
+ *@param:   event:事件
+ *@return:  bool:始终返回false，不拦截事件
+ */
+bool BaseButtonLoader::eventFilter(QObject *watched, QEvent *event)
+{
+    if(event->type() == QEvent::Show)
+    {
+        for(int i=0;i<pageNameList.size();i++)
+        {
+            const PageItem &page = pageHash[pageNameList.at(i)];
+            if(!page.built && page.container.data() == watched)
+            {
+                buildPage(pageNameList.at(i));
+                break;
+            }
+        }
+    }
+    return QObject::eventFilter(watched,event);
+}
+/*
+ *@brief:   删除页面已创建的按钮和按钮组(页面描述及绑定的容器保留)
+ * 重新加载可能是由页面中按钮的clicked/btnCreated等信号触发的，此时信号的发送者还在调用栈中，所以按钮和
+ * 按钮组通过deleteLater()延迟删除；按钮先从容器的布局中移除并隐藏，新建的按钮立即占据其位置。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   page:页面
+ */
+void BaseButtonLoader::clearPage(PageItem &page)
+{
+    QLayout *layout = page.container.isNull()?NULL:page.container->layout();
+    for(int i=0;i<page.btnList.size();i++)
+    {
+        BaseToolButton *btn = page.btnList.at(i).data();
+        if(btn == NULL)
+        {
+            continue;
+        }
+        if(layout != NULL)
+        {
+            layout->removeWidget(btn);
+        }
+        btn->hide();
+        btn->deleteLater();
+    }
+    page.btnList.clear();
+    QMap<int,QPointer<QButtonGroup> >::const_iterator it = page.groupMap.constBegin();
+    for(;it != page.groupMap.constEnd();++it)
+    {
+        if(!it.value().isNull())
+        {
+            it.value()->deleteLater();
+        }
+    }
+    page.groupMap.clear();
+}
+/*
+ *@brief:   按描述创建一个按钮(不含布局和按钮组)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btnObject:按钮描述
+ *@return:  BaseToolButton*:新建的按钮
+ */
+BaseToolButton *BaseButtonLoader::createButton(const QJsonObject &btnObject)
+{
+    BaseToolButton *btn = new BaseToolButton();
+    btn->setBtnName(btnObject.value("name").toString());
+    if(btnObject.contains("text"))
+    {
+        btn->setText(btnObject.value("text").toString());
+    }
+    if(btnObject.contains("toolButtonStyle"))
+    {
+        btn->setToolButtonStyle(toolButtonStyle(btnObject.value("toolButtonStyle").toString()));
+    }
+    //图标
+    QSize iconSize = jsonSize(btnObject.value("iconSize"),QSize(32,32));
+    if(btnObject.contains("icons"))
+    {
+        QJsonArray iconArray = btnObject.value("icons").toArray();
+        btn->setBtnIcons(iconArray.at(0).toString(),iconArray.at(1).toString(),
+                         iconArray.at(2).toString(),iconSize);
+    }
+    else if(btnObject.contains("icon"))
+    {
+        QString iconUrl = btnObject.value("icon").toString();
+        bool scaledUp = btnObject.value("scaledUp").toBool(false);
+        if(btnObject.value("asyncIcon").toBool(false))
+        {
+            btn->setBtnIconAsync(iconUrl,iconSize,scaledUp);
+        }
+        else
+        {
+            btn->setBtnIcon(iconUrl,iconSize,scaledUp);
+        }
+    }
+    //外观
+    if(btnObject.value("theme").toBool(false))
+    {
+        btn->setBtnThemeEnabled(true);
+    }
+    if(btnObject.contains("style"))
+    {
+        btn->setStyleSheet(btnObject.value("style").toString());
+    }
+    //选中/防抖/长按
+    if(btnObject.value("checkable").toBool(false))
+    {
+        btn->setCheckable(true);
+    }
+    if(btnObject.contains("autoChecked"))
+    {
+        btn->setBtnAutoChecked(btnObject.value("autoChecked").toBool());
+    }
+    if(btnObject.contains("antiShake"))
+    {
+        btn->setBtnAntiShakeProperty(true,btnObject.value("antiShake").toInt(200));
+    }
+    if(btnObject.contains("longPress"))
+    {
+        QJsonArray longPressArray = btnObject.value("longPress").toArray();
+        btn->setBtnLongPressProperty(true,longPressArray.at(0).toInt(3000),
+                                     longPressArray.at(1).toInt(3000));
+    }
+    return btn;
+}
+/*
+ *@brief:   工具按钮样式名称转换为枚举值
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   styleName:样式名称(IconOnly/TextOnly/TextBesideIcon/TextUnderIcon/FollowStyle)
+ *@return:  Qt::ToolButtonStyle:样式枚举，无法识别时返回Qt::ToolButtonIconOnly
+ */
+Qt::ToolButtonStyle BaseButtonLoader::toolButtonStyle(const QString &styleName)
+{
+    if(styleName == "TextOnly")
+    {
+        return Qt::ToolButtonTextOnly;
+    }
+    else if(styleName == "TextBesideIcon")
+    {
+        return Qt::ToolButtonTextBesideIcon;
+    }
+    else if(styleName == "TextUnderIcon")
+    {
+        return Qt::ToolButtonTextUnderIcon;
+    }
+    else if(styleName == "FollowStyle")
+    {
+        return Qt::ToolButtonFollowStyle;
+    }
+    return Qt::ToolButtonIconOnly;
+}
+/*
+ *@brief:   解析[宽,高]形式的尺寸
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   value:json值
+ *@param:   defaultSize:解析失败时的默认尺寸
+ *@return:  QSize:尺寸
+ */
+QSize BaseButtonLoader::jsonSize(const QJsonValue &value, QSize defaultSize)
+{
+    QJsonArray sizeArray = value.toArray();
+    if(sizeArray.size() != 2)
+    {
+        return defaultSize;
+    }
+    return QSize(sizeArray.at(0).toInt(),sizeArray.at(1).toInt());
+}
@@ -0,0 +1,87 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  声明式按钮布局加载器(按页面延迟创建按钮)
+ *
+ * 1.界面中所有按钮在启动时通过大量setter调用一次性创建，启动时间随所有页面的按钮总数增长。该类读取
+ * 紧凑的按钮描述(JSON文本或CBOR二进制)，只有当页面(容器部件)第一次显示时才创建该页面的BaseToolButton。
+ * 2.描述格式:
+ * {"pages":[{"name":"main","columns":4,"buttons":[
+ *     {"name":"key1","text":"1","icon":"./images/1.ico","iconSize":[40,40],"scaledUp":false,
+ *      "icons":["normal.png","checked.png","disabled.png"],"asyncIcon":false,
+ *      "toolButtonStyle":"TextUnderIcon","style":"QToolButton{...}","theme":true,
+ *      "checkable":true,"autoChecked":true,"antiShake":200,"longPress":[500,3000],
+ *      "group":1,"groupId":3}]}]}
+ * 除name外所有字段都是可选的；同一页面中group相同的按钮加入同一个QButtonGroup(单选)，groupId为组内id。
+ * 3.可以在后台线程预加载尚未创建页面的图标(BaseIconLoader)，并统计每个页面的创建耗时。
+ */
+#ifndef BASEBUTTONLOADER_H
+#define BASEBUTTONLOADER_H
+
+#include <QObject>
+#include <QWidget>
+#include <QPointer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QButtonGroup>
+#include <QHash>
+#include <QMap>
+#include "basetoolbutton.h"
+
+class BaseButtonLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BaseButtonLoader(QObject *parent=0);
+
+    //加载按钮描述(JSON或CBOR) 重新加载已创建的页面时删除其按钮和按钮组，按新描述重新创建
+    bool loadDescription(const QString &fileName);
+    bool loadDescription(const QByteArray &data);
+    QStringList getPageNames(){return pageNameList;}
+
+    //绑定页面与容器部件，容器第一次显示时创建按钮
+    bool bindPage(const QString &pageName,QWidget *container);
+    void buildPage(const QString &pageName);//立即创建页面的按钮
+    void prewarmIcons();//后台预加载尚未创建页面的图标
+
+    qint64 getPageBuildTime(const QString &pageName);//页面创建耗时 ns  未创建时返回-1
+    QList<BaseToolButton *> getPageButtons(const QString &pageName);
+    QButtonGroup *getPageGroup(const QString &pageName,int group);
+    BaseToolButton *findButton(const QString &btnName);
+
+protected:
+    virtual bool eventFilter(QObject *watched,QEvent *event);
+
+private:
+    //页面描述及状态
+    struct PageItem
+    {
+        QJsonArray btnArray;//按钮描述
+        int columns;//网格列数 <=0表示单行
+        QPointer<QWidget> container;//容器部件
+        bool built;//是否已创建
+        qint64 buildNs;//创建耗时 ns
+        QList<QPointer<BaseToolButton> > btnList;//已创建的按钮
+        QMap<int,QPointer<QButtonGroup> > groupMap;//组号->按钮组
+    };
+
+    void clearPage(PageItem &page);
+    BaseToolButton *createButton(const QJsonObject &btnObject);
+    static Qt::ToolButtonStyle toolButtonStyle(const QString &styleName);
+    static QSize jsonSize(const QJsonValue &value,QSize defaultSize);
+
+    QStringList pageNameList;//页面名称(按描述中的顺序)
+    QHash<QString,PageItem> pageHash;//页面名称->页面
+
+signals:
+    void btnCreated(BaseToolButton *btn,const QString &pageName);//按钮创建完成(可在此关联信号)
+    void pageBuilt(const QString &pageName,qint64 buildNs,int btnCount);//页面创建完成
+};
+
+#endif // BASEBUTTONLOADER_H
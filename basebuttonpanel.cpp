@@ -0,0 +1,656 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  轻量按钮面板(一个部件承载大量虚拟按钮)
+ */
+#include "basebuttonpanel.h"
+#include "baseiconcache.h"
+#include <QPainter>
+#include <QPaintEvent>
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseButtonPanel::BaseButtonPanel(QWidget *parent)
+    :QWidget(parent)
+{
+    rowCount = 0;
+    columnCount = 0;
+    spacing = 4;
+    pressedIndex = -1;
+    pressedDown = false;
+    this->setSizePolicy(QSizePolicy::Preferred,QSizePolicy::Preferred);
+}
+/*
+ *@brief:   设置面板网格，单元格按行优先排列，已有单元格的属性会被清除
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   rowCount:行数
+ *@param:   columnCount:列数
+ */
+void BaseButtonPanel::setPanelGrid(int rowCount, int columnCount)
+{
+    releaseCell();
+    this->rowCount = qMax(rowCount,0);
+    this->columnCount = qMax(columnCount,0);
+
+    PanelCell cell;
+    cell.iconIndex = -1;
+    cell.groupId = -1;
+    cell.flags = CellEnabled|CellAutoChecked;
+    cell.longPressRespondMs = 3000;
+    cell.longPressMaxMs = 3000;
+    cells.clear();
+    cells.fill(cell,this->rowCount*this->columnCount);
+    groupCheckedHash.clear();
+    this->updateGeometry();
+    this->update();
+}
+/*
+ *@brief:   设置单元格间距
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   spacing:间距
+ */
+void BaseButtonPanel::setPanelSpacing(int spacing)
+{
+    this->spacing = qMax(spacing,0);
+    this->update();
+}
+/*
+ *@brief:   设置单元格主题，所有单元格共享
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   theme:主题
+ */
+void BaseButtonPanel::setPanelTheme(const BaseToolButtonTheme &theme)
+{
+    panelTheme = theme;
+    this->update();
+}
+/*
+ *@brief:   设置/获取单元格文本
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   text:文本
+ */
+void BaseButtonPanel::setCellText(int index, const QString &text)
+{
+    if(!isValidCell(index))
+    {
+        return;
+    }
+    cells[index].text = text;
+    updateCell(index);
+}
+
+QString BaseButtonPanel::getCellText(int index)
+{
+    return isValidCell(index)?cells.at(index).text:QString();
+}
+/*
+ *@brief:   设置单元格图标，相同路径和尺寸的图标在所有单元格之间共享
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   iconUrl:图标路径 为空时清除图标
+ *@param:   iconSize:图标尺寸
+ */
+void BaseButtonPanel::setCellIcon(int index, const QString &iconUrl, QSize iconSize)
+{
+    if(!isValidCell(index))
+    {
+        return;
+    }
+    if(iconUrl.isEmpty())
+    {
+        cells[index].iconIndex = -1;
+        updateCell(index);
+        return;
+    }
+    QString iconKey = iconUrl+QString("|%1x%2").arg(iconSize.width()).arg(iconSize.height());
+    int iconIndex = iconIndexHash.value(iconKey,-1);
+    if(iconIndex < 0)
+    {
+        iconIndex = iconTable.size();
+        iconTable.append(BaseIconCache::instance()->icon(iconUrl,iconSize,false));
+        iconSizeTable.append(iconSize);
+        iconIndexHash.insert(iconKey,iconIndex);
+    }
+    cells[index].iconIndex = iconIndex;
+    updateCell(index);
+}
+/*
+ *@brief:   设置/获取单元格名称(类似于BaseToolButton的btnName)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   btnName:名称
+ */
+void BaseButtonPanel::setCellName(int index, const QString &btnName)
+{
+    if(isValidCell(index))
+    {
+        cells[index].btnName = btnName;
+    }
+}
+
+QString BaseButtonPanel::getCellName(int index)
+{
+    return isValidCell(index)?cells.at(index).btnName:QString();
+}
+/*
+ *@brief:   设置单元格使能状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   enabled:使能状态
+ */
+void BaseButtonPanel::setCellEnabled(int index, bool enabled)
+{
+    if(!isValidCell(index))
+    {
+        return;
+    }
+    if(!enabled && index == pressedIndex)
+    {
+        releaseCell();
+    }
+    setCellFlag(index,CellEnabled,enabled);
+}
+/*
+ *@brief:   设置单元格是否可选中
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   checkable:是否可选中
+ */
+void BaseButtonPanel::setCellCheckable(int index, bool checkable)
+{
+    if(!isValidCell(index))
+    {
+        return;
+    }
+    if(!checkable)
+    {
+        setCellChecked(index,false);
+    }
+    setCellFlag(index,CellCheckable,checkable);
+}
+/*
+ *@brief:   设置单元格选中状态，互斥分组中选中一个单元格会取消该组之前选中的单元格
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   checked:选中状态
+ */
+void BaseButtonPanel::setCellChecked(int index, bool checked)
+{
+    if(!isValidCell(index) || !testCellFlag(index,CellCheckable) ||
+            testCellFlag(index,CellChecked) == checked)
+    {
+        return;
+    }
+    int groupId = cells.at(index).groupId;
+    if(groupId >= 0)
+    {
+        if(checked)
+        {
+            int oldIndex = groupCheckedHash.value(groupId,-1);
+            if(isValidCell(oldIndex) && oldIndex != index)
+            {
+                setCellFlag(oldIndex,CellChecked,false);
+                emit cellToggled(oldIndex,false);
+            }
+            groupCheckedHash.insert(groupId,index);
+        }
+        else if(groupCheckedHash.value(groupId,-1) == index)
+        {
+            groupCheckedHash.remove(groupId);
+        }
+    }
+    setCellFlag(index,CellChecked,checked);
+    emit cellToggled(index,checked);
+}
+
+bool BaseButtonPanel::isCellChecked(int index)
+{
+    return isValidCell(index) && testCellFlag(index,CellChecked);
+}
+/*
+ *@brief:   设置单元格是否可以自动(通过点击)切换选中状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   autoChecked:是否自动切换
+ */
+void BaseButtonPanel::setCellAutoChecked(int index, bool autoChecked)
+{
+    if(isValidCell(index))
+    {
+        cells[index].flags = autoChecked?(cells.at(index).flags|CellAutoChecked):
+                                         (cells.at(index).flags&~CellAutoChecked);
+    }
+}
+/*
+ *@brief:   设置单元格防抖属性
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   antiShakeEnabled:防抖使能状态
+ *@param:   antiShakeMs:防抖时间 ms
+ */
+void BaseButtonPanel::setCellAntiShakeProperty(int index, bool antiShakeEnabled, uint antiShakeMs)
+{
+    if(!isValidCell(index))
+    {
+        return;
+    }
+    cells[index].flags = antiShakeEnabled?(cells.at(index).flags|CellAntiShake):
+                                          (cells.at(index).flags&~CellAntiShake);
+    cells[index].antiShake.setWindowMs(antiShakeMs);
+}
+/*
+ *@brief:   设置单元格长按属性
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   longPressEnabled:长按使能状态
+ *@param:   longPressRespondMs:长按响应时间 ms
+ *@param:   longPressMaxMs:长按最大时间 ms
+ */
+void BaseButtonPanel::setCellLongPressProperty(int index, bool longPressEnabled,
+                                               uint longPressRespondMs, uint longPressMaxMs)
+{
+    if(!isValidCell(index))
+    {
+        return;
+    }
+    cells[index].flags = longPressEnabled?(cells.at(index).flags|CellLongPress):
+                                          (cells.at(index).flags&~CellLongPress);
+    cells[index].longPressRespondMs = longPressRespondMs;
+    cells[index].longPressMaxMs = longPressMaxMs;
+    if(!longPressEnabled && index == pressedIndex)
+    {
+        pressCore.cancelLongPress();
+        BaseTimerWheel::instance()->stop(this);
+    }
+}
+/*
+ *@brief:   设置单元格的互斥分组，同一分组内最多只有一个单元格处于选中状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   groupId:分组id  <0表示不分组
+ */
+void BaseButtonPanel::setCellGroup(int index, int groupId)
+{
+    if(!isValidCell(index))
+    {
+        return;
+    }
+    int oldGroupId = cells.at(index).groupId;
+    if(oldGroupId >= 0 && groupCheckedHash.value(oldGroupId,-1) == index)
+    {
+        groupCheckedHash.remove(oldGroupId);
+    }
+    cells[index].groupId = qMax(groupId,-1);
+    //加入分组时如果已选中，则按照选中新单元格的规则处理
+    if(groupId >= 0 && testCellFlag(index,CellChecked))
+    {
+        int checkedIndex = groupCheckedHash.value(groupId,-1);
+        if(isValidCell(checkedIndex) && checkedIndex != index)
+        {
+            setCellFlag(checkedIndex,CellChecked,false);
+            emit cellToggled(checkedIndex,false);
+        }
+        groupCheckedHash.insert(groupId,index);
+    }
+}
+/*
+ *@brief:   命中测试，根据网格直接计算位置所在的单元格
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   pos:面板坐标
+ *@return:  int:单元格索引 -1表示不在任何单元格内(包括间距区域)
+ */
+int BaseButtonPanel::cellAt(const QPoint &pos)
+{
+    if(cells.isEmpty())
+    {
+        return -1;
+    }
+    int cellWidth = (this->width()-spacing*(columnCount+1))/columnCount;
+    int cellHeight = (this->height()-spacing*(rowCount+1))/rowCount;
+    if(cellWidth <= 0 || cellHeight <= 0 || pos.x() < spacing || pos.y() < spacing)
+    {
+        return -1;
+    }
+    int column = (pos.x()-spacing)/(cellWidth+spacing);
+    int row = (pos.y()-spacing)/(cellHeight+spacing);
+    if(column >= columnCount || row >= rowCount)
+    {
+        return -1;
+    }
+    //落在间距区域内
+    if((pos.x()-spacing)%(cellWidth+spacing) >= cellWidth ||
+            (pos.y()-spacing)%(cellHeight+spacing) >= cellHeight)
+    {
+        return -1;
+    }
+    return row*columnCount+column;
+}
+/*
+ *@brief:   获取单元格区域
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@return:  QRect:单元格区域 无效索引返回空区域
+ */
+QRect BaseButtonPanel::cellRect(int index)
+{
+    if(!isValidCell(index))
+    {
+        return QRect();
+    }
+    int cellWidth = (this->width()-spacing*(columnCount+1))/columnCount;
+    int cellHeight = (this->height()-spacing*(rowCount+1))/rowCount;
+    int row = index/columnCount;
+    int column = index%columnCount;
+    return QRect(spacing+column*(cellWidth+spacing),spacing+row*(cellHeight+spacing),
+                 qMax(cellWidth,0),qMax(cellHeight,0));
+}
+/*
+ *@brief:   手动释放按下的单元格(不会触发点击)，避免因长按信号触发(半)模态窗口导致释放操作无法响应
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseButtonPanel::releaseCell()
+{
+    if(pressedIndex < 0)
+    {
+        return;
+    }
+    BaseTimerWheel::instance()->stop(this);
+    pressCore.release(false);
+    int index = pressedIndex;
+    bool wasDown = pressedDown;
+    pressedIndex = -1;
+    pressedDown = false;
+    updateCell(index);
+    if(wasDown)
+    {
+        emit cellReleased(index);
+    }
+}
+/*
+ *@brief:   面板的推荐尺寸
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  QSize:推荐尺寸
+ */
+QSize BaseButtonPanel::sizeHint() const
+{
+    return QSize(columnCount*(60+spacing)+spacing,rowCount*(40+spacing)+spacing);
+}
+/*
+ *@brief:   绘制事件处理  只绘制与重绘区域相交的单元格
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:绘制事件
+ */
+void BaseButtonPanel::paintEvent(QPaintEvent *e)
+{
+    if(cells.isEmpty())
+    {
+        return;
+    }
+    int cellWidth = (this->width()-spacing*(columnCount+1))/columnCount;
+    int cellHeight = (this->height()-spacing*(rowCount+1))/rowCount;
+    if(cellWidth <= 0 || cellHeight <= 0)
+    {
+        return;
+    }
+    //根据重绘区域直接计算需要绘制的行列范围
+    QRect dirtyRect = e->rect();
+    int firstColumn = qMax((dirtyRect.left()-spacing)/(cellWidth+spacing),0);
+    int lastColumn = qMin((dirtyRect.right()-spacing)/(cellWidth+spacing),columnCount-1);
+    int firstRow = qMax((dirtyRect.top()-spacing)/(cellHeight+spacing),0);
+    int lastRow = qMin((dirtyRect.bottom()-spacing)/(cellHeight+spacing),rowCount-1);
+
+    QPainter painter(this);
+    for(int row=firstRow;row<=lastRow;row++)
+    {
+        for(int column=firstColumn;column<=lastColumn;column++)
+        {
+            int index = row*columnCount+column;
+            if(e->region().intersects(cellRect(index)))
+            {
+                drawCell(&painter,index);
+            }
+        }
+    }
+}
+/*
+ *@brief:   鼠标按下事件处理  命中测试后进行防抖判断，并开启长按定时
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:鼠标事件
+ */
+void BaseButtonPanel::mousePressEvent(QMouseEvent *e)
+{
+    if(e->button() != Qt::LeftButton || pressedIndex >= 0)
+    {
+        e->ignore();
+        return;
+    }
+    int index = cellAt(e->pos());
+    if(!isValidCell(index) || !testCellFlag(index,CellEnabled))
+    {
+        e->ignore();
+        return;
+    }
+    /* 载入单元格的防抖及长按配置，状态机核心使用单元格自己的防抖引擎判断(单元格数组只在未按下时
+     * 重新分配，所以每次按下时重新设置)。个别平台或手动构造的事件时间戳为0，此时核心使用时间轮的时钟*/
+    pressCore.setSharedDebounce(&cells[index].antiShake);
+    const PanelCell &cell = cells.at(index);
+    pressCore.config().setAntiShakeEnabled((cell.flags & CellAntiShake) != 0);
+    pressCore.config().setLongPressEnabled((cell.flags & CellLongPress) != 0);
+    pressCore.config().setLongPressRespondMs(cell.longPressRespondMs);
+    pressCore.config().setLongPressMaxMs(cell.longPressMaxMs);
+    if(pressCore.press(e->timestamp()) & BaseButtonEvent::Rejected)
+    {
+        return;
+    }
+    pressedIndex = index;
+    pressedDown = true;
+    updateCell(index);
+    emit cellPressed(index);
+    if(pressCore.isLongPressActive())
+    {
+        BaseTimerWheel::instance()->start(this,"longPressTimerSlot",pressCore.longPressIntervalMs());
+    }
+}
+/*
+ *@brief:   鼠标移动事件处理  与QAbstractButton一致，移出按下的单元格时视为释放(停止长按)，移回时重新按下
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:鼠标事件
+ */
+void BaseButtonPanel::mouseMoveEvent(QMouseEvent *e)
+{
+    if(pressedIndex < 0)
+    {
+        e->ignore();
+        return;
+    }
+    bool inside = (cellAt(e->pos()) == pressedIndex);
+    if(inside == pressedDown)
+    {
+        return;
+    }
+    pressedDown = inside;
+    updateCell(pressedIndex);
+    if(inside)
+    {
+        emit cellPressed(pressedIndex);
+    }
+    else
+    {
+        pressCore.cancelLongPress();
+        BaseTimerWheel::instance()->stop(this);
+        emit cellReleased(pressedIndex);
+    }
+}
+/*
+ *@brief:   鼠标释放事件处理  在按下的单元格内释放时触发点击
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:鼠标事件
+ */
+void BaseButtonPanel::mouseReleaseEvent(QMouseEvent *e)
+{
+    if(e->button() != Qt::LeftButton || pressedIndex < 0)
+    {
+        e->ignore();
+        return;
+    }
+    int index = pressedIndex;
+    bool clicked = pressedDown && (cellAt(e->pos()) == index);
+    releaseCell();
+    if(clicked)
+    {
+        clickCell(index);
+    }
+}
+/*
+ *@brief:   设置/清除单元格标记位，状态改变时只更新该单元格区域
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ *@param:   flag:标记位
+ *@param:   on:是否置位
+ */
+void BaseButtonPanel::setCellFlag(int index, CellFlag flag, bool on)
+{
+    quint16 flags = on?(cells.at(index).flags|flag):(cells.at(index).flags&~flag);
+    if(flags != cells.at(index).flags)
+    {
+        cells[index].flags = flags;
+        updateCell(index);
+    }
+}
+/*
+ *@brief:   单元格点击处理  与BaseToolButton::nextCheckState()一致，可自动切换选中状态的单元格
+ *点击时切换选中状态，互斥分组中已选中的单元格保持选中
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:单元格索引
+ */
+void BaseButtonPanel::clickCell(int index)
+{
+    if(testCellFlag(index,CellCheckable) && testCellFlag(index,CellAutoChecked))
+    {
+        bool checked = testCellFlag(index,CellChecked);
+        if(!(checked && cells.at(index).groupId >= 0))
+        {
+            setCellChecked(index,!checked);
+        }
+    }
+    emit cellClicked(index);
+}
+/*
+ *@brief:   按主题绘制单元格 有图标和文本时图标在上文本在下
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   painter:画笔
+ *@param:   index:单元格索引
+ */
+void BaseButtonPanel::drawCell(QPainter *painter, int index)
+{
+    const PanelCell &cell = cells.at(index);
+    QRect rect = cellRect(index);
+    BaseToolButtonTheme::State state = BaseToolButtonTheme::Normal;
+    if(!(cell.flags & CellEnabled))
+    {
+        state = BaseToolButtonTheme::Disabled;
+    }
+    else if(index == pressedIndex && pressedDown)
+    {
+        state = BaseToolButtonTheme::Pressed;
+    }
+    else if(cell.flags & CellChecked)
+    {
+        state = BaseToolButtonTheme::Checked;
+    }
+
+    //背景
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing,true);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(panelTheme.getBackgroundColor(state));
+    painter->drawRoundedRect(QRectF(rect),panelTheme.getRadius(),panelTheme.getRadius());
+    painter->restore();
+
+    //内容
+    int padding = panelTheme.getPadding(state);
+    QRect contentRect = rect.adjusted(padding,padding,-padding,-padding);
+    QRect textRect = contentRect;
+    if(cell.iconIndex >= 0)
+    {
+        QSize iconSize = iconSizeTable.at(cell.iconIndex).boundedTo(contentRect.size());
+        QRect iconRect(0,0,iconSize.width(),iconSize.height());
+        if(cell.text.isEmpty())
+        {
+            iconRect.moveCenter(contentRect.center());
+        }
+        else
+        {
+            int textHeight = painter->fontMetrics().height();
+            iconRect.moveCenter(QPoint(contentRect.center().x(),
+                                       contentRect.top()+(contentRect.height()-textHeight)/2));
+            textRect.setTop(iconRect.bottom()+1);
+        }
+        QIcon::Mode iconMode = (state == BaseToolButtonTheme::Disabled)?QIcon::Disabled:QIcon::Normal;
+        QIcon::State iconState = (cell.flags & CellChecked)?QIcon::On:QIcon::Off;
+        iconTable.at(cell.iconIndex).paint(painter,iconRect,Qt::AlignCenter,iconMode,iconState);
+    }
+    if(!cell.text.isEmpty())
+    {
+        painter->setPen(panelTheme.getTextColor(state));
+        painter->drawText(textRect,Qt::AlignCenter,cell.text);
+    }
+}
+/*
+ *@brief:   长按定时的响应槽
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseButtonPanel::longPressTimerSlot()
+{
+    if(pressedIndex < 0)
+    {
+        BaseTimerWheel::instance()->stop(this);
+        return;
+    }
+    //由状态机核心推进长按，长按结束时停止时间轮上的定时
+    uint events = pressCore.longPressTick(BaseTimerWheel::instance()->now());
+    if(!pressCore.isLongPressActive())
+    {
+        BaseTimerWheel::instance()->stop(this);
+    }
+    if(events & BaseButtonEvent::LongPressed)
+    {
+        emit longPressSig(pressedIndex,pressCore.longPressElapsedMs());//上报长按信号
+    }
+}
@@ -0,0 +1,138 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  轻量按钮面板(一个部件承载大量虚拟按钮)
+ *
+ * 1.大型操作键盘或矩阵面板中有成百上千个按键时，每个按键都是一个完整的QWidget/QToolButton，内存、
+ * 布局以及事件分发的开销都比较大。该类只使用一个部件，将所有按键以轻量的单元格记录保存在连续数组中，
+ * 由面板自己完成命中测试和绘制，单元格按固定网格排列，命中测试为O(1)。
+ * 2.每个单元格仍然提供BaseToolButton的常用功能:可选中/自动切换选中状态、防抖(BaseDebounce)、长按
+ * (共享时间轮BaseTimerWheel，发送longPressSig信号)、按钮名称以及互斥分组。同一时刻只有一个单元格被按下，
+ * 防抖和长按判断由面板的一个状态机核心(BaseButtonCore)完成:按下时载入该单元格的配置并使用其防抖状态，
+ * 单元格只保存配置和防抖记录。
+ * 3.绘制时只处理与重绘区域相交的单元格，单元格状态变化时只更新该单元格所在的区域。单元格外观使用
+ * BaseToolButtonTheme主题绘制，图标通过BaseIconCache在所有单元格间共享。
+ */
+#ifndef BASEBUTTONPANEL_H
+#define BASEBUTTONPANEL_H
+
+#include <QWidget>
+#include <QVector>
+#include <QHash>
+#include <QIcon>
+#include <QMouseEvent>
+#include "basedebounce.h"
+#include "basebuttoncore.h"
+#include "basetimerwheel.h"
+#include "basetoolbuttontheme.h"
+
+class BaseButtonPanel : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit BaseButtonPanel(QWidget *parent=0);
+
+    //设置面板网格(行列数)及单元格间距
+    void setPanelGrid(int rowCount,int columnCount);
+    int getRowCount(){return rowCount;}
+    int getColumnCount(){return columnCount;}
+    int getCellCount(){return cells.size();}
+    void setPanelSpacing(int spacing);
+    void setPanelTheme(const BaseToolButtonTheme &theme);
+
+    //设置/获取单元格文本、图标、名称
+    void setCellText(int index,const QString &text);
+    QString getCellText(int index);
+    void setCellIcon(int index,const QString &iconUrl,QSize iconSize = QSize(32,32));
+    void setCellName(int index,const QString &btnName);
+    QString getCellName(int index);
+    //设置单元格使能、选中相关属性
+    void setCellEnabled(int index,bool enabled);
+    void setCellCheckable(int index,bool checkable);
+    void setCellChecked(int index,bool checked);
+    bool isCellChecked(int index);
+    void setCellAutoChecked(int index,bool autoChecked);
+    //设置单元格防抖、长按属性
+    void setCellAntiShakeProperty(int index,bool antiShakeEnabled,uint antiShakeMs = 200);
+    void setCellLongPressProperty(int index,bool longPressEnabled,uint longPressRespondMs = 3000,
+                                  uint longPressMaxMs = 3000);
+    //设置单元格互斥分组 groupId<0表示不分组
+    void setCellGroup(int index,int groupId);
+    int getCheckedCell(int groupId){return groupCheckedHash.value(groupId,-1);}
+
+    int cellAt(const QPoint &pos);//命中测试
+    QRect cellRect(int index);//单元格区域
+    void releaseCell();//手动释放按下的单元格
+
+    virtual QSize sizeHint() const;
+
+protected:
+    virtual void paintEvent(QPaintEvent *e);
+    virtual void mousePressEvent(QMouseEvent *e);
+    virtual void mouseMoveEvent(QMouseEvent *e);
+    virtual void mouseReleaseEvent(QMouseEvent *e);
+
+private:
+    //单元格标记位
+    enum CellFlag
+    {
+        CellEnabled = 0x01,
+        CellCheckable = 0x02,
+        CellChecked = 0x04,
+        CellAutoChecked = 0x08,
+        CellAntiShake = 0x10,
+        CellLongPress = 0x20
+    };
+    //单元格记录(保存在连续数组中，不是QObject)
+    struct PanelCell
+    {
+        QString text;//文本
+        QString btnName;//按钮名
+        qint32 iconIndex;//共享图标表中的索引 -1表示无图标
+        qint32 groupId;//互斥分组 -1表示不分组
+        quint16 flags;//CellFlag标记位
+        uint longPressRespondMs;//长按响应时间 ms
+        uint longPressMaxMs;//长按最大时间 ms
+        BaseDebounce antiShake;//防抖引擎
+    };
+
+    bool isValidCell(int index){return (index >= 0 && index < cells.size());}
+    void setCellFlag(int index,CellFlag flag,bool on);
+    bool testCellFlag(int index,CellFlag flag){return (cells.at(index).flags & flag);}
+    void updateCell(int index){this->update(cellRect(index));}
+    void clickCell(int index);
+    void drawCell(QPainter *painter,int index);
+
+    QVector<PanelCell> cells;//单元格数组(按行优先排列)
+    int rowCount;//行数
+    int columnCount;//列数
+    int spacing;//单元格间距
+    BaseToolButtonTheme panelTheme;//单元格主题
+    QVector<QIcon> iconTable;//共享图标表
+    QVector<QSize> iconSizeTable;//共享图标尺寸表
+    QHash<QString,int> iconIndexHash;//图标(路径+尺寸)->图标表索引
+    QHash<int,int> groupCheckedHash;//互斥分组->当前选中的单元格
+    /*按下状态*/
+    int pressedIndex;//按下的单元格 -1表示未按下
+    bool pressedDown;//鼠标是否仍在按下的单元格内
+    //按下单元格的状态机核心(防抖及长按) 按下时载入该单元格的配置
+    BaseButtonCore<BaseTimerWheelClock,BaseButtonFeature::AntiShake|BaseButtonFeature::LongPress> pressCore;
+
+signals:
+    void cellPressed(int index);
+    void cellReleased(int index);
+    void cellClicked(int index);
+    void cellToggled(int index,bool checked);
+    void longPressSig(int index,uint longPressMs);//长按信号,参数为单元格和长按的时间
+
+public slots:
+    void longPressTimerSlot();//长按定时的响应槽
+};
+
+#endif // BASEBUTTONPANEL_H
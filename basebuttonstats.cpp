@@ -0,0 +1,429 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮输入延迟及防抖丢弃统计
+ */
+#include "basebuttonstats.h"
+#include <QButtonGroup>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QtAlgorithms>
+
+bool BaseButtonStats::statsEnabled = false;
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseLatencyHistogram::BaseLatencyHistogram()
+    :maxValue(0)
+{
+    reset();
+}
+/*
+ *@brief:   记录一个样本(只做原子递增，可在任意线程调用)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   valueUs:样本值 us
+ */
+void BaseLatencyHistogram::record(quint64 valueUs)
+{
+    buckets[bucketIndex(valueUs)].fetchAndAddRelaxed(1);
+    quint32 value = quint32(qMin(valueUs,quint64(0xFFFFFFFFu)));
+    quint32 currentMax = maxValue.loadAcquire();
+    while(value > currentMax && !maxValue.testAndSetOrdered(currentMax,value,currentMax))
+    {
+    }
+}
+/*
+ *@brief:   获取直方图快照
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseHistogramSnapshot:样本数、分位数及最大值
+ */
+BaseHistogramSnapshot BaseLatencyHistogram::snapshot() const
+{
+    quint32 counts[BucketCount];
+    quint64 total = 0;
+    for(int i=0;i<BucketCount;i++)
+    {
+        counts[i] = buckets[i].loadAcquire();
+        total += counts[i];
+    }
+    BaseHistogramSnapshot snapshot;
+    snapshot.count = quint32(total);
+    snapshot.maxUs = maxValue.loadAcquire();
+    snapshot.p50Us = 0;
+    snapshot.p90Us = 0;
+    snapshot.p99Us = 0;
+    if(total == 0)
+    {
+        return snapshot;
+    }
+    //分位数取样本所在桶的上界(不超过最大值)
+    const qreal quantiles[3] = {0.5,0.9,0.99};
+    quint64 *results[3] = {&snapshot.p50Us,&snapshot.p90Us,&snapshot.p99Us};
+    for(int q=0;q<3;q++)
+    {
+        quint64 rank = quint64(quantiles[q]*total+0.999999);
+        quint64 cumulative = 0;
+        for(int i=0;i<BucketCount;i++)
+        {
+            cumulative += counts[i];
+            if(cumulative >= rank)
+            {
+                *results[q] = qMin(bucketUpperBound(i),snapshot.maxUs);
+                break;
+            }
+        }
+    }
+    return snapshot;
+}
+/*
+ *@brief:   清零
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseLatencyHistogram::reset()
+{
+    for(int i=0;i<BucketCount;i++)
+    {
+        buckets[i].storeRelease(0);
+    }
+    maxValue.storeRelease(0);
+}
+/*
+ *@brief:   计算样本所在的桶 0~3us各占一个桶，之后每个2的幂区间按次高两位均分为4个桶
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   valueUs:样本值 us
+ *@return:  int:桶索引
+ */
+int BaseLatencyHistogram::bucketIndex(quint64 valueUs)
+{
+    if(valueUs < 4)
+    {
+        return int(valueUs);
+    }
+    int msb = 63-qCountLeadingZeroBits(valueUs);
+    int index = (msb-1)*4+int((valueUs>>(msb-2))&3);
+    return qMin(index,int(BucketCount)-1);
+}
+/*
+ *@brief:   获取桶的上界
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:桶索引
+ *@return:  quint64:桶内的最大值 us
+ */
+quint64 BaseLatencyHistogram::bucketUpperBound(int index)
+{
+    if(index < 4)
+    {
+        return quint64(index);
+    }
+    int msb = index/4+1;
+    quint64 lower = quint64(4+index%4)<<(msb-2);
+    return lower+(quint64(1)<<(msb-2))-1;
+}
+
+/*
+ *@brief:   获取统计单例
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseButtonStats*:统计单例指针
+ */
+BaseButtonStats *BaseButtonStats::instance()
+{
+    static BaseButtonStats buttonStats;
+    return &buttonStats;
+}
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseButtonStats::BaseButtonStats()
+{
+    clockTimer.start();
+    clockOffsetUs = 0;
+    clockOffsetValid = false;
+}
+/*
+ *@brief:   析构函数 释放统计记录
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseButtonStats::~BaseButtonStats()
+{
+    qDeleteAll(btnRecordHash);
+    qDeleteAll(groupRecordHash);
+}
+/*
+ *@brief:   查找(不存在时创建)按钮及其按钮组的统计记录，由按钮缓存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   records:输出的记录
+ *@param:   btnName:按钮名称 为空时记为"(unnamed)"
+ *@param:   group:按钮组 为NULL时只查找按钮的记录
+ */
+void BaseButtonStats::resolveRecords(BaseButtonStatsRecords *records, const QString &btnName,
+                                     QButtonGroup *group)
+{
+    records->btnRecord = findRecord(btnRecordHash,btnName.isEmpty()?QString("(unnamed)"):btnName);
+    records->group = group;
+    records->groupRecord = NULL;
+    if(group == NULL)
+    {
+        return;
+    }
+    QString groupName = group->objectName();
+    if(groupName.isEmpty())
+    {
+        groupName = QString("group_0x%1").arg(quintptr(group),0,16);
+    }
+    records->groupRecord = findRecord(groupRecordHash,groupName);
+}
+/*
+ *@brief:   记录一次按下(已通过防抖)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   records:按钮缓存的统计记录
+ *@param:   eventMs:事件时间戳 ms 为0时不记录延迟
+ */
+void BaseButtonStats::recordPress(const BaseButtonStatsRecords &records, qint64 eventMs)
+{
+    BaseButtonStatsRecord *recordList[2] = {records.btnRecord,records.groupRecord};
+    qint64 latencyUs = eventLatencyUs(eventMs);
+    for(int i=0;i<2 && recordList[i] != NULL;i++)
+    {
+        recordList[i]->pressCount.fetchAndAddRelaxed(1);
+        if(latencyUs >= 0)
+        {
+            recordList[i]->pressLatency.record(latencyUs);
+        }
+    }
+}
+/*
+ *@brief:   记录一次被防抖丢弃的按下
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   records:按钮缓存的统计记录
+ */
+void BaseButtonStats::recordRejected(const BaseButtonStatsRecords &records)
+{
+    BaseButtonStatsRecord *recordList[2] = {records.btnRecord,records.groupRecord};
+    for(int i=0;i<2 && recordList[i] != NULL;i++)
+    {
+        recordList[i]->rejectedCount.fetchAndAddRelaxed(1);
+    }
+}
+/*
+ *@brief:   记录一次释放
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   records:按钮缓存的统计记录
+ *@param:   eventMs:事件时间戳 ms 为0时不记录延迟
+ *@param:   pressUs:按下时刻(nowUs()) 小于0时不记录按下时长
+ *@param:   clicked:本次释放是否会发出clicked()
+ */
+void BaseButtonStats::recordRelease(const BaseButtonStatsRecords &records, qint64 eventMs,
+                                    qint64 pressUs, bool clicked)
+{
+    BaseButtonStatsRecord *recordList[2] = {records.btnRecord,records.groupRecord};
+    qint64 latencyUs = clicked?eventLatencyUs(eventMs):-1;
+    qint64 durationUs = (pressUs >= 0)?nowUs()-pressUs:-1;
+    for(int i=0;i<2 && recordList[i] != NULL;i++)
+    {
+        if(clicked)
+        {
+            recordList[i]->clickCount.fetchAndAddRelaxed(1);
+        }
+        if(latencyUs >= 0)
+        {
+            recordList[i]->clickLatency.record(latencyUs);
+        }
+        if(durationUs >= 0)
+        {
+            recordList[i]->pressDuration.record(durationUs);
+        }
+    }
+}
+/*
+ *@brief:   记录一次长按信号
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   records:按钮缓存的统计记录
+ *@param:   latenessUs:长按信号相对预定时刻的延迟 us
+ */
+void BaseButtonStats::recordLongPress(const BaseButtonStatsRecords &records, qint64 latenessUs)
+{
+    BaseButtonStatsRecord *recordList[2] = {records.btnRecord,records.groupRecord};
+    for(int i=0;i<2 && recordList[i] != NULL;i++)
+    {
+        recordList[i]->longPressCount.fetchAndAddRelaxed(1);
+        recordList[i]->longPressLatency.record(qMax(latenessUs,qint64(0)));
+    }
+}
+/*
+ *@brief:   获取所有按钮及按钮组的统计快照
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  QList<BaseButtonStatsSnapshot>:快照列表(先按钮后按钮组)
+ */
+QList<BaseButtonStatsSnapshot> BaseButtonStats::snapshot()
+{
+    QList<BaseButtonStatsSnapshot> snapshotList;
+    QReadLocker locker(&recordLock);
+    QHash<QString,BaseButtonStatsRecord *> *recordHashes[2] = {&btnRecordHash,&groupRecordHash};
+    for(int h=0;h<2;h++)
+    {
+        QHash<QString,BaseButtonStatsRecord *>::const_iterator it;
+        for(it=recordHashes[h]->constBegin();it!=recordHashes[h]->constEnd();++it)
+        {
+            const BaseButtonStatsRecord *record = it.value();
+            BaseButtonStatsSnapshot snapshot;
+            snapshot.key = it.key();
+            snapshot.isGroup = (h == 1);
+            snapshot.pressCount = record->pressCount.loadAcquire();
+            snapshot.clickCount = record->clickCount.loadAcquire();
+            snapshot.rejectedCount = record->rejectedCount.loadAcquire();
+            snapshot.longPressCount = record->longPressCount.loadAcquire();
+            snapshot.pressLatency = record->pressLatency.snapshot();
+            snapshot.clickLatency = record->clickLatency.snapshot();
+            snapshot.longPressLatency = record->longPressLatency.snapshot();
+            snapshot.pressDuration = record->pressDuration.snapshot();
+            snapshotList.append(snapshot);
+        }
+    }
+    return snapshotList;
+}
+/*
+ *@brief:   将统计快照导出为JSON
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  QByteArray:JSON文本 {"buttons":[...],"groups":[...]}
+ */
+QByteArray BaseButtonStats::exportJson()
+{
+    QJsonArray btnArray;
+    QJsonArray groupArray;
+    QList<BaseButtonStatsSnapshot> snapshotList = snapshot();
+    for(int i=0;i<snapshotList.size();i++)
+    {
+        const BaseButtonStatsSnapshot &snapshot = snapshotList.at(i);
+        QJsonObject statsObject;
+        statsObject.insert("name",snapshot.key);
+        statsObject.insert("pressCount",qint64(snapshot.pressCount));
+        statsObject.insert("clickCount",qint64(snapshot.clickCount));
+        statsObject.insert("rejectedCount",qint64(snapshot.rejectedCount));
+        statsObject.insert("longPressCount",qint64(snapshot.longPressCount));
+        const char *histogramNames[4] = {"pressLatency","clickLatency","longPressLatency","pressDuration"};
+        const BaseHistogramSnapshot *histograms[4] = {&snapshot.pressLatency,&snapshot.clickLatency,
+                                                      &snapshot.longPressLatency,&snapshot.pressDuration};
+        for(int j=0;j<4;j++)
+        {
+            QJsonObject histogramObject;
+            histogramObject.insert("count",qint64(histograms[j]->count));
+            histogramObject.insert("p50Us",qint64(histograms[j]->p50Us));
+            histogramObject.insert("p90Us",qint64(histograms[j]->p90Us));
+            histogramObject.insert("p99Us",qint64(histograms[j]->p99Us));
+            histogramObject.insert("maxUs",qint64(histograms[j]->maxUs));
+            statsObject.insert(histogramNames[j],histogramObject);
+        }
+        if(snapshot.isGroup)
+        {
+            groupArray.append(statsObject);
+        }
+        else
+        {
+            btnArray.append(statsObject);
+        }
+    }
+    QJsonObject rootObject;
+    rootObject.insert("buttons",btnArray);
+    rootObject.insert("groups",groupArray);
+    return QJsonDocument(rootObject).toJson();
+}
+/*
+ *@brief:   清零所有统计(记录本身保留，正在记录的按钮不受影响)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseButtonStats::reset()
+{
+    QReadLocker locker(&recordLock);
+    QHash<QString,BaseButtonStatsRecord *> *recordHashes[2] = {&btnRecordHash,&groupRecordHash};
+    for(int h=0;h<2;h++)
+    {
+        QHash<QString,BaseButtonStatsRecord *>::const_iterator it;
+        for(it=recordHashes[h]->constBegin();it!=recordHashes[h]->constEnd();++it)
+        {
+            BaseButtonStatsRecord *record = it.value();
+            record->pressCount.storeRelease(0);
+            record->clickCount.storeRelease(0);
+            record->rejectedCount.storeRelease(0);
+            record->longPressCount.storeRelease(0);
+            record->pressLatency.reset();
+            record->clickLatency.reset();
+            record->longPressLatency.reset();
+            record->pressDuration.reset();
+        }
+    }
+}
+/*
+ *@brief:   查找统计记录，不存在时创建
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   recordHash:记录表
+ *@param:   key:键
+ *@return:  BaseButtonStatsRecord*:统计记录
+ */
+BaseButtonStatsRecord *BaseButtonStats::findRecord(QHash<QString, BaseButtonStatsRecord *> &recordHash,
+                                                   const QString &key)
+{
+    {
+        QReadLocker locker(&recordLock);
+        BaseButtonStatsRecord *record = recordHash.value(key,NULL);
+        if(record != NULL)
+        {
+            return record;
+        }
+    }
+    QWriteLocker locker(&recordLock);
+    BaseButtonStatsRecord *&record = recordHash[key];
+    if(record == NULL)
+    {
+        record = new BaseButtonStatsRecord();
+    }
+    return record;
+}
+/*
+ *@brief:   计算事件时间戳到当前的延迟，并用观察到的最小差值校准两个时钟的偏移
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   eventMs:事件时间戳 ms
+ *@return:  qint64:延迟 us，时间戳为0(无效)时返回-1
+ */
+qint64 BaseButtonStats::eventLatencyUs(qint64 eventMs)
+{
+    if(eventMs == 0)
+    {
+        return -1;
+    }
+    qint64 differenceUs = nowUs()-eventMs*1000;
+    if(!clockOffsetValid || differenceUs < clockOffsetUs)
+    {
+        clockOffsetUs = differenceUs;
+        clockOffsetValid = true;
+    }
+    return differenceUs-clockOffsetUs;
+}
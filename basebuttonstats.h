@@ -0,0 +1,148 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮输入延迟及防抖丢弃统计
+ *
+ * 1.在BaseToolButton的按下/释放/长按路径上记录:事件时间戳到pressed()/clicked()发出的延迟、长按信号
+ * 相对预定时刻的延迟、按下时长，以及按下/点击/防抖丢弃/长按次数。统计分别按按钮名称(btnName)和
+ * 按钮组(QButtonGroup)汇总，可以在运行中的界面上随时获取快照(p50/p90/p99/max)或导出为JSON。
+ * 2.延迟记录在固定分桶的直方图中(每个2的幂区间再均分为4个桶，单位us)。按钮第一次记录(或名称、所在
+ * 按钮组改变)时查找并缓存按钮及按钮组的统计记录(BaseButtonStatsRecords)，记录创建后不释放，之后的记录
+ * 直接使用缓存的指针，只对计数和桶做原子递增，不加锁、不查找哈希表，也不分配内存。按钮组的名称在该组
+ * 第一次被查找时确定。
+ * 3.事件时间戳的时钟起点与平台相关，这里以观察到的(当前时间-事件时间戳)最小值作为两个时钟的偏移，
+ * 所以输入延迟是相对最快一次分发的附加延迟，精度受事件时间戳(ms)限制。
+ * 4.统计默认关闭，关闭时每个记录点只多一次静态变量判断；定义BASE_BUTTON_NO_STATS宏时记录代码
+ * 完全不参与编译。
+ */
+#ifndef BASEBUTTONSTATS_H
+#define BASEBUTTONSTATS_H
+
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QAtomicInteger>
+#include <QReadWriteLock>
+#include <QElapsedTimer>
+#include <QByteArray>
+
+class QButtonGroup;
+
+#ifdef BASE_BUTTON_NO_STATS
+#define BASE_BUTTON_STATS(...)
+#else
+#define BASE_BUTTON_STATS(...) do{if(BaseButtonStats::isEnabled()){__VA_ARGS__;}}while(0)
+#endif
+
+//直方图快照
+struct BaseHistogramSnapshot
+{
+    quint32 count;//样本数
+    quint64 p50Us;//各分位数(所在桶的上界) us
+    quint64 p90Us;
+    quint64 p99Us;
+    quint64 maxUs;//最大值 us
+};
+
+//一个按钮(名称)或按钮组的统计快照
+struct BaseButtonStatsSnapshot
+{
+    QString key;//按钮名称或按钮组名称
+    bool isGroup;//是否为按钮组的统计
+    quint32 pressCount;//按下次数(通过防抖的)
+    quint32 clickCount;//点击次数
+    quint32 rejectedCount;//被防抖丢弃的按下次数
+    quint32 longPressCount;//长按信号次数
+    BaseHistogramSnapshot pressLatency;//事件时间戳到pressed()的延迟
+    BaseHistogramSnapshot clickLatency;//事件时间戳到clicked()的延迟
+    BaseHistogramSnapshot longPressLatency;//长按信号相对预定时刻的延迟
+    BaseHistogramSnapshot pressDuration;//按下时长
+};
+
+//无锁的固定分桶直方图 单位us
+class BaseLatencyHistogram
+{
+public:
+    enum {BucketCount = 100};//覆盖0~2^25us(约33s)，更大的值计入最后一个桶
+
+    BaseLatencyHistogram();
+    void record(quint64 valueUs);
+    BaseHistogramSnapshot snapshot() const;
+    void reset();
+
+private:
+    static int bucketIndex(quint64 valueUs);
+    static quint64 bucketUpperBound(int index);
+
+    QAtomicInteger<quint32> buckets[BucketCount];//桶计数
+    QAtomicInteger<quint32> maxValue;//最大值 us(超出32位时截断)
+};
+
+//一个按钮(名称)或按钮组的统计记录
+struct BaseButtonStatsRecord
+{
+    QAtomicInteger<quint32> pressCount;
+    QAtomicInteger<quint32> clickCount;
+    QAtomicInteger<quint32> rejectedCount;
+    QAtomicInteger<quint32> longPressCount;
+    BaseLatencyHistogram pressLatency;
+    BaseLatencyHistogram clickLatency;
+    BaseLatencyHistogram longPressLatency;
+    BaseLatencyHistogram pressDuration;
+};
+
+//按钮缓存的统计记录(由BaseButtonStats::resolveRecords()查找)
+struct BaseButtonStatsRecords
+{
+    BaseButtonStatsRecord *btnRecord;//按钮(名称)的记录 为NULL时需要重新查找
+    BaseButtonStatsRecord *groupRecord;//按钮组的记录 不在按钮组时为NULL
+    QButtonGroup *group;//查找记录时按钮所在的按钮组
+};
+
+class BaseButtonStats
+{
+public:
+    static BaseButtonStats *instance();
+    //开启/关闭统计
+    static void setEnabled(bool enabled){statsEnabled = enabled;}
+    static bool isEnabled(){return statsEnabled;}
+
+    qint64 nowUs(){return clockTimer.nsecsElapsed()/1000;}//统计使用的单调时钟 us
+
+    //查找(不存在时创建)按钮及按钮组的统计记录 加锁，只在缓存失效时调用
+    void resolveRecords(BaseButtonStatsRecords *records,const QString &btnName,QButtonGroup *group);
+    //记录点(由BaseToolButton以缓存的记录调用)
+    void recordPress(const BaseButtonStatsRecords &records,qint64 eventMs);
+    void recordRejected(const BaseButtonStatsRecords &records);
+    void recordRelease(const BaseButtonStatsRecords &records,qint64 eventMs,qint64 pressUs,bool clicked);
+    void recordLongPress(const BaseButtonStatsRecords &records,qint64 latenessUs);
+
+    //获取快照/导出JSON/清零
+    QList<BaseButtonStatsSnapshot> snapshot();
+    QByteArray exportJson();
+    void reset();
+
+private:
+    BaseButtonStats();
+    ~BaseButtonStats();
+
+    BaseButtonStatsRecord *findRecord(QHash<QString,BaseButtonStatsRecord *> &recordHash,
+                                      const QString &key);
+    qint64 eventLatencyUs(qint64 eventMs);
+
+    static bool statsEnabled;//统计使能标记 默认不使能
+    QElapsedTimer clockTimer;//单调时钟
+    qint64 clockOffsetUs;//事件时间戳时钟相对单调时钟的偏移(观察到的最小差值) us
+    bool clockOffsetValid;
+    QReadWriteLock recordLock;//保护记录表(记录本身是原子计数，创建后不释放，按钮缓存其指针)
+    QHash<QString,BaseButtonStatsRecord *> btnRecordHash;//按钮名称->统计记录
+    QHash<QString,BaseButtonStatsRecord *> groupRecordHash;//按钮组名称->统计记录
+};
+
+#endif // BASEBUTTONSTATS_H
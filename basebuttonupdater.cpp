@@ -0,0 +1,310 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  后台线程批量更新按钮状态
+ */
+#include "basebuttonupdater.h"
+#include "baseanimationdriver.h"
+#include <QVarLengthArray>
+#include <algorithm>
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   capacity:最大按钮数
+ *@param:   parent:父对象
+ */
+BaseButtonUpdater::BaseButtonUpdater(int capacity, QObject *parent)
+    :QObject(parent),pendingHead(NULL),flushScheduled(0),
+      postedCount(0),coalescedCount(0),appliedCount(0),flushCount(0)
+{
+    this->capacity = qMax(capacity,0);
+    updateSlots = new UpdateSlot[this->capacity*PropertyCount];//原子值默认构造为0/NULL
+    for(int i=0;i<this->capacity*PropertyCount;i++)
+    {
+        updateSlots[i].next = NULL;
+    }
+}
+/*
+ *@brief:   析构函数 释放尚未应用的文本/图标值
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseButtonUpdater::~BaseButtonUpdater()
+{
+    BaseAnimationDriver::instance()->stop(this);
+    for(int i=0;i<capacity*PropertyCount;i++)
+    {
+        delete updateSlots[i].stringValue.loadAcquire();
+    }
+    delete [] updateSlots;
+}
+/*
+ *@brief:   添加按钮(GUI线程)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮 析构后对应序号的更新被丢弃
+ *@return:  int:按钮序号，后台线程通过该序号写入状态；超出容量或btn为NULL时返回-1
+ */
+int BaseButtonUpdater::addButton(BaseToolButton *btn)
+{
+    if(btn == NULL || buttonList.size() >= capacity)
+    {
+        return -1;
+    }
+    buttonList.append(QPointer<BaseToolButton>(btn));
+    return buttonList.size()-1;
+}
+/*
+ *@brief:   写入按钮的选中状态(任意线程)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:按钮序号
+ *@param:   checked:是否选中
+ */
+void BaseButtonUpdater::postChecked(int index, bool checked)
+{
+    postBool(index,Checked,checked);
+}
+/*
+ *@brief:   写入按钮的使能状态(任意线程)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:按钮序号
+ *@param:   enabled:是否使能
+ */
+void BaseButtonUpdater::postEnabled(int index, bool enabled)
+{
+    postBool(index,Enabled,enabled);
+}
+/*
+ *@brief:   写入按钮的文本(任意线程)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:按钮序号
+ *@param:   text:文本
+ */
+void BaseButtonUpdater::postText(int index, const QString &text)
+{
+    postString(index,Text,text);
+}
+/*
+ *@brief:   写入按钮的图标(任意线程) 应用时以按钮当前的iconSize调用setBtnIcon()
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:按钮序号
+ *@param:   iconUrl:图标路径
+ */
+void BaseButtonUpdater::postIcon(int index, const QString &iconUrl)
+{
+    postString(index,Icon,iconUrl);
+}
+/*
+ *@brief:   写入布尔属性 槽原来没有值时压入待应用栈，否则只替换值
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:按钮序号
+ *@param:   property:属性
+ *@param:   value:值
+ */
+void BaseButtonUpdater::postBool(int index, Property property, bool value)
+{
+    if(index < 0 || index >= capacity)
+    {
+        return;
+    }
+    postedCount.fetchAndAddRelaxed(1);
+    UpdateSlot *slot = &updateSlots[index*PropertyCount+property];
+    if(slot->boolValue.fetchAndStoreOrdered(value?2:1) == 0)
+    {
+        pushSlot(slot);
+    }
+    else
+    {
+        coalescedCount.fetchAndAddRelaxed(1);
+    }
+}
+/*
+ *@brief:   写入字符串属性 新值整体替换旧值，被替换的旧值由写入者释放
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   index:按钮序号
+ *@param:   property:属性
+ *@param:   value:值
+ */
+void BaseButtonUpdater::postString(int index, Property property, const QString &value)
+{
+    if(index < 0 || index >= capacity)
+    {
+        return;
+    }
+    postedCount.fetchAndAddRelaxed(1);
+    UpdateSlot *slot = &updateSlots[index*PropertyCount+property];
+    QString *oldValue = slot->stringValue.fetchAndStoreOrdered(new QString(value));
+    if(oldValue == NULL)
+    {
+        pushSlot(slot);
+    }
+    else
+    {
+        delete oldValue;
+        coalescedCount.fetchAndAddRelaxed(1);
+    }
+}
+/*
+ *@brief:   将槽压入待应用栈 栈由空变为非空且还没有投递请求时，向GUI线程投递一次
+ * 只有将槽由空变为有值的写入者会压入该槽，所以同一个槽不会同时在栈中出现两次。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   slot:槽
+ */
+void BaseButtonUpdater::pushSlot(UpdateSlot *slot)
+{
+    UpdateSlot *head;
+    do
+    {
+        head = pendingHead.loadAcquire();
+        slot->next = head;
+    }while(!pendingHead.testAndSetRelease(head,slot));
+
+    if(head == NULL && flushScheduled.testAndSetOrdered(0,1))
+    {
+        QMetaObject::invokeMethod(this,"scheduleFlushSlot",Qt::QueuedConnection);
+    }
+}
+/*
+ *@brief:   立即应用所有待更新的状态(GUI线程)
+ * 一次取出整个待应用栈，先读出所有槽序号再清除槽的值(清除后写线程可能重新压入该槽并修改next)。
+ * 槽序号排序后同一按钮的属性相邻，应用期间暂停按钮的更新，结束时只触发一次update()。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  int:更新的按钮数
+ */
+int BaseButtonUpdater::flush()
+{
+    UpdateSlot *slot = pendingHead.fetchAndStoreAcquire(NULL);
+    if(slot == NULL)
+    {
+        return 0;
+    }
+    QVarLengthArray<int,256> slotIndexes;
+    while(slot != NULL)
+    {
+        slotIndexes.append(int(slot-updateSlots));
+        slot = slot->next;
+    }
+    std::sort(slotIndexes.begin(),slotIndexes.end());
+
+    int updatedButtons = 0;
+    int applied = 0;
+    BaseToolButton *pausedBtn = NULL;//暂停了更新的按钮
+    int lastBtnIndex = -1;
+    for(int i=0;i<slotIndexes.size();i++)
+    {
+        int btnIndex = slotIndexes.at(i)/PropertyCount;
+        Property property = Property(slotIndexes.at(i)%PropertyCount);
+        UpdateSlot *updateSlot = &updateSlots[slotIndexes.at(i)];
+        BaseToolButton *btn = (btnIndex < buttonList.size())?buttonList.at(btnIndex).data():NULL;
+        if(btnIndex != lastBtnIndex)
+        {
+            lastBtnIndex = btnIndex;
+            if(pausedBtn != NULL)
+            {
+                pausedBtn->setUpdatesEnabled(true);//触发一次update()
+                pausedBtn = NULL;
+            }
+            if(btn != NULL)
+            {
+                updatedButtons++;
+                //已被使用者暂停更新的按钮保持原状
+                if(btn->updatesEnabled())
+                {
+                    pausedBtn = btn;
+                    btn->setUpdatesEnabled(false);
+                }
+            }
+        }
+
+        if(property == Checked || property == Enabled)
+        {
+            int value = updateSlot->boolValue.fetchAndStoreAcquire(0);
+            if(btn == NULL || value == 0)
+            {
+                continue;
+            }
+            if(property == Checked)
+            {
+                btn->setChecked(value == 2);
+            }
+            else
+            {
+                btn->setEnabled(value == 2);
+            }
+        }
+        else
+        {
+            QString *value = updateSlot->stringValue.fetchAndStoreAcquire(NULL);
+            if(btn == NULL || value == NULL)
+            {
+                delete value;
+                continue;
+            }
+            if(property == Text)
+            {
+                btn->setText(*value);
+            }
+            else
+            {
+                btn->setBtnIcon(*value,btn->iconSize());
+            }
+            delete value;
+        }
+        applied++;
+    }
+    if(pausedBtn != NULL)
+    {
+        pausedBtn->setUpdatesEnabled(true);
+    }
+
+    appliedCount.fetchAndAddRelaxed(applied);
+    flushCount.fetchAndAddRelaxed(1);
+    return updatedButtons;
+}
+/*
+ *@brief:   GUI线程收到请求后注册到动画驱动，之后每帧批量应用
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseButtonUpdater::scheduleFlushSlot()
+{
+    BaseAnimationDriver::instance()->start(this,"flushFrameSlot");
+}
+/*
+ *@brief:   动画驱动的帧槽函数 应用本帧之前写入的所有状态，栈为空时停止
+ * 先清除投递标记再检查栈，期间压入的写入者会重新投递请求，不会遗漏更新。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   frameMs:当前帧时刻 ms
+ */
+void BaseButtonUpdater::flushFrameSlot(qint64 frameMs)
+{
+    Q_UNUSED(frameMs);
+    flush();
+    if(pendingHead.loadAcquire() != NULL)
+    {
+        return;//写线程在本帧应用期间又写入了新值，下一帧继续
+    }
+    flushScheduled.storeRelease(0);
+    if(pendingHead.loadAcquire() != NULL && flushScheduled.testAndSetOrdered(0,1))
+    {
+        return;
+    }
+    BaseAnimationDriver::instance()->stop(this);
+}
@@ -0,0 +1,95 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  后台线程批量更新按钮状态
+ *
+ * 1.后台线程将大量按钮用作状态指示灯，每秒变化成千上万次时，如果每次变化都单独投递到GUI线程，不仅事件
+ * 队列压力大，而且每次都会触发重绘。该类持有一组BaseToolButton，后台线程通过postChecked()/postEnabled()/
+ * postText()/postIcon()写入各按钮各属性的待更新值，写入是无锁的:每个(按钮,属性)对应一个原子槽，尚未应用时
+ * 再次写入只替换值(后写入的生效)，并计入合并数getCoalescedCount()。
+ * 2.槽由空变为有值时压入无锁的待应用栈(Treiber栈)，栈由空变为非空时才向GUI线程投递一次请求，之后由共享的
+ * 动画驱动BaseAnimationDriver每帧调用flush()批量应用，没有待应用的更新时自动停止。同一帧内一个按钮的所有
+ * 属性一起应用，应用期间暂停该按钮的更新，结束后只触发一次update()。
+ * 3.按钮序号由addButton()返回，后台线程只使用序号，不访问按钮对象。容量在构造时确定，槽数组不会重新分配。
+ * 注:addButton()/flush()只能在GUI线程调用，post*()可以在任意线程调用。postChecked()对不可选中的按钮无效。
+ */
+#ifndef BASEBUTTONUPDATER_H
+#define BASEBUTTONUPDATER_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QPointer>
+#include <QList>
+#include "basetoolbutton.h"
+
+class BaseButtonUpdater : public QObject
+{
+    Q_OBJECT
+public:
+    //按钮属性 每个按钮的每个属性对应一个槽
+    enum Property
+    {
+        Checked = 0,//选中状态
+        Enabled,//使能状态
+        Text,//文本
+        Icon,//图标路径(以按钮当前的iconSize设置)
+        PropertyCount
+    };
+
+    explicit BaseButtonUpdater(int capacity = 256,QObject *parent=0);
+    ~BaseButtonUpdater();
+
+    //添加按钮(GUI线程) 返回按钮序号，超出容量时返回-1
+    int addButton(BaseToolButton *btn);
+    int buttonCount(){return buttonList.size();}
+    int getCapacity(){return capacity;}
+
+    //写入待更新的状态(任意线程) 同一按钮同一属性未应用前再次写入时只保留最后的值
+    void postChecked(int index,bool checked);
+    void postEnabled(int index,bool enabled);
+    void postText(int index,const QString &text);
+    void postIcon(int index,const QString &iconUrl);
+
+    int flush();//立即应用所有待更新的状态(GUI线程) 返回更新的按钮数
+
+    quint32 getPostedCount(){return postedCount.loadAcquire();}//写入次数
+    quint32 getCoalescedCount(){return coalescedCount.loadAcquire();}//被后写入的值替换掉的次数
+    quint32 getAppliedCount(){return appliedCount.loadAcquire();}//实际应用的属性更新次数
+    quint32 getFlushCount(){return flushCount.loadAcquire();}//应用了更新的批次数
+
+private:
+    //原子槽
+    struct UpdateSlot
+    {
+        QAtomicInt boolValue;//选中/使能属性的值 0:无更新 1:false 2:true
+        QAtomicPointer<QString> stringValue;//文本/图标属性的值 NULL:无更新
+        UpdateSlot *next;//待应用栈中的下一个槽
+    };
+
+    void postBool(int index,Property property,bool value);
+    void postString(int index,Property property,const QString &value);
+    void pushSlot(UpdateSlot *slot);
+
+    int capacity;//最大按钮数
+    UpdateSlot *updateSlots;//capacity*PropertyCount个槽 序号为按钮序号*PropertyCount+属性
+    QAtomicPointer<UpdateSlot> pendingHead;//待应用栈的栈顶
+    QAtomicInt flushScheduled;//是否已投递请求或动画驱动正在运行
+    QList<QPointer<BaseToolButton> > buttonList;//按钮序号->按钮
+    QAtomicInt postedCount;//写入次数
+    QAtomicInt coalescedCount;//合并次数
+    QAtomicInt appliedCount;//应用次数
+    QAtomicInt flushCount;//批次数
+
+private slots:
+    void scheduleFlushSlot();
+    void flushFrameSlot(qint64 frameMs);
+};
+
+#endif // BASEBUTTONUPDATER_H
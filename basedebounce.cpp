@@ -0,0 +1,44 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮防抖引擎(无定时器)
+ */
+#include "basedebounce.h"
+
+/*
+ *@brief:   获取按钮组共享的防抖对象，不存在时创建(作为按钮组的子对象，随按钮组一起析构)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   buttonGroup:按钮组
+ *@return:  BaseDebounceGroup*:共享的防抖对象
+ */
+BaseDebounceGroup *BaseDebounceGroup::fromButtonGroup(QButtonGroup *buttonGroup)
+{
+    if(buttonGroup == NULL)
+    {
+        return NULL;
+    }
+    BaseDebounceGroup *debounceGroup = buttonGroup->findChild<BaseDebounceGroup *>(
+                QString(),Qt::FindDirectChildrenOnly);
+    if(debounceGroup == NULL)
+    {
+        debounceGroup = new BaseDebounceGroup(buttonGroup);
+    }
+    return debounceGroup;
+}
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   buttonGroup:按钮组(父对象)
+ */
+BaseDebounceGroup::BaseDebounceGroup(QButtonGroup *buttonGroup)
+    :QObject(buttonGroup)
+{
+}
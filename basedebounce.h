@@ -0,0 +1,52 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮防抖引擎(无定时器)
+ *
+ * 1.原先的防抖为每个按钮分配一个单次QTimer，并在每次按下时查询定时器是否激活。这里改为直接比较事件
+ * 的单调时间戳(QMouseEvent::timestamp())与上一次按下的时间，不需要分配内存也不需要注册定时器。
+ * 2.提供三种防抖策略:
+ *   前沿(LeadingEdge):响应按下后窗口时间内的按下都被丢弃，即原先的防抖行为。
+ *   后沿(TrailingEdge):每次按下(无论是否被响应)都会重新开始窗口，只有距离上一次按下静默超过窗口时间
+ *   才响应，适合抖动持续时间不确定的按键。
+ *   节流(Throttle):按固定速率划分时间窗口，每个窗口内最多响应一次按下。只限制响应速率，窗口边界两侧
+ *   间隔很短的两次按下都会响应，不能滤除开关抖动(应使用前沿或后沿策略)。
+ * 3.BaseDebounceGroup将一个防抖引擎挂载到QButtonGroup上，组内按钮共享同一个防抖窗口，作为一个整体防抖。
+ * 4.统计被丢弃的按下次数。
+ */
+#ifndef BASEDEBOUNCE_H
+#define BASEDEBOUNCE_H
+
+#include <QObject>
+#include <QButtonGroup>
+#include "basebuttoncore.h"
+
+//防抖引擎的判断逻辑在BaseDebounceState/BaseDebounceCore(basebuttoncore.h)中，与界面无关的按钮状态机核心共用
+class BaseDebounce : public BaseDebounceCore
+{
+public:
+    BaseDebounce(Policy policy = LeadingEdge,uint windowMs = 200)
+        :BaseDebounceCore(policy,windowMs){}
+};
+
+class BaseDebounceGroup : public QObject
+{
+    Q_OBJECT
+public:
+    static BaseDebounceGroup *fromButtonGroup(QButtonGroup *buttonGroup);
+
+    BaseDebounce &debounce(){return groupDebounce;}
+
+private:
+    explicit BaseDebounceGroup(QButtonGroup *buttonGroup);
+
+    BaseDebounce groupDebounce;//组内按钮共享的防抖引擎
+};
+
+#endif // BASEDEBOUNCE_H
@@ -0,0 +1,316 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮图标图集(进程内共享)
+ */
+#include "baseiconatlas.h"
+
+#define ATLAS_ICON_SPACING 1 //图标之间的间隔 像素
+#define ATLAS_MIN_PAGE_HEIGHT 64 //页的初始高度 像素
+
+/*
+ *@brief:   获取图集单例
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseIconAtlas*:图集
+ */
+BaseIconAtlas *BaseIconAtlas::instance()
+{
+    static BaseIconAtlas iconAtlas;
+    return &iconAtlas;
+}
+/*
+ *@brief:   构造函数 默认页尺寸1024x1024
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseIconAtlas::BaseIconAtlas()
+    :pageSize(1024,1024),generation(0)
+{
+}
+/*
+ *@brief:   获取图标在图集中的区域，首次获取时解码并装入图集
+ * 与QIcon绘制时一样，图标大于iconSize时保持比例缩小；scaledUp时缩放到iconSize。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否将图标放大(缩放)到iconSize
+ *@return:  BaseIconAtlasRegion:区域 加载失败时为无效区域
+ */
+BaseIconAtlasRegion BaseIconAtlas::region(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    QString key = iconKey(iconUrl,iconSize,scaledUp);
+    QHash<QString,BaseIconAtlasRegion>::const_iterator it = regionHash.constFind(key);
+    if(it != regionHash.constEnd())
+    {
+        return it.value();
+    }
+    QImage image(iconUrl);
+    if(!image.isNull())
+    {
+        if(scaledUp)
+        {
+            image = image.scaled(iconSize,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+        }
+        else if(image.width() > iconSize.width() || image.height() > iconSize.height())
+        {
+            image = image.scaled(iconSize,Qt::KeepAspectRatio,Qt::SmoothTransformation);
+        }
+    }
+    return insertImage(key,image);
+}
+/*
+ *@brief:   将图片装入图集 相同键的图片只装入一次
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   key:图片键
+ *@param:   image:图片 为空时记录为无效区域，避免对无效路径反复访问磁盘
+ *@return:  BaseIconAtlasRegion:区域
+ */
+BaseIconAtlasRegion BaseIconAtlas::insertImage(const QString &key, const QImage &image)
+{
+    QHash<QString,BaseIconAtlasRegion>::const_iterator it = regionHash.constFind(key);
+    if(it != regionHash.constEnd())
+    {
+        return it.value();
+    }
+    BaseIconAtlasRegion region;
+    region.generation = generation;
+    if(!image.isNull())
+    {
+        QSize allocSize = image.size()+QSize(ATLAS_ICON_SPACING,ATLAS_ICON_SPACING);
+        for(int i=0;i<pages.size() && region.isNull();i++)
+        {
+            if(allocate(i,allocSize,&region.rect))
+            {
+                region.page = i;
+            }
+        }
+        if(region.isNull())
+        {
+            //新建一页 比页尺寸大的图标单独占用一页
+            Page page;
+            page.width = qMax(pageSize.width(),allocSize.width());
+            page.nextY = 0;
+            page.usedArea = 0;
+            pages.append(page);
+            allocate(pages.size()-1,allocSize,&region.rect);
+            region.page = pages.size()-1;
+        }
+        region.rect.setSize(image.size());
+        Page &page = pages[region.page];
+        page.usedArea += qint64(image.width())*image.height();
+        QPainter painter(&page.image);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(region.rect.topLeft(),image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+    }
+    regionHash.insert(key,region);
+    return region;
+}
+/*
+ *@brief:   将区域以原始尺寸居中绘制到目标矩形(区域大于目标矩形时保持比例缩小)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   painter:画笔
+ *@param:   targetRect:目标矩形
+ *@param:   region:区域
+ *@param:   opacity:不透明度
+ */
+void BaseIconAtlas::draw(QPainter *painter, const QRect &targetRect, const BaseIconAtlasRegion &region,
+                         qreal opacity)
+{
+    if(!isRegionValid(region))
+    {
+        return;//无效或清空图集之前获取的区域
+    }
+    drawImage(painter,targetRect,pages.at(region.page).image,region.rect,opacity);
+}
+/*
+ *@brief:   将图片的源区域以原始尺寸居中绘制到目标矩形(源区域大于目标矩形时保持比例缩小)
+ * 图集页和图标包(BaseIconBundle)中的图标共用该绘制方式。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   painter:画笔
+ *@param:   targetRect:目标矩形
+ *@param:   image:图片
+ *@param:   sourceRect:源区域
+ *@param:   opacity:不透明度
+ */
+void BaseIconAtlas::drawImage(QPainter *painter, const QRect &targetRect, const QImage &image,
+                              const QRect &sourceRect, qreal opacity)
+{
+    QSize drawSize = sourceRect.size();
+    if(drawSize.width() > targetRect.width() || drawSize.height() > targetRect.height())
+    {
+        drawSize.scale(targetRect.size(),Qt::KeepAspectRatio);
+    }
+    QRect drawRect(QPoint(0,0),drawSize);
+    drawRect.moveCenter(targetRect.center());
+    qreal oldOpacity = painter->opacity();
+    if(opacity < 1.0)
+    {
+        painter->setOpacity(oldOpacity*opacity);
+    }
+    if(drawSize == sourceRect.size())
+    {
+        painter->drawImage(drawRect.topLeft(),image,sourceRect);
+    }
+    else
+    {
+        bool smooth = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+        painter->setRenderHint(QPainter::SmoothPixmapTransform,true);
+        painter->drawImage(drawRect,image,sourceRect);
+        painter->setRenderHint(QPainter::SmoothPixmapTransform,smooth);
+    }
+    painter->setOpacity(oldOpacity);
+}
+/*
+ *@brief:   获取页图片(用于调试或导出)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   page:页
+ *@return:  QImage:页图片 页不存在时为空
+ */
+QImage BaseIconAtlas::pageImage(int page)
+{
+    return (page >= 0 && page < pages.size())?pages.at(page).image:QImage();
+}
+/*
+ *@brief:   获取所有页占用的内存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  qint64:字节数
+ */
+qint64 BaseIconAtlas::memoryBytes()
+{
+    qint64 bytes = 0;
+    for(int i=0;i<pages.size();i++)
+    {
+        bytes += qint64(pages.at(i).image.bytesPerLine())*pages.at(i).image.height();
+    }
+    return bytes;
+}
+/*
+ *@brief:   获取已分配区域占页面积的比例
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  qreal:比例 没有页时为0
+ */
+qreal BaseIconAtlas::usage()
+{
+    qint64 usedArea = 0;
+    qint64 pageArea = 0;
+    for(int i=0;i<pages.size();i++)
+    {
+        usedArea += pages.at(i).usedArea;
+        pageArea += qint64(pages.at(i).image.width())*pages.at(i).image.height();
+    }
+    return (pageArea > 0)?qreal(usedArea)/pageArea:0;
+}
+/*
+ *@brief:   清空图集 之前获取的区域全部失效(代数递增，draw()不再绘制旧区域)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseIconAtlas::clear()
+{
+    pages.clear();
+    regionHash.clear();
+    generation++;
+}
+/*
+ *@brief:   生成图标键
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否缩放
+ *@return:  QString:图标键
+ */
+QString BaseIconAtlas::iconKey(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    //路径中可能含有%符号，所以这里直接拼接而不使用QString::arg()
+    return iconUrl+QString("|%1x%2|%3").arg(iconSize.width()).arg(iconSize.height()).arg(scaledUp?1:0);
+}
+/*
+ *@brief:   在指定页中分配区域 优先放入高度最接近的货架，没有合适的货架时在页底部新开货架
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   page:页
+ *@param:   size:区域尺寸(含间隔)
+ *@param:   rect:返回分配的区域
+ *@return:  bool:是否分配成功
+ */
+bool BaseIconAtlas::allocate(int page, QSize size, QRect *rect)
+{
+    Page &atlasPage = pages[page];
+    int pageWidth = atlasPage.width;
+    if(size.width() > pageWidth)
+    {
+        return false;
+    }
+    //高度最接近的货架(高度超过图标2倍的货架不考虑，避免浪费)
+    int bestShelf = -1;
+    for(int i=0;i<atlasPage.shelves.size();i++)
+    {
+        const Shelf &shelf = atlasPage.shelves.at(i);
+        if(shelf.height >= size.height() && shelf.height <= size.height()*2 &&
+                shelf.x+size.width() <= pageWidth &&
+                (bestShelf < 0 || shelf.height < atlasPage.shelves.at(bestShelf).height))
+        {
+            bestShelf = i;
+        }
+    }
+    if(bestShelf < 0)
+    {
+        //新开货架 超过页的最大高度时失败(单独占用一页的大图标除外)
+        int maxHeight = qMax(pageSize.height(),atlasPage.shelves.isEmpty()?size.height():0);
+        if(atlasPage.nextY+size.height() > maxHeight)
+        {
+            return false;
+        }
+        Shelf shelf;
+        shelf.y = atlasPage.nextY;
+        shelf.height = size.height();
+        shelf.x = 0;
+        atlasPage.shelves.append(shelf);
+        atlasPage.nextY += size.height();
+        bestShelf = atlasPage.shelves.size()-1;
+        if(atlasPage.nextY > atlasPage.image.height())
+        {
+            //高度加倍(不超过最大高度)，直到能容纳新货架
+            int height = qMax(atlasPage.image.height()*2,ATLAS_MIN_PAGE_HEIGHT);
+            growPage(atlasPage,qMax(qMin(height,maxHeight),atlasPage.nextY));
+        }
+    }
+    Shelf &shelf = atlasPage.shelves[bestShelf];
+    *rect = QRect(shelf.x,shelf.y,size.width(),size.height());
+    shelf.x += size.width();
+    return true;
+}
+/*
+ *@brief:   增加页的高度 已有内容保持原来的位置
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   page:页
+ *@param:   height:新的高度
+ */
+void BaseIconAtlas::growPage(Page &page, int height)
+{
+    QImage image(page.width,height,QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    if(!page.image.isNull())
+    {
+        QPainter painter(&image);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(0,0,page.image);
+    }
+    page.image = image;
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮图标图集(进程内共享)
+ *
+ * 1.通过setBtnIcon()/setBtnIcons()设置的图标，每个按钮持有一个QIcon，内部是一到三个单独分配的
+ * 小图片。该类在加载时将图标装入少数几张大的预乘ARGB32图片(页)中，按钮只保存图标所在的页和页内区域
+ * (BaseIconAtlasRegion)，绘制时从页中直接贴出对应区域。
+ * 2.采用货架(shelf)装箱:每页宽度固定，按行(货架)从左向右放置图标，新图标放入高度最接近且剩余宽度足够
+ * 的货架，没有时在页底部开一个新货架。页的高度随使用按需加倍(最大为setPageSize()设置的高度)，已分配的
+ * 区域坐标保持不变，所以少量图标时不会占用整页的内存。图标之间留1像素间隔，避免缩放绘制时相互渗色。
+ * 3.相同(路径,尺寸,scaledUp)的图标只解码并装入一次。图标不会单独移出图集，clear()清空整个图集，
+ * 清空后之前获取的区域全部失效(需要重新设置按钮图标)。区域记录获取时图集的代数，clear()使代数递增，
+ * draw()不绘制旧代数的区域，所以清空后再装入新图标时，旧区域不会贴出新页中无关的内容。
+ * 注:图集只能在GUI线程访问；页按设备像素比1保存，高DPI屏幕下会被放大绘制。
+ */
+#ifndef BASEICONATLAS_H
+#define BASEICONATLAS_H
+
+#include <QHash>
+#include <QImage>
+#include <QPainter>
+#include <QVector>
+
+//图标在图集中的位置
+struct BaseIconAtlasRegion
+{
+    BaseIconAtlasRegion():page(-1),generation(0){}
+    bool isNull() const{return page < 0;}
+
+    int page;//所在页 小于0表示无效(加载失败或未设置)
+    QRect rect;//页内区域
+    quint32 generation;//获取区域时图集的代数
+};
+
+class BaseIconAtlas
+{
+public:
+    static BaseIconAtlas *instance();
+
+    //获取图标在图集中的区域(首次获取时解码并装入图集)
+    BaseIconAtlasRegion region(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    BaseIconAtlasRegion insertImage(const QString &key,const QImage &image);
+    //将区域居中绘制到目标矩形
+    void draw(QPainter *painter,const QRect &targetRect,const BaseIconAtlasRegion &region,
+              qreal opacity = 1.0);
+    static void drawImage(QPainter *painter,const QRect &targetRect,const QImage &image,
+                          const QRect &sourceRect,qreal opacity = 1.0);
+
+    //设置/获取页的尺寸 宽度固定，高度为按需增长的上限(只对之后新建的页生效)
+    void setPageSize(QSize pageSize){this->pageSize = pageSize;}
+    QSize getPageSize(){return pageSize;}
+    int pageCount(){return pages.size();}
+    QImage pageImage(int page);
+    int iconCount(){return regionHash.size();}
+    qint64 memoryBytes();//所有页占用的内存 字节
+    qreal usage();//已分配区域占页面积的比例
+    void clear();//清空图集 之前获取的区域失效
+    quint32 getGeneration(){return generation;}//图集的代数 每次clear()递增
+    bool isRegionValid(const BaseIconAtlasRegion &region)
+    {return (region.page >= 0 && region.page < pages.size() && region.generation == generation);}
+
+private:
+    //货架 图标从左向右放置
+    struct Shelf
+    {
+        int y;//货架顶部
+        int height;//货架高度
+        int x;//下一个图标的左侧
+    };
+    //页
+    struct Page
+    {
+        QImage image;//预乘ARGB32图片 高度按需增长
+        int width;//页宽度
+        QVector<Shelf> shelves;//页中的货架
+        int nextY;//下一个货架的顶部
+        qint64 usedArea;//已分配的面积
+    };
+
+    BaseIconAtlas();
+
+    static QString iconKey(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    bool allocate(int page,QSize size,QRect *rect);
+    void growPage(Page &page,int height);//增加页的高度
+
+    QVector<Page> pages;//图集页
+    QHash<QString,BaseIconAtlasRegion> regionHash;//图标键->区域
+    QSize pageSize;//页宽度及最大高度
+    quint32 generation;//图集的代数
+};
+
+#endif // BASEICONATLAS_H
@@ -0,0 +1,457 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  预解码的按钮图标包(内存映射)
+ */
+#include "baseiconbundle.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QCryptographicHash>
+#include <QtDebug>
+#include <string.h>
+
+Q_STATIC_ASSERT(sizeof(BaseIconBundleHeader) == 48);
+Q_STATIC_ASSERT(sizeof(BaseIconBundleEntry) == 32);
+
+/*
+ *@brief:   设置错误信息
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   errorString:错误信息 为NULL时忽略
+ *@param:   text:错误描述
+ */
+static void setBundleError(QString *errorString,const QString &text)
+{
+    if(errorString != NULL)
+    {
+        *errorString = text;
+    }
+}
+/*
+ *@brief:   将路径转换为清理后的绝对路径(资源路径保持原样)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   path:路径
+ *@return:  QString:绝对路径
+ */
+static QString bundleAbsolutePath(const QString &path)
+{
+    return QDir::cleanPath(QFileInfo(QDir::fromNativeSeparators(path)).absoluteFilePath());
+}
+/*
+ *@brief:   检查映射的图标包 文件头、索引、名称及像素数据的范围都必须在文件内
+ * (先检查偏移再用剩余字节数比较，损坏的偏移不会因相加溢出而通过检查；每行字节数*高度不超过48位)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   data:映射的数据
+ *@param:   size:数据字节数
+ *@return:  bool:是否有效
+ */
+static bool checkBundle(const uchar *data,qint64 size)
+{
+    if(size < qint64(sizeof(BaseIconBundleHeader)))
+    {
+        return false;
+    }
+    const BaseIconBundleHeader *header = reinterpret_cast<const BaseIconBundleHeader *>(data);
+    if(memcmp(header->magic,ICON_BUNDLE_MAGIC,4) != 0 || header->version != ICON_BUNDLE_VERSION ||
+            header->byteOrder != ICON_BUNDLE_BYTE_ORDER || header->fileSize != quint64(size))
+    {
+        return false;
+    }
+    quint64 indexEnd = sizeof(BaseIconBundleHeader)+quint64(header->entryCount)*sizeof(BaseIconBundleEntry);
+    if(header->nameOffset != indexEnd || quint64(header->nameOffset)+header->nameSize > quint64(size) ||
+            quint64(header->rootOffset)+header->rootLength > header->nameSize)
+    {
+        return false;
+    }
+    const BaseIconBundleEntry *entries = reinterpret_cast<const BaseIconBundleEntry *>(
+                data+sizeof(BaseIconBundleHeader));
+    for(quint32 i=0;i<header->entryCount;i++)
+    {
+        const BaseIconBundleEntry &entry = entries[i];
+        if(quint64(entry.nameOffset)+entry.nameLength > header->nameSize ||
+                entry.width == 0 || entry.height == 0 || entry.bytesPerLine < quint32(entry.width)*4 ||
+                entry.dataOffset%4 != 0 || entry.dataOffset > quint64(size) ||
+                quint64(entry.bytesPerLine)*entry.height > quint64(size)-entry.dataOffset)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ *@brief:   获取图标包单例
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseIconBundle*:图标包单例指针
+ */
+BaseIconBundle *BaseIconBundle::instance()
+{
+    static BaseIconBundle iconBundle;
+    return &iconBundle;
+}
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseIconBundle::BaseIconBundle()
+    :mapping(NULL),entries(NULL),entryCount(0)
+{
+}
+/*
+ *@brief:   析构函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseIconBundle::~BaseIconBundle()
+{
+    close();
+}
+/*
+ *@brief:   将目录(含子目录)中的图标打包 每个图标按各尺寸解码、缩放为与setBtnIcon()相同的效果
+ * (未放大时大于图标尺寸的图片保持比例缩小，放大时缩放到图标尺寸)，转换为预乘ARGB32后写入。
+ * 文件按相对路径排序，相同输入生成的包逐字节相同。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconDir:图标目录 图标名称为相对于该目录的路径
+ *@param:   iconSizes:使用的图标尺寸
+ *@param:   scaledUp:是否同时打包放大(缩放)到各尺寸的图片(对应setBtnIcon()的scaledUp参数)
+ *@param:   fileName:输出的图标包文件
+ *@param:   errorString:返回错误信息
+ *@return:  bool:是否成功
+ */
+bool BaseIconBundle::build(const QString &iconDir, const QList<QSize> &iconSizes, bool scaledUp,
+                           const QString &fileName, QString *errorString)
+{
+    QDir dir(iconDir);
+    if(!dir.exists() || iconSizes.isEmpty())
+    {
+        setBundleError(errorString,QString("invalid icon directory or no icon size: %1").arg(iconDir));
+        return false;
+    }
+    QStringList nameFilters;
+    QList<QByteArray> formats = QImageReader::supportedImageFormats();
+    for(int i=0;i<formats.size();i++)
+    {
+        nameFilters.append("*."+QString::fromLatin1(formats.at(i)));
+    }
+    QStringList fileList;
+    QDirIterator dirIterator(iconDir,nameFilters,QDir::Files,QDirIterator::Subdirectories);
+    while(dirIterator.hasNext())
+    {
+        fileList.append(dir.relativeFilePath(dirIterator.next()));
+    }
+    fileList.sort();
+
+    QVector<BaseIconBundleEntry> entryList;
+    QVector<int> entryImages;//索引项->像素数据序号
+    QByteArray nameData;//名称区
+    QList<QImage> imageList;//需要保存的像素数据(内容相同的只保存一份)
+    QHash<QByteArray,int> imageHash;//像素内容的MD5->像素数据序号
+    for(int i=0;i<fileList.size();i++)
+    {
+        QImage sourceImage(dir.filePath(fileList.at(i)));
+        if(sourceImage.isNull())
+        {
+            qWarning()<<"BaseIconBundle::build: skip unreadable image"<<fileList.at(i);
+            continue;
+        }
+        QByteArray name = fileList.at(i).toUtf8();
+        quint32 nameOffset = quint32(nameData.size());
+        nameData.append(name);
+        for(int j=0;j<iconSizes.size();j++)
+        {
+            QSize iconSize = iconSizes.at(j);
+            for(int scaled=0;scaled<=(scaledUp?1:0);scaled++)
+            {
+                QImage image = sourceImage;
+                if(scaled)
+                {
+                    image = image.scaled(iconSize,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+                }
+                else if(image.width() > iconSize.width() || image.height() > iconSize.height())
+                {
+                    image = image.scaled(iconSize,Qt::KeepAspectRatio,Qt::SmoothTransformation);
+                }
+                image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+                if(image.isNull() || image.width() > 0xFFFF || image.height() > 0xFFFF)
+                {
+                    continue;
+                }
+                QCryptographicHash hash(QCryptographicHash::Md5);
+                QByteArray sizeKey = QByteArray::number(image.width())+"x"+QByteArray::number(image.height());
+                hash.addData(sizeKey);
+                for(int y=0;y<image.height();y++)
+                {
+                    hash.addData(reinterpret_cast<const char *>(image.constScanLine(y)),image.width()*4);
+                }
+                int imageIndex = imageHash.value(hash.result(),-1);
+                if(imageIndex < 0)
+                {
+                    imageIndex = imageList.size();
+                    imageList.append(image);
+                    imageHash.insert(hash.result(),imageIndex);
+                }
+
+                BaseIconBundleEntry entry;
+                memset(&entry,0,sizeof(entry));
+                entry.nameOffset = nameOffset;
+                entry.nameLength = quint32(name.size());
+                entry.iconWidth = quint16(iconSize.width());
+                entry.iconHeight = quint16(iconSize.height());
+                entry.width = quint16(image.width());
+                entry.height = quint16(image.height());
+                entry.flags = scaled?1:0;
+                entry.bytesPerLine = quint32(image.width())*4;
+                entryList.append(entry);
+                entryImages.append(imageIndex);
+            }
+        }
+    }
+    if(entryList.isEmpty())
+    {
+        setBundleError(errorString,QString("no readable icon in %1").arg(iconDir));
+        return false;
+    }
+    //记录打包目录，运行时只有该目录下的路径才使用图标包
+    QByteArray rootPath = bundleAbsolutePath(iconDir).toUtf8();
+    quint32 rootOffset = quint32(nameData.size());
+    nameData.append(rootPath);
+
+    //布局:文件头 索引 名称区 像素数据(各自对齐)
+    BaseIconBundleHeader header;
+    memset(&header,0,sizeof(header));
+    memcpy(header.magic,ICON_BUNDLE_MAGIC,4);
+    header.version = ICON_BUNDLE_VERSION;
+    header.byteOrder = ICON_BUNDLE_BYTE_ORDER;
+    header.entryCount = quint32(entryList.size());
+    header.nameOffset = quint32(sizeof(BaseIconBundleHeader)+entryList.size()*sizeof(BaseIconBundleEntry));
+    header.nameSize = quint32(nameData.size());
+    header.rootOffset = rootOffset;
+    header.rootLength = quint32(rootPath.size());
+    quint64 offset = quint64(header.nameOffset)+header.nameSize;
+    QVector<quint64> imageOffsets;
+    for(int i=0;i<imageList.size();i++)
+    {
+        offset = (offset+ICON_BUNDLE_ALIGN-1)/ICON_BUNDLE_ALIGN*ICON_BUNDLE_ALIGN;
+        imageOffsets.append(offset);
+        offset += quint64(imageList.at(i).width())*4*imageList.at(i).height();
+    }
+    header.fileSize = offset;
+    for(int i=0;i<entryList.size();i++)
+    {
+        entryList[i].dataOffset = imageOffsets.at(entryImages.at(i));
+    }
+
+    QSaveFile saveFile(fileName);
+    if(!saveFile.open(QIODevice::WriteOnly))
+    {
+        setBundleError(errorString,saveFile.errorString());
+        return false;
+    }
+    saveFile.write(reinterpret_cast<const char *>(&header),sizeof(header));
+    saveFile.write(reinterpret_cast<const char *>(entryList.constData()),
+                   entryList.size()*sizeof(BaseIconBundleEntry));
+    saveFile.write(nameData);
+    quint64 written = quint64(header.nameOffset)+header.nameSize;
+    for(int i=0;i<imageList.size();i++)
+    {
+        const QImage &image = imageList.at(i);
+        saveFile.write(QByteArray(int(imageOffsets.at(i)-written),'\0'));
+        for(int y=0;y<image.height();y++)
+        {
+            saveFile.write(reinterpret_cast<const char *>(image.constScanLine(y)),image.width()*4);
+        }
+        written = imageOffsets.at(i)+quint64(image.width())*4*image.height();
+    }
+    if(!saveFile.commit())
+    {
+        setBundleError(errorString,saveFile.errorString());
+        return false;
+    }
+    return true;
+}
+/*
+ *@brief:   打开(映射)图标包 之前打开的包被关闭
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   fileName:图标包文件
+ *@return:  bool:是否成功 文件格式、版本或字节序不符时失败
+ */
+bool BaseIconBundle::open(const QString &fileName)
+{
+    close();
+    Mapping *newMapping = new Mapping;
+    newMapping->file.setFileName(fileName);
+    newMapping->data = NULL;
+    newMapping->size = 0;
+    if(newMapping->file.open(QIODevice::ReadOnly))
+    {
+        newMapping->size = newMapping->file.size();
+        if(newMapping->size > 0)
+        {
+            newMapping->data = newMapping->file.map(0,newMapping->size);
+        }
+    }
+    if(newMapping->data == NULL || !checkBundle(newMapping->data,newMapping->size))
+    {
+        qWarning()<<"BaseIconBundle::open: invalid icon bundle"<<fileName;
+        if(newMapping->data != NULL)
+        {
+            newMapping->file.unmap(newMapping->data);
+        }
+        delete newMapping;
+        return false;
+    }
+
+    newMapping->refCount.ref();
+    mapping = newMapping;
+    const BaseIconBundleHeader *header = reinterpret_cast<const BaseIconBundleHeader *>(mapping->data);
+    entries = reinterpret_cast<const BaseIconBundleEntry *>(mapping->data+sizeof(BaseIconBundleHeader));
+    entryCount = int(header->entryCount);
+    const char *names = reinterpret_cast<const char *>(mapping->data+header->nameOffset);
+    for(int i=0;i<entryCount;i++)
+    {
+        nameHash[QString::fromUtf8(names+entries[i].nameOffset,int(entries[i].nameLength))].append(i);
+    }
+    imageCache.resize(entryCount);
+    bundleRoot = QString::fromUtf8(names+header->rootOffset,int(header->rootLength));
+    iconRoot = configuredRoot.isEmpty()?bundleRoot:configuredRoot;
+    return true;
+}
+/*
+ *@brief:   关闭图标包 已获取的图片仍引用映射，全部析构后才解除映射
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseIconBundle::close()
+{
+    if(mapping == NULL)
+    {
+        return;
+    }
+    imageCache.clear();//缓存的图片析构时释放各自的引用
+    nameHash.clear();
+    bundleRoot.clear();
+    iconRoot = configuredRoot;
+    entries = NULL;
+    entryCount = 0;
+    Mapping *oldMapping = mapping;
+    mapping = NULL;
+    releaseMapping(oldMapping);
+}
+/*
+ *@brief:   按名称获取图标 返回的图片直接引用映射的像素(只读，修改时才会复制)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   name:图标名称(相对于打包目录的路径)
+ *@param:   iconSize:图标尺寸
+ *@param:   scaledUp:是否放大(缩放)到图标尺寸
+ *@return:  QImage:图标 包中没有时返回空图片
+ */
+QImage BaseIconBundle::image(const QString &name, QSize iconSize, bool scaledUp)
+{
+    if(mapping == NULL)
+    {
+        return QImage();
+    }
+    QHash<QString,QList<int> >::const_iterator it = nameHash.constFind(name);
+    if(it == nameHash.constEnd())
+    {
+        return QImage();
+    }
+    const QList<int> &indexes = it.value();
+    for(int i=0;i<indexes.size();i++)
+    {
+        int index = indexes.at(i);
+        const BaseIconBundleEntry &entry = entries[index];
+        if(entry.iconWidth != iconSize.width() || entry.iconHeight != iconSize.height() ||
+                (entry.flags&1) != (scaledUp?1u:0u))
+        {
+            continue;
+        }
+        if(imageCache.at(index).isNull())
+        {
+            mapping->refCount.ref();
+            imageCache[index] = QImage(static_cast<const uchar *>(mapping->data+entry.dataOffset),
+                                       entry.width,entry.height,int(entry.bytesPerLine),
+                                       QImage::Format_ARGB32_Premultiplied,releaseMapping,mapping);
+        }
+        return imageCache.at(index);
+    }
+    return QImage();
+}
+/*
+ *@brief:   按图标路径查找图标 只有位于图标根目录下的路径才查找，名称为相对于根目录的路径，如根目录为
+ * "/opt/app/images"时"/opt/app/images/1.ico"查找"1.ico"；根目录以外的路径即使文件名相同也返回空图片，
+ * 由调用者解码该文件。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径 相对路径相对于当前工作目录
+ *@param:   iconSize:图标尺寸
+ *@param:   scaledUp:是否放大(缩放)到图标尺寸
+ *@return:  QImage:图标 包中没有或不在根目录下时返回空图片
+ */
+QImage BaseIconBundle::findImage(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    if(mapping == NULL || iconUrl.isEmpty() || iconRoot.isEmpty())
+    {
+        return QImage();
+    }
+    QString path = bundleAbsolutePath(iconUrl);
+    QString rootPrefix = iconRoot.endsWith('/')?iconRoot:(iconRoot+'/');
+    if(!path.startsWith(rootPrefix))
+    {
+        return QImage();
+    }
+    return image(path.mid(rootPrefix.size()),iconSize,scaledUp);
+}
+/*
+ *@brief:   设置图标根目录 运行时图标所在的目录与打包时不同(如在构建机上打包)时使用
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconRoot:图标根目录 为空时恢复为打包时记录的目录
+ */
+void BaseIconBundle::setIconRoot(const QString &iconRoot)
+{
+    configuredRoot = iconRoot.isEmpty()?QString():bundleAbsolutePath(iconRoot);
+    this->iconRoot = configuredRoot.isEmpty()?bundleRoot:configuredRoot;
+}
+/*
+ *@brief:   获取映射的字节数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  qint64:字节数 未打开时为0
+ */
+qint64 BaseIconBundle::mappedBytes()
+{
+    return (mapping != NULL)?mapping->size:0;
+}
+/*
+ *@brief:   释放映射的一个引用 包和引用像素的图片都释放后解除映射(图片可能在其他线程析构)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   info:映射
+ */
+void BaseIconBundle::releaseMapping(void *info)
+{
+    Mapping *releasedMapping = static_cast<Mapping *>(info);
+    if(!releasedMapping->refCount.deref())
+    {
+        releasedMapping->file.unmap(releasedMapping->data);
+        releasedMapping->file.close();
+        delete releasedMapping;
+    }
+}
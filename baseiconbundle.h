@@ -0,0 +1,118 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  预解码的按钮图标包(内存映射)
+ *
+ * 1.每次启动时setBtnIcon()/setBtnIcons()都要从.ico/.png文件解码同样的图标，在较慢的嵌入式flash上
+ * 占启动时间的很大一部分。构建时用tools/iconbundler(内部调用build())将图标目录中的图标按使用的各个
+ * 尺寸解码、缩放并转换为预乘ARGB32像素，连同索引打包为一个二进制文件。
+ * 2.运行时open()通过QFile::map()将包映射到内存，image()返回的QImage直接引用映射的像素，不解码也不
+ * 复制；所有引用像素的QImage都析构后才解除映射，所以close()之后已设置到按钮上的图标仍然有效。
+ * 3.包打开后，BaseToolButton的setBtnIcon()/setBtnIcons()/setBtnIconAsync()优先按名称从包中取图标，
+ * 取到时直接绘制映射的图片(与图集图标一样不持有QIcon)，包中没有时仍走解码路径。名称为图标相对于打包
+ * 目录的路径；按路径查找时只有位于图标根目录下的路径才使用图标包，根目录默认为打包时记录的目录(绝对
+ * 路径)，运行时图标所在目录不同时通过setIconRoot()指定。根目录以外的同名文件(如/tmp/1.ico)仍然解码。
+ * 4.文件格式(本机字节序，像素按QImage::Format_ARGB32_Premultiplied保存，只能在字节序相同的机器上使用):
+ *   文件头(BaseIconBundleHeader 48字节) 索引(BaseIconBundleEntry 每项32字节) 名称区(UTF-8，末尾为
+ *   打包目录的绝对路径)
+ *   像素数据(每张图片64字节对齐，内容相同的图片只保存一份)
+ * 注:该类只能在GUI线程访问。
+ */
+#ifndef BASEICONBUNDLE_H
+#define BASEICONBUNDLE_H
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QVector>
+#include <QAtomicInt>
+
+#define ICON_BUNDLE_MAGIC "BBIB"
+#define ICON_BUNDLE_VERSION 2
+#define ICON_BUNDLE_BYTE_ORDER 0x01020304u //按本机字节序写入，读取时不一致说明字节序不同
+#define ICON_BUNDLE_ALIGN 64 //像素数据的对齐字节数
+
+//图标包文件头
+struct BaseIconBundleHeader
+{
+    char magic[4];//"BBIB"
+    quint32 version;//格式版本
+    quint32 byteOrder;//ICON_BUNDLE_BYTE_ORDER
+    quint32 entryCount;//索引项数
+    quint32 nameOffset;//名称区在文件中的偏移
+    quint32 nameSize;//名称区字节数
+    quint64 fileSize;//文件总字节数(检查文件是否被截断)
+    quint32 rootOffset;//打包目录路径在名称区中的偏移
+    quint32 rootLength;//打包目录路径的UTF-8字节数
+    quint64 reserved;
+};
+//图标包索引项
+struct BaseIconBundleEntry
+{
+    quint32 nameOffset;//名称在名称区中的偏移
+    quint32 nameLength;//名称的UTF-8字节数
+    quint16 iconWidth;//打包时的图标尺寸(即setBtnIcon()的iconSize)
+    quint16 iconHeight;
+    quint16 width;//图片的像素尺寸(未放大时可能小于图标尺寸)
+    quint16 height;
+    quint32 flags;//bit0:放大(缩放)到图标尺寸(scaledUp)
+    quint32 bytesPerLine;//每行字节数
+    quint64 dataOffset;//像素数据在文件中的偏移
+};
+
+class BaseIconBundle
+{
+public:
+    static BaseIconBundle *instance();
+    ~BaseIconBundle();
+
+    //将目录(含子目录)中的图标按各尺寸打包 scaledUp为true时同时打包放大(缩放)到各尺寸的图片
+    static bool build(const QString &iconDir,const QList<QSize> &iconSizes,bool scaledUp,
+                      const QString &fileName,QString *errorString = NULL);
+
+    bool open(const QString &fileName);//映射图标包 之前打开的包被关闭
+    void close();
+    bool isOpen(){return mapping != NULL;}
+    //按名称获取图标 不存在时返回空图片
+    QImage image(const QString &name,QSize iconSize,bool scaledUp);
+    //按图标路径查找 只查找图标根目录下的路径，名称为相对于根目录的路径
+    QImage findImage(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    //设置/获取图标根目录 为空时使用打包时记录的目录
+    void setIconRoot(const QString &iconRoot);
+    QString getIconRoot(){return iconRoot;}
+
+    int iconCount(){return entryCount;}//索引项数(名称与尺寸的组合数)
+    qint64 mappedBytes();//映射的字节数
+
+private:
+    //映射的文件 包本身和每张引用像素的图片各持有一个引用
+    struct Mapping
+    {
+        QFile file;
+        uchar *data;
+        qint64 size;
+        QAtomicInt refCount;
+    };
+
+    BaseIconBundle();
+
+    static void releaseMapping(void *info);
+
+    Mapping *mapping;//当前映射 未打开时为NULL
+    const BaseIconBundleEntry *entries;//映射中的索引
+    int entryCount;//索引项数
+    QHash<QString,QList<int> > nameHash;//名称->索引项序号(各尺寸)
+    QVector<QImage> imageCache;//索引项序号->已创建的图片(同一图标的按钮共享)
+    QString bundleRoot;//打包时记录的目录
+    QString configuredRoot;//setIconRoot()设置的根目录
+    QString iconRoot;//实际使用的图标根目录(清理后的绝对路径)
+};
+
+#endif // BASEICONBUNDLE_H
@@ -0,0 +1,295 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮图标缓存(进程内共享)
+ */
+#include "baseiconcache.h"
+#include <QCoreApplication>
+#include <QPointer>
+
+#define ICON_CACHE_LIMIT_KB 8192 //默认的缓存内存预算 KB
+
+/*
+ *@brief:   获取缓存单例(父对象为应用程序对象，随应用程序一起析构)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseIconCache*:缓存单例指针
+ */
+BaseIconCache *BaseIconCache::instance()
+{
+    static QPointer<BaseIconCache> iconCache;
+    if(iconCache.isNull())
+    {
+        iconCache = new BaseIconCache(QCoreApplication::instance());
+    }
+    return iconCache.data();
+}
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseIconCache::BaseIconCache(QObject *parent)
+    :QObject(parent),hits(0),misses(0)
+{
+    iconCache.setMaxCost(ICON_CACHE_LIMIT_KB);
+}
+/*
+ *@brief:   获取单状态(Normal/Off)图标，未命中时解码(缩放)图标文件并放入缓存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否将图标放大(缩放)到iconSize
+ *@return:  QIcon:图标，与其他相同配置的按钮共享数据
+ */
+QIcon BaseIconCache::icon(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    QString key = iconKey(iconUrl,iconSize,scaledUp);
+    bool found = false;
+    QIcon icon = cachedIcon(key,&found);
+    if(found)
+    {
+        return icon;
+    }
+
+    return insertPixmap(iconUrl,iconSize,scaledUp,loadPixmap(iconUrl,iconSize,scaledUp));
+}
+/*
+ *@brief:   查找缓存的单状态图标，未命中时不解码
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否将图标放大(缩放)到iconSize
+ *@param:   icon:命中时返回缓存的图标
+ *@return:  bool:是否命中
+ */
+bool BaseIconCache::findIcon(const QString &iconUrl, QSize iconSize, bool scaledUp, QIcon *icon)
+{
+    bool found = false;
+    QIcon cached = cachedIcon(iconKey(iconUrl,iconSize,scaledUp),&found);
+    if(found)
+    {
+        *icon = cached;
+    }
+    return found;
+}
+/*
+ *@brief:   查找缓存的多状态图标，未命中时不解码
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   normalIcon:正常状态图标路径
+ *@param:   checkedIcon:选中状态图标路径
+ *@param:   disabledIcon:禁用状态图标路径
+ *@param:   iconSize:图标尺寸
+ *@param:   icon:命中时返回缓存的图标
+ *@return:  bool:是否命中
+ */
+bool BaseIconCache::findIcons(const QString &normalIcon, const QString &checkedIcon,
+                              const QString &disabledIcon, QSize iconSize, QIcon *icon)
+{
+    bool found = false;
+    QIcon cached = cachedIcon(iconsKey(normalIcon,checkedIcon,disabledIcon,iconSize),&found);
+    if(found)
+    {
+        *icon = cached;
+    }
+    return found;
+}
+/*
+ *@brief:   将已经解码(缩放)好的图片作为单状态图标放入缓存，加载失败(图片为空)时不缓存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否已放大(缩放)到iconSize
+ *@param:   pixmap:解码后的图片
+ *@return:  QIcon:图标
+ */
+QIcon BaseIconCache::insertPixmap(const QString &iconUrl, QSize iconSize, bool scaledUp,
+                                  const QPixmap &pixmap)
+{
+    QIcon icon(pixmap);
+    if(!pixmap.isNull())
+    {
+        insertIcon(iconKey(iconUrl,iconSize,scaledUp),icon,pixmapCostKb(pixmap));
+    }
+    return icon;
+}
+/*
+ *@brief:   将已经解码好的各状态图片组合为多状态图标放入缓存，有状态加载失败时只返回组合的图标而不缓存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   normalIcon:正常状态图标路径(为空时不设置该状态，下同)
+ *@param:   checkedIcon:选中状态图标路径
+ *@param:   disabledIcon:禁用状态图标路径
+ *@param:   iconSize:图标尺寸
+ *@param:   normalPixmap:正常状态图片
+ *@param:   checkedPixmap:选中状态图片
+ *@param:   disabledPixmap:禁用状态图片
+ *@return:  QIcon:组合后的图标
+ */
+QIcon BaseIconCache::insertPixmaps(const QString &normalIcon, const QString &checkedIcon,
+                                   const QString &disabledIcon, QSize iconSize,
+                                   const QPixmap &normalPixmap, const QPixmap &checkedPixmap,
+                                   const QPixmap &disabledPixmap)
+{
+    QIcon icon;
+    int costKb = 0;
+    bool loadFailed = false;
+    if(!normalIcon.isEmpty())
+    {
+        icon.addPixmap(normalPixmap,QIcon::Normal,QIcon::Off);
+        costKb += pixmapCostKb(normalPixmap);
+        loadFailed = loadFailed || normalPixmap.isNull();
+    }
+    if(!checkedIcon.isEmpty())
+    {
+        icon.addPixmap(checkedPixmap,QIcon::Normal,QIcon::On);
+        costKb += pixmapCostKb(checkedPixmap);
+        loadFailed = loadFailed || checkedPixmap.isNull();
+    }
+    if(!disabledIcon.isEmpty())
+    {
+        icon.addPixmap(disabledPixmap,QIcon::Disabled,QIcon::Off);
+        costKb += pixmapCostKb(disabledPixmap);
+        loadFailed = loadFailed || disabledPixmap.isNull();
+    }
+    if(!loadFailed)
+    {
+        insertIcon(iconsKey(normalIcon,checkedIcon,disabledIcon,iconSize),icon,costKb);
+    }
+    return icon;
+}
+/*
+ *@brief:   获取多状态图标，未命中时解码各状态图标文件并组合后放入缓存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   normalIcon:正常状态图标路径
+ *@param:   checkedIcon:选中状态图标路径
+ *@param:   disabledIcon:禁用状态图标路径
+ *@param:   iconSize:图标尺寸
+ *@return:  QIcon:组合后的图标，与其他相同配置的按钮共享数据
+ */
+QIcon BaseIconCache::icons(const QString &normalIcon, const QString &checkedIcon,
+                           const QString &disabledIcon, QSize iconSize)
+{
+    QIcon icon;
+    if(findIcons(normalIcon,checkedIcon,disabledIcon,iconSize,&icon))
+    {
+        return icon;
+    }
+    //路径为空的状态loadPixmap()返回空图片，组合时会跳过该状态
+    return insertPixmaps(normalIcon,checkedIcon,disabledIcon,iconSize,
+                         loadPixmap(normalIcon,iconSize,false),
+                         loadPixmap(checkedIcon,iconSize,false),
+                         loadPixmap(disabledIcon,iconSize,false));
+}
+/*
+ *@brief:   生成单状态图标的缓存键
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否缩放
+ *@return:  QString:缓存键
+ */
+QString BaseIconCache::iconKey(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    //不缩放时解码结果与请求尺寸无关，键中忽略尺寸使不同尺寸的按钮也能共享
+    QSize keySize = scaledUp?iconSize:QSize();
+    //路径中可能含有%符号，所以这里直接拼接而不使用QString::arg()
+    return QString("icon|")+iconUrl+QString("|%1x%2|%3|normal-off")
+            .arg(keySize.width()).arg(keySize.height()).arg(scaledUp?1:0);
+}
+/*
+ *@brief:   生成多状态图标的缓存键
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   normalIcon:正常状态图标路径
+ *@param:   checkedIcon:选中状态图标路径
+ *@param:   disabledIcon:禁用状态图标路径
+ *@param:   iconSize:图标尺寸
+ *@return:  QString:缓存键
+ */
+QString BaseIconCache::iconsKey(const QString &normalIcon, const QString &checkedIcon,
+                                const QString &disabledIcon, QSize iconSize)
+{
+    return QString("icons|")+normalIcon+QChar('|')+checkedIcon+QChar('|')+disabledIcon
+            +QString("|%1x%2").arg(iconSize.width()).arg(iconSize.height());
+}
+/*
+ *@brief:   从文件解码图标，根据需要放大(缩放)到指定尺寸
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否缩放
+ *@return:  QPixmap:解码后的图片
+ */
+QPixmap BaseIconCache::loadPixmap(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    QPixmap iconPixmap(iconUrl);
+    if(scaledUp && !iconPixmap.isNull())
+    {
+        iconPixmap = iconPixmap.scaled(iconSize,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+    }
+    return iconPixmap;
+}
+/*
+ *@brief:   查找缓存的图标，并更新命中/未命中计数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   key:缓存键
+ *@param:   found:返回是否命中
+ *@return:  QIcon:命中时返回缓存的图标，否则返回空图标
+ */
+QIcon BaseIconCache::cachedIcon(const QString &key, bool *found)
+{
+    QIcon *icon = iconCache.object(key);//object()会将该项标记为最近使用
+    *found = (icon != NULL);
+    if(icon != NULL)
+    {
+        hits++;
+        return *icon;
+    }
+    misses++;
+    return QIcon();
+}
+/*
+ *@brief:   将图标放入缓存，超出预算时QCache会自动淘汰最久未使用的项
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   key:缓存键
+ *@param:   icon:图标
+ *@param:   costKb:图标占用内存 KB
+ */
+void BaseIconCache::insertIcon(const QString &key, const QIcon &icon, int costKb)
+{
+    //调用者保证只放入加载成功的图标(失败的不缓存，图标文件之后出现时可以重新加载)
+    iconCache.insert(key,new QIcon(icon),qMax(costKb,1));
+}
+/*
+ *@brief:   计算图片占用的内存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   pixmap:图片
+ *@return:  int:占用内存 KB
+ */
+int BaseIconCache::pixmapCostKb(const QPixmap &pixmap)
+{
+    if(pixmap.isNull())
+    {
+        return 0;
+    }
+    qint64 bytes = qint64(pixmap.width())*pixmap.height()*pixmap.depth()/8;
+    return qMax(int(bytes/1024),1);
+}
@@ -0,0 +1,78 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮图标缓存(进程内共享)
+ *
+ * 1.BaseToolButton::setBtnIcon()/setBtnIcons()每次调用都会从磁盘解码图标文件，scaledUp时还要再
+ * 做一次平滑缩放。界面中大量按钮往往复用同一批图标，所以这里提供一个进程内共享的缓存，以(路径,请求尺寸,
+ * scaledUp,状态)为键缓存已经解码(缩放)好的QIcon，相同配置的按钮共享同一份图标数据。
+ * 2.缓存基于QCache实现，以KB为单位计算开销，超出内存预算时按LRU淘汰最久未使用的图标。
+ * 3.提供命中/未命中计数，方便评估缓存效果。
+ * 4.异步加载(BaseIconLoader)在工作线程解码后，通过insertPixmap()/insertPixmaps()将结果放入该缓存。
+ * 加载失败的图标不缓存，图标文件之后出现(或修复)时再次设置即可重新加载。
+ * 5.缓存单例的父对象为应用程序对象，缓存的图片随应用程序一起释放(在平台插件卸载之前)，不会在
+ * QApplication析构之后才析构。
+ * 注:QPixmap只能在GUI线程使用，所以该缓存也只能在GUI线程访问。
+ */
+#ifndef BASEICONCACHE_H
+#define BASEICONCACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QIcon>
+#include <QPixmap>
+
+class BaseIconCache : public QObject
+{
+    Q_OBJECT
+public:
+    static BaseIconCache *instance();
+
+    //获取(缓存的)单状态图标和多状态图标
+    QIcon icon(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    QIcon icons(const QString &normalIcon,const QString &checkedIcon,
+                const QString &disabledIcon,QSize iconSize);
+    //只查找不解码，以及放入已解码的图片(供异步加载使用)
+    bool findIcon(const QString &iconUrl,QSize iconSize,bool scaledUp,QIcon *icon);
+    bool findIcons(const QString &normalIcon,const QString &checkedIcon,
+                   const QString &disabledIcon,QSize iconSize,QIcon *icon);
+    QIcon insertPixmap(const QString &iconUrl,QSize iconSize,bool scaledUp,const QPixmap &pixmap);
+    QIcon insertPixmaps(const QString &normalIcon,const QString &checkedIcon,
+                        const QString &disabledIcon,QSize iconSize,const QPixmap &normalPixmap,
+                        const QPixmap &checkedPixmap,const QPixmap &disabledPixmap);
+
+    //设置/获取缓存的内存预算 KB
+    void setCacheLimit(int cacheLimitKb){iconCache.setMaxCost(cacheLimitKb);}
+    int cacheLimit(){return iconCache.maxCost();}
+    int cacheCost(){return iconCache.totalCost();}//当前缓存占用 KB
+    int cacheCount(){return iconCache.count();}//当前缓存的图标数
+    //命中/未命中计数
+    quint64 hitCount(){return hits;}
+    quint64 missCount(){return misses;}
+    void resetCounters(){hits = 0;misses = 0;}
+    void clear(){iconCache.clear();}
+
+private:
+    explicit BaseIconCache(QObject *parent);
+
+    static QString iconKey(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    static QString iconsKey(const QString &normalIcon,const QString &checkedIcon,
+                            const QString &disabledIcon,QSize iconSize);
+
+    QPixmap loadPixmap(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    QIcon cachedIcon(const QString &key,bool *found);
+    void insertIcon(const QString &key,const QIcon &icon,int costKb);
+    static int pixmapCostKb(const QPixmap &pixmap);
+
+    QCache<QString,QIcon> iconCache;//图标缓存 开销单位KB
+    quint64 hits;//命中次数
+    quint64 misses;//未命中次数
+};
+
+#endif // BASEICONCACHE_H
@@ -0,0 +1,395 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮图标异步加载(在工作线程解码)
+ */
+#include "baseiconloader.h"
+#include "baseiconcache.h"
+#include <QCoreApplication>
+#include <QRunnable>
+#include <QPointer>
+#include <QAbstractButton>
+
+#define ICON_BATCH_INTERVAL_MS 16 //统一应用解码结果的间隔(约一帧) ms
+
+static QPointer<BaseIconLoader> iconLoader;//加载器单例
+
+//在工作线程中执行的解码任务
+class BaseIconDecodeTask : public QRunnable
+{
+public:
+    BaseIconDecodeTask(QObject *loader,const QString &key,const QStringList &iconUrls,QSize iconSize,
+                       bool scaledUp,QSharedPointer<QAtomicInt> cancelFlag)
+        :loader(loader),key(key),iconUrls(iconUrls),iconSize(iconSize),scaledUp(scaledUp),
+          cancelFlag(cancelFlag)
+    {
+        setAutoDelete(true);
+    }
+
+    virtual void run()
+    {
+        //开始解码前检查是否已被取消
+        if(cancelFlag->loadAcquire() != 0)
+        {
+            return;
+        }
+        QImage images[3];
+        for(int i=0;i<iconUrls.size() && i<3;i++)
+        {
+            images[i] = decodeImage(iconUrls.at(i));
+        }
+        QMetaObject::invokeMethod(loader,"decodeFinishedSlot",Qt::QueuedConnection,
+                                  Q_ARG(QString,key),Q_ARG(QImage,images[0]),
+                                  Q_ARG(QImage,images[1]),Q_ARG(QImage,images[2]));
+    }
+
+private:
+    QImage decodeImage(const QString &iconUrl)
+    {
+        if(iconUrl.isEmpty())
+        {
+            return QImage();
+        }
+        QImage image(iconUrl);
+        if(scaledUp && !image.isNull())
+        {
+            image = image.scaled(iconSize,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+        }
+        //预乘格式转换为QPixmap时最快
+        if(!image.isNull())
+        {
+            image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        }
+        return image;
+    }
+
+    QObject *loader;//加载器(随应用程序析构，析构前线程池会等待所有任务结束)
+    QString key;
+    QStringList iconUrls;
+    QSize iconSize;
+    bool scaledUp;
+    QSharedPointer<QAtomicInt> cancelFlag;
+};
+
+/*
+ *@brief:   获取加载器单例(父对象为应用程序对象，随应用程序一起析构)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseIconLoader*:加载器单例指针
+ */
+BaseIconLoader *BaseIconLoader::instance()
+{
+    if(iconLoader.isNull())
+    {
+        iconLoader = new BaseIconLoader(QCoreApplication::instance());
+    }
+    return iconLoader.data();
+}
+/*
+ *@brief:   取消按钮的异步请求，加载器还不存在时直接返回(同步设置图标时调用，避免无谓地创建加载器)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   button:按钮
+ */
+void BaseIconLoader::cancelRequest(QObject *button)
+{
+    if(!iconLoader.isNull())
+    {
+        iconLoader->cancel(button);
+    }
+}
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseIconLoader::BaseIconLoader(QObject *parent)
+    :QObject(parent)
+{
+    batchTimer = new QTimer(this);
+    batchTimer->setSingleShot(true);
+    batchTimer->setInterval(ICON_BATCH_INTERVAL_MS);
+    connect(batchTimer,SIGNAL(timeout()),this,SLOT(applyBatchSlot()));
+}
+/*
+ *@brief:   析构函数  清除未开始的任务并等待正在执行的任务结束
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseIconLoader::~BaseIconLoader()
+{
+    decodePool.clear();
+    decodePool.waitForDone();
+}
+/*
+ *@brief:   请求异步加载按钮图标，缓存命中时同步设置；相同图标的请求合并为一次解码
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   button:按钮(QAbstractButton的子类)，同一按钮新的请求会替换之前未完成的请求
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否将图标放大(缩放)到iconSize
+ */
+void BaseIconLoader::requestIcon(QObject *button, const QString &iconUrl, QSize iconSize,
+                                 bool scaledUp)
+{
+    QAbstractButton *abstractButton = qobject_cast<QAbstractButton *>(button);
+    if(abstractButton == NULL)
+    {
+        return;
+    }
+    cancel(button);
+    QIcon icon;
+    if(BaseIconCache::instance()->findIcon(iconUrl,iconSize,scaledUp,&icon))
+    {
+        abstractButton->setIcon(icon);
+        return;
+    }
+
+    QString key = decodeKey(iconUrl,iconSize,scaledUp);
+    startDecode(key,QStringList()<<iconUrl,iconSize,scaledUp,false);
+    addWaiter(button,key);
+}
+/*
+ *@brief:   请求异步加载按钮的多状态图标(同setBtnIcons()，不缩放)，缓存命中时同步设置
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   button:按钮(QAbstractButton的子类)，同一按钮新的请求会替换之前未完成的请求
+ *@param:   normalIcon:正常状态图标路径
+ *@param:   checkedIcon:选中状态图标路径
+ *@param:   disabledIcon:禁用状态图标路径
+ *@param:   iconSize:图标尺寸
+ */
+void BaseIconLoader::requestIcons(QObject *button, const QString &normalIcon,
+                                  const QString &checkedIcon, const QString &disabledIcon,
+                                  QSize iconSize)
+{
+    QAbstractButton *abstractButton = qobject_cast<QAbstractButton *>(button);
+    if(abstractButton == NULL)
+    {
+        return;
+    }
+    cancel(button);
+    QIcon icon;
+    if(BaseIconCache::instance()->findIcons(normalIcon,checkedIcon,disabledIcon,iconSize,&icon))
+    {
+        abstractButton->setIcon(icon);
+        return;
+    }
+
+    QString key = decodeIconsKey(normalIcon,checkedIcon,disabledIcon,iconSize);
+    startDecode(key,QStringList()<<normalIcon<<checkedIcon<<disabledIcon,iconSize,false,false);
+    addWaiter(button,key);
+}
+/*
+ *@brief:   预加载图标到BaseIconCache，之后同步或异步设置该图标时直接命中缓存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否将图标放大(缩放)到iconSize
+ */
+void BaseIconLoader::prewarmIcon(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    QIcon icon;
+    if(BaseIconCache::instance()->findIcon(iconUrl,iconSize,scaledUp,&icon))
+    {
+        return;
+    }
+    startDecode(decodeKey(iconUrl,iconSize,scaledUp),QStringList()<<iconUrl,iconSize,scaledUp,true);
+}
+/*
+ *@brief:   取消按钮未完成的请求，解码请求没有等待者(且不是预加载)时取消解码任务
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   button:按钮
+ */
+void BaseIconLoader::cancel(QObject *button)
+{
+    QHash<QObject *,QString>::iterator waiterIt = waiterHash.find(button);
+    if(waiterIt == waiterHash.end())
+    {
+        return;
+    }
+    QString key = waiterIt.value();
+    waiterHash.erase(waiterIt);
+    QHash<QString,PendingDecode>::iterator pendingIt = pendingHash.find(key);
+    if(pendingIt == pendingHash.end())
+    {
+        return;
+    }
+    pendingIt->waiters.removeAll(button);
+    if(pendingIt->waiters.isEmpty() && !pendingIt->prewarm)
+    {
+        pendingIt->cancelFlag->storeRelease(1);
+        pendingHash.erase(pendingIt);
+    }
+}
+/*
+ *@brief:   生成解码请求的合并键
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否缩放
+ *@return:  QString:合并键
+ */
+QString BaseIconLoader::decodeKey(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    //不缩放时解码结果与请求尺寸无关
+    QSize keySize = scaledUp?iconSize:QSize();
+    return iconUrl+QString("|%1x%2|%3").arg(keySize.width()).arg(keySize.height()).arg(scaledUp?1:0);
+}
+/*
+ *@brief:   生成多状态解码请求的合并键
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   normalIcon:正常状态图标路径
+ *@param:   checkedIcon:选中状态图标路径
+ *@param:   disabledIcon:禁用状态图标路径
+ *@param:   iconSize:图标尺寸
+ *@return:  QString:合并键
+ */
+QString BaseIconLoader::decodeIconsKey(const QString &normalIcon, const QString &checkedIcon,
+                                       const QString &disabledIcon, QSize iconSize)
+{
+    //以"icons|"开头与单状态的键区分
+    return QString("icons|")+normalIcon+QChar('|')+checkedIcon+QChar('|')+disabledIcon
+            +QString("|%1x%2").arg(iconSize.width()).arg(iconSize.height());
+}
+/*
+ *@brief:   开始解码，已有相同的解码请求时直接合并
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   key:合并键
+ *@param:   iconUrls:图标路径(单状态1个，多状态3个)
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否缩放
+ *@param:   prewarm:是否为预加载
+ */
+void BaseIconLoader::startDecode(const QString &key, const QStringList &iconUrls, QSize iconSize,
+                                 bool scaledUp, bool prewarm)
+{
+    QHash<QString,PendingDecode>::iterator it = pendingHash.find(key);
+    if(it != pendingHash.end())
+    {
+        it->prewarm = it->prewarm || prewarm;
+        return;
+    }
+    PendingDecode pending;
+    pending.iconUrls = iconUrls;
+    pending.iconSize = iconSize;
+    pending.scaledUp = scaledUp;
+    pending.prewarm = prewarm;
+    pending.cancelFlag = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+    pendingHash.insert(key,pending);
+    decodePool.start(new BaseIconDecodeTask(this,key,iconUrls,iconSize,scaledUp,pending.cancelFlag));
+}
+/*
+ *@brief:   将按钮加入解码请求的等待者，按钮析构时自动取消
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   button:按钮
+ *@param:   key:合并键
+ */
+void BaseIconLoader::addWaiter(QObject *button, const QString &key)
+{
+    pendingHash[key].waiters.append(button);
+    waiterHash.insert(button,key);
+    connect(button,SIGNAL(destroyed(QObject*)),this,SLOT(waiterDestroyedSlot(QObject*)),
+            Qt::UniqueConnection);
+}
+/*
+ *@brief:   解码完成的响应槽(GUI线程)，暂存结果并在下一帧统一应用
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   key:合并键
+ *@param:   normalImage:解码结果(单状态图标只有该结果)
+ *@param:   checkedImage:选中状态的解码结果
+ *@param:   disabledImage:禁用状态的解码结果
+ */
+void BaseIconLoader::decodeFinishedSlot(const QString &key, const QImage &normalImage,
+                                        const QImage &checkedImage, const QImage &disabledImage)
+{
+    DecodedIcon decoded;
+    decoded.key = key;
+    decoded.images[0] = normalImage;
+    decoded.images[1] = checkedImage;
+    decoded.images[2] = disabledImage;
+    decodedList.append(decoded);
+    if(!batchTimer->isActive())
+    {
+        batchTimer->start();
+    }
+}
+/*
+ *@brief:   统一应用一批解码结果:转换为QPixmap、放入图标缓存并设置到等待的按钮上
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseIconLoader::applyBatchSlot()
+{
+    QList<DecodedIcon> batchList;
+    batchList.swap(decodedList);
+    int appliedCount = 0;
+    for(int i=0;i<batchList.size();i++)
+    {
+        //已取消的解码(或已被之前的相同结果处理)直接丢弃
+        QHash<QString,PendingDecode>::iterator it = pendingHash.find(batchList.at(i).key);
+        if(it == pendingHash.end())
+        {
+            continue;
+        }
+        PendingDecode pending = it.value();
+        pendingHash.erase(it);
+
+        //解码失败(图片为空)的图标不会放入缓存
+        const DecodedIcon &decoded = batchList.at(i);
+        QIcon icon;
+        if(pending.iconUrls.size() == 1)
+        {
+            icon = BaseIconCache::instance()->insertPixmap(
+                        pending.iconUrls.at(0),pending.iconSize,pending.scaledUp,
+                        QPixmap::fromImage(decoded.images[0]));
+        }
+        else
+        {
+            icon = BaseIconCache::instance()->insertPixmaps(
+                        pending.iconUrls.at(0),pending.iconUrls.at(1),pending.iconUrls.at(2),
+                        pending.iconSize,QPixmap::fromImage(decoded.images[0]),
+                        QPixmap::fromImage(decoded.images[1]),QPixmap::fromImage(decoded.images[2]));
+        }
+        for(int j=0;j<pending.waiters.size();j++)
+        {
+            QObject *button = pending.waiters.at(j);
+            waiterHash.remove(button);
+            QAbstractButton *abstractButton = qobject_cast<QAbstractButton *>(button);
+            if(abstractButton != NULL)
+            {
+                abstractButton->setIcon(icon);
+            }
+        }
+        appliedCount++;
+    }
+    if(appliedCount > 0)
+    {
+        emit iconsApplied(appliedCount);
+    }
+}
+/*
+ *@brief:   按钮析构时取消其请求
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   button:按钮
+ */
+void BaseIconLoader::waiterDestroyedSlot(QObject *button)
+{
+    cancel(button);
+}
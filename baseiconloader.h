@@ -0,0 +1,99 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮图标异步加载(在工作线程解码)
+ *
+ * 1.setBtnIcon()/setBtnIcons()在GUI线程同步解码图标文件，一次构建几十个图标按钮时会明显阻塞首帧。
+ * 该类在线程池(QThreadPool)中将图标解码(缩放)为QImage，按钮在此期间显示占位图标(或空图标)。
+ * 2.工作线程的结果投递回GUI线程后先暂存，每帧(约16ms)统一转换为QPixmap、放入BaseIconCache并设置
+ * 到等待的按钮上；同一帧内各按钮的update()请求由Qt合并为一次重绘。
+ * 3.相同(路径,尺寸,scaledUp)的请求会合并为一次解码；按钮在解码完成前析构或重新设置了图标时，其请求
+ * 自动取消，没有等待者的解码任务在开始前会被跳过。
+ * 4.多状态图标(正常/选中/禁用)作为一个请求在同一个任务中解码，结果组合后放入BaseIconCache，与同步的
+ * setBtnIcons()共享缓存。解码失败的图标不放入缓存，之后再次请求时重新解码。
+ * 注:该类只能在GUI(主)线程调用。
+ */
+#ifndef BASEICONLOADER_H
+#define BASEICONLOADER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include <QTimer>
+#include <QImage>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QSize>
+
+class BaseIconLoader : public QObject
+{
+    Q_OBJECT
+public:
+    static BaseIconLoader *instance();
+    ~BaseIconLoader();
+    static void cancelRequest(QObject *button);//取消按钮的请求(加载器不存在时不会创建)
+
+    //请求异步加载按钮图标，按钮需要是QAbstractButton的子类
+    void requestIcon(QObject *button,const QString &iconUrl,QSize iconSize,bool scaledUp);
+    void requestIcons(QObject *button,const QString &normalIcon,const QString &checkedIcon,
+                      const QString &disabledIcon,QSize iconSize);
+    //预加载图标到BaseIconCache(不关联按钮)
+    void prewarmIcon(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    void cancel(QObject *button);
+
+    //设置/获取解码线程数
+    void setMaxThreadCount(int maxThreadCount){decodePool.setMaxThreadCount(maxThreadCount);}
+    int getMaxThreadCount(){return decodePool.maxThreadCount();}
+    int pendingCount(){return pendingHash.size();}//未完成的解码数
+
+private:
+    //一次(合并后的)解码请求
+    struct PendingDecode
+    {
+        QStringList iconUrls;//单状态只有1个路径，多状态依次为正常/选中/禁用状态的路径(可以为空)
+        QSize iconSize;
+        bool scaledUp;
+        bool prewarm;//是否为预加载(没有等待的按钮也不取消)
+        QList<QObject *> waiters;//等待该图标的按钮
+        QSharedPointer<QAtomicInt> cancelFlag;//取消标记 由解码任务检查
+    };
+    //解码完成的结果
+    struct DecodedIcon
+    {
+        QString key;
+        QImage images[3];//与PendingDecode::iconUrls对应
+    };
+
+    explicit BaseIconLoader(QObject *parent=0);
+    static QString decodeKey(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    static QString decodeIconsKey(const QString &normalIcon,const QString &checkedIcon,
+                                  const QString &disabledIcon,QSize iconSize);
+    void startDecode(const QString &key,const QStringList &iconUrls,QSize iconSize,bool scaledUp,
+                     bool prewarm);
+    void addWaiter(QObject *button,const QString &key);
+
+    QThreadPool decodePool;//解码线程池
+    QHash<QString,PendingDecode> pendingHash;//解码键->未完成的解码请求
+    QHash<QObject *,QString> waiterHash;//按钮->等待的解码键
+    QList<DecodedIcon> decodedList;//等待统一应用的解码结果
+    QTimer *batchTimer;//每帧统一应用结果的定时器
+
+signals:
+    void iconsApplied(int count);//一批结果应用完成，参数为本批次的图标数
+
+private slots:
+    void decodeFinishedSlot(const QString &key,const QImage &normalImage,const QImage &checkedImage,
+                            const QImage &disabledImage);
+    void applyBatchSlot();
+    void waiterDestroyedSlot(QObject *button);
+};
+
+#endif // BASEICONLOADER_H
@@ -0,0 +1,658 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮输入的录制与回放
+ */
+#include "baseinputrecorder.h"
+#include "basetimerwheel.h"
+#include <QFile>
+#include <QMouseEvent>
+#include <QTouchEvent>
+
+#define INPUT_RECORD_MAGIC "BBIR" //录制数据的文件标识
+#define INPUT_RECORD_VERSION 2 //录制数据的格式版本
+#define INPUT_RECORD_TYPE_BITS 3 //事件中类型所占的位数
+#define INPUT_REPLAY_TAIL_MS 5000 //默认在最后一个事件之后推进的时间 ms
+#define FNV_OFFSET_BASIS Q_UINT64_C(14695981039346656037)
+#define FNV_PRIME Q_UINT64_C(1099511628211)
+
+/*
+ *@brief:   追加一个无符号变长整数(每字节7位，低位在前，最高位表示后面还有字节)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   data:数据
+ *@param:   value:整数
+ */
+static void appendVarint(QByteArray &data, quint64 value)
+{
+    while(value >= 0x80)
+    {
+        data.append(char((value & 0x7F)|0x80));
+        value >>= 7;
+    }
+    data.append(char(value));
+}
+/*
+ *@brief:   读取一个无符号变长整数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   data:数据
+ *@param:   offset:读取位置 读取后指向下一个字节
+ *@param:   value:返回的整数
+ *@return:  bool:是否读取成功(数据不完整或超过64位时失败)
+ */
+static bool readVarint(const QByteArray &data, int *offset, quint64 *value)
+{
+    quint64 result = 0;
+    for(int shift=0;shift<64;shift+=7)
+    {
+        if(*offset >= data.size())
+        {
+            return false;
+        }
+        uchar byte = uchar(data.at((*offset)++));
+        result |= quint64(byte & 0x7F) << shift;
+        if(!(byte & 0x80))
+        {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+/*
+ *@brief:   获取按钮的录制名称
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ *@return:  QString:btnName，为空时为对象名
+ */
+static QString recordName(BaseToolButton *btn)
+{
+    QString btnName = btn->getBtnName();
+    return btnName.isEmpty()?btn->objectName():btnName;
+}
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseInputRecorder::BaseInputRecorder(QObject *parent)
+    :QObject(parent)
+{
+    lastTimestampMs = 0;
+    events = 0;
+}
+/*
+ *@brief:   添加录制的按钮 通过事件过滤器录制按钮收到的按下/释放事件
+ * 注:使能触摸(setBtnTouchEnabled)的按钮录制触摸事件，其他按钮录制鼠标左键事件。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ */
+void BaseInputRecorder::addButton(BaseToolButton *btn)
+{
+    if(btn == NULL || buttonHash.contains(btn))
+    {
+        return;
+    }
+    QString btnName = recordName(btn);
+    buttonIndex(btnName);
+    buttonHash.insert(btn,btnName);
+    btn->installEventFilter(this);
+}
+/*
+ *@brief:   移除录制的按钮 已录制的事件保留
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ */
+void BaseInputRecorder::removeButton(BaseToolButton *btn)
+{
+    if(buttonHash.remove(btn) > 0)
+    {
+        btn->removeEventFilter(this);
+    }
+    pressInsideHash.remove(btn);
+}
+/*
+ *@brief:   追加事件 时间戳早于上一个事件时按上一个事件的时间戳记录
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btnName:按钮名称
+ *@param:   type:事件类型
+ *@param:   timestampMs:时间戳 ms
+ */
+void BaseInputRecorder::appendEvent(const QString &btnName, EventType type, qint64 timestampMs)
+{
+    //第一个事件记录绝对时间戳，之后记录与上一个事件的差值
+    qint64 deltaMs = (events == 0)?qMax(timestampMs,qint64(0)):qMax(timestampMs-lastTimestampMs,qint64(0));
+    appendVarint(eventData,(quint64(buttonIndex(btnName)) << INPUT_RECORD_TYPE_BITS)|uint(type));
+    appendVarint(eventData,quint64(deltaMs));
+    lastTimestampMs = (events == 0)?deltaMs:lastTimestampMs+deltaMs;
+    events++;
+}
+/*
+ *@brief:   获取录制结果
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  QByteArray:二进制格式的录制数据
+ */
+QByteArray BaseInputRecorder::data()
+{
+    QByteArray recordData(INPUT_RECORD_MAGIC);
+    recordData.append(char(INPUT_RECORD_VERSION));
+    appendVarint(recordData,quint64(buttonNames.size()));
+    for(int i=0;i<buttonNames.size();i++)
+    {
+        QByteArray name = buttonNames.at(i).toUtf8();
+        appendVarint(recordData,quint64(name.size()));
+        recordData.append(name);
+    }
+    recordData.append(eventData);
+    return recordData;
+}
+/*
+ *@brief:   保存录制结果到文件
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   fileName:文件名
+ *@return:  bool:是否保存成功
+ */
+bool BaseInputRecorder::save(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        qWarning("BaseInputRecorder::save: cannot open %s",qPrintable(fileName));
+        return false;
+    }
+    QByteArray recordData = data();
+    return file.write(recordData) == recordData.size();
+}
+/*
+ *@brief:   清空已录制的事件(录制的按钮及名称保持不变)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseInputRecorder::clear()
+{
+    eventData.clear();
+    lastTimestampMs = 0;
+    events = 0;
+}
+/*
+ *@brief:   事件过滤器 录制按钮的按下/释放事件(只记录，不拦截)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   watched:按钮
+ *@param:   event:事件
+ *@return:  bool:始终为false
+ */
+bool BaseInputRecorder::eventFilter(QObject *watched, QEvent *event)
+{
+    QHash<QObject *,QString>::const_iterator it = buttonHash.constFind(watched);
+    if(it == buttonHash.constEnd())
+    {
+        return QObject::eventFilter(watched,event);
+    }
+    BaseToolButton *btn = static_cast<BaseToolButton *>(watched);
+    if(!btn->isEnabled())
+    {
+        return false;
+    }
+    bool touchEnabled = btn->getBtnTouchEnabled();
+    QEvent::Type type = event->type();
+    if(touchEnabled && (type == QEvent::TouchBegin || type == QEvent::TouchUpdate ||
+                        type == QEvent::TouchEnd || type == QEvent::TouchCancel))
+    {
+        QTouchEvent *touchEvent = static_cast<QTouchEvent *>(event);
+        qint64 timestampMs = touchEvent->timestamp()?qint64(touchEvent->timestamp()):BaseTimerWheel::instance()->now();
+#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
+        QPointF localPos = touchEvent->points().isEmpty()?QPointF(-1,-1):
+                                                          touchEvent->points().first().position();
+#else
+        QPointF localPos = touchEvent->touchPoints().isEmpty()?QPointF(-1,-1):
+                                                               touchEvent->touchPoints().first().pos();
+#endif
+        if(type == QEvent::TouchBegin)
+        {
+            recordPress(btn,it.value(),timestampMs);
+        }
+        else if(type == QEvent::TouchUpdate)
+        {
+            recordMove(btn,it.value(),localPos.toPoint(),timestampMs);
+        }
+        else
+        {
+            recordRelease(btn,it.value(),(type == QEvent::TouchEnd)?localPos.toPoint():QPoint(-1,-1),timestampMs);
+        }
+    }
+    else if(!touchEnabled && (type == QEvent::MouseButtonPress || type == QEvent::MouseButtonRelease ||
+                              type == QEvent::MouseMove))
+    {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        qint64 timestampMs = mouseEvent->timestamp()?qint64(mouseEvent->timestamp()):BaseTimerWheel::instance()->now();
+        if(type == QEvent::MouseMove)
+        {
+            if(mouseEvent->buttons() & Qt::LeftButton)
+            {
+                recordMove(btn,it.value(),mouseEvent->pos(),timestampMs);
+            }
+        }
+        else if(mouseEvent->button() != Qt::LeftButton)
+        {
+            return false;
+        }
+        else if(type == QEvent::MouseButtonPress)
+        {
+            recordPress(btn,it.value(),timestampMs);
+        }
+        else
+        {
+            recordRelease(btn,it.value(),mouseEvent->pos(),timestampMs);
+        }
+    }
+    return false;
+}
+/*
+ *@brief:   录制按下 开始跟踪按钮内外的状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ *@param:   btnName:按钮名称
+ *@param:   timestampMs:时间戳 ms
+ */
+void BaseInputRecorder::recordPress(BaseToolButton *btn, const QString &btnName, qint64 timestampMs)
+{
+    pressInsideHash.insert(btn,true);
+    appendEvent(btnName,Press,timestampMs);
+}
+/*
+ *@brief:   录制按下期间的移动 只有移出(或移回)按钮时才记录，与QAbstractButton按hitButton()切换按下状态一致
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ *@param:   btnName:按钮名称
+ *@param:   pos:按钮坐标系中的位置
+ *@param:   timestampMs:时间戳 ms
+ */
+void BaseInputRecorder::recordMove(BaseToolButton *btn, const QString &btnName, const QPoint &pos,
+                                   qint64 timestampMs)
+{
+    QHash<QObject *,bool>::iterator it = pressInsideHash.find(btn);
+    if(it == pressInsideHash.end())
+    {
+        return;
+    }
+    bool inside = btn->rect().contains(pos);
+    if(inside != it.value())
+    {
+        it.value() = inside;
+        appendEvent(btnName,inside?Enter:Leave,timestampMs);
+    }
+}
+/*
+ *@brief:   录制释放 在按钮内且未移出按钮时为Release，否则为ReleaseOutside
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ *@param:   btnName:按钮名称
+ *@param:   pos:按钮坐标系中的位置
+ *@param:   timestampMs:时间戳 ms
+ */
+void BaseInputRecorder::recordRelease(BaseToolButton *btn, const QString &btnName, const QPoint &pos,
+                                      qint64 timestampMs)
+{
+    bool inside = pressInsideHash.take(btn) && btn->rect().contains(pos);
+    appendEvent(btnName,inside?Release:ReleaseOutside,timestampMs);
+}
+/*
+ *@brief:   获取按钮名称的序号 不存在时添加
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btnName:按钮名称
+ *@return:  int:序号
+ */
+int BaseInputRecorder::buttonIndex(const QString &btnName)
+{
+    int index = buttonNames.indexOf(btnName);
+    if(index < 0)
+    {
+        buttonNames.append(btnName);
+        index = buttonNames.size()-1;
+    }
+    return index;
+}
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseInputReplayer::BaseInputReplayer(QObject *parent)
+    :QObject(parent)
+{
+    eventOffset = -1;
+    readOffset = 0;
+    readTimestampMs = 0;
+    tailMs = INPUT_REPLAY_TAIL_MS;
+    replaying = false;
+    events = 0;
+    baseTimestampMs = 0;
+    endTimestampMs = 0;
+    hasPendingEvent = false;
+    pendingBtnIndex = 0;
+    pendingType = 0;
+    pendingTimestampMs = 0;
+    traceEnabled = true;
+    traceHashValue = FNV_OFFSET_BASIS;
+
+    realTimeTimer = new QTimer(this);
+    realTimeTimer->setTimerType(Qt::PreciseTimer);
+    realTimeTimer->setSingleShot(true);
+    connect(realTimeTimer,SIGNAL(timeout()),this,SLOT(realTimeSlot()));
+}
+/*
+ *@brief:   析构函数 回放中析构时恢复时间轮的单调时钟
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseInputReplayer::~BaseInputReplayer()
+{
+    if(replaying)
+    {
+        BaseTimerWheel::instance()->setVirtualClock(false);
+    }
+}
+/*
+ *@brief:   从文件加载录制数据
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   fileName:文件名
+ *@return:  bool:是否加载成功
+ */
+bool BaseInputReplayer::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        qWarning("BaseInputReplayer::load: cannot open %s",qPrintable(fileName));
+        return false;
+    }
+    return setData(file.readAll());
+}
+/*
+ *@brief:   设置录制数据 解析头部的按钮名称，事件在回放时逐个解析
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   data:录制数据
+ *@return:  bool:数据头部是否有效(回放中不能设置)
+ */
+bool BaseInputReplayer::setData(const QByteArray &data)
+{
+    if(replaying)
+    {
+        return false;
+    }
+    eventOffset = -1;
+    replayNames.clear();
+    int magicSize = int(sizeof(INPUT_RECORD_MAGIC))-1;
+    if(!data.startsWith(INPUT_RECORD_MAGIC) || data.size() <= magicSize ||
+            uchar(data.at(magicSize)) != INPUT_RECORD_VERSION)
+    {
+        qWarning("BaseInputReplayer::setData: invalid record header");
+        return false;
+    }
+    int offset = magicSize+1;
+    quint64 count = 0;
+    if(!readVarint(data,&offset,&count))
+    {
+        return false;
+    }
+    for(quint64 i=0;i<count;i++)
+    {
+        quint64 size = 0;
+        if(!readVarint(data,&offset,&size) || size > quint64(data.size()-offset))
+        {
+            replayNames.clear();
+            return false;
+        }
+        replayNames.append(QString::fromUtf8(data.constData()+offset,int(size)));
+        offset += int(size);
+    }
+    replayData = data;
+    eventOffset = offset;
+    return true;
+}
+/*
+ *@brief:   添加回放的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:按钮
+ */
+void BaseInputReplayer::addButton(BaseToolButton *btn)
+{
+    if(btn == NULL || replaying)
+    {
+        return;
+    }
+    buttonHash.insert(recordName(btn),btn);
+}
+/*
+ *@brief:   开始回放 时间轮切换到虚拟时钟，回放结束后恢复
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   speed:回放速度 最快速度时同步回放，返回时已结束；原速时异步回放，结束时发出finished()
+ *@return:  bool:是否开始回放(没有有效数据或正在回放时失败)
+ */
+bool BaseInputReplayer::replay(Speed speed)
+{
+    if(replaying || eventOffset < 0)
+    {
+        return false;
+    }
+    //按录制的按钮序号对应回放的按钮，每个事件直接按序号查找
+    replayButtons.clear();
+    for(int i=0;i<replayNames.size();i++)
+    {
+        replayButtons.append(buttonHash.value(replayNames.at(i),NULL));
+    }
+    QList<BaseToolButton *> buttons = buttonHash.values();
+    for(int i=0;i<buttons.size();i++)
+    {
+        connect(buttons.at(i),SIGNAL(clicked()),this,SLOT(traceClickedSlot()),Qt::UniqueConnection);
+        connect(buttons.at(i),SIGNAL(longPressSig(uint)),this,SLOT(traceLongPressSlot(uint)),
+                Qt::UniqueConnection);
+    }
+    readOffset = eventOffset;
+    readTimestampMs = 0;
+    events = 0;
+    traceData.clear();
+    traceHashValue = FNV_OFFSET_BASIS;
+    hasPendingEvent = readEvent(&pendingBtnIndex,&pendingType,&pendingTimestampMs);
+    baseTimestampMs = hasPendingEvent?pendingTimestampMs:0;
+    endTimestampMs = baseTimestampMs;
+    replaying = true;
+    BaseTimerWheel::instance()->setVirtualClock(true,baseTimestampMs);
+
+    if(speed == AsFastAsPossible)
+    {
+        while(hasPendingEvent)
+        {
+            BaseTimerWheel::instance()->advanceTo(pendingTimestampMs);
+            deliverEvent(pendingBtnIndex,pendingType,pendingTimestampMs);
+            endTimestampMs = pendingTimestampMs;
+            hasPendingEvent = readEvent(&pendingBtnIndex,&pendingType,&pendingTimestampMs);
+        }
+        BaseTimerWheel::instance()->advanceTo(endTimestampMs+tailMs);
+        finishReplay();
+    }
+    else
+    {
+        realTimeClock.start();
+        realTimeSlot();
+    }
+    return true;
+}
+/*
+ *@brief:   读取下一个事件
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btnIndex:返回的按钮序号
+ *@param:   type:返回的事件类型
+ *@param:   timestampMs:返回的时间戳 ms
+ *@return:  bool:是否读取到事件(数据结束或不完整时为false)
+ */
+bool BaseInputReplayer::readEvent(int *btnIndex, int *type, qint64 *timestampMs)
+{
+    quint64 key = 0;
+    quint64 deltaMs = 0;
+    if(!readVarint(replayData,&readOffset,&key) || !readVarint(replayData,&readOffset,&deltaMs))
+    {
+        return false;
+    }
+    *btnIndex = int(key >> INPUT_RECORD_TYPE_BITS);
+    *type = int(key & ((1u << INPUT_RECORD_TYPE_BITS)-1));
+    readTimestampMs += qint64(deltaMs);
+    *timestampMs = readTimestampMs;
+    return true;
+}
+/*
+ *@brief:   将事件投递到按钮 按下/释放以按钮中心位置及录制的时间戳构造鼠标事件，与外部输入的处理相同
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btnIndex:按钮序号
+ *@param:   type:事件类型
+ *@param:   timestampMs:时间戳 ms
+ */
+void BaseInputReplayer::deliverEvent(int btnIndex, int type, qint64 timestampMs)
+{
+    events++;
+    BaseToolButton *btn = replayButtons.value(btnIndex,NULL);
+    if(btn == NULL || !btn->isEnabled())
+    {
+        return;
+    }
+    switch(type)
+    {
+    case BaseInputRecorder::Press:
+        btn->externalPressBtn(ulong(timestampMs));
+        break;
+    case BaseInputRecorder::Release:
+        btn->externalReleaseBtn(ulong(timestampMs));
+        break;
+    case BaseInputRecorder::ReleaseOutside:
+        //移出按钮后按钮已不是按下状态，但仍需释放以结束这次按下
+        btn->releaseBtn();
+        break;
+    case BaseInputRecorder::Leave:
+        btn->externalMoveBtn(false,ulong(timestampMs));
+        break;
+    case BaseInputRecorder::Enter:
+        btn->externalMoveBtn(true,ulong(timestampMs));
+        break;
+    default:
+        break;
+    }
+}
+/*
+ *@brief:   追加一行轨迹 时刻相对第一个事件
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btn:发出信号的按钮
+ *@param:   line:轨迹内容(不含时刻和按钮名称)
+ */
+void BaseInputReplayer::appendTrace(BaseToolButton *btn, const QByteArray &line)
+{
+    QByteArray traceLine = QByteArray::number(BaseTimerWheel::instance()->now()-baseTimestampMs)+' '+
+            recordName(btn).toUtf8()+' '+line+'\n';
+    for(int i=0;i<traceLine.size();i++)
+    {
+        traceHashValue = (traceHashValue^uchar(traceLine.at(i)))*FNV_PRIME;
+    }
+    if(traceEnabled)
+    {
+        traceData.append(traceLine);
+    }
+}
+/*
+ *@brief:   结束回放 恢复时间轮的单调时钟
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseInputReplayer::finishReplay()
+{
+    realTimeTimer->stop();
+    replaying = false;
+    BaseTimerWheel::instance()->setVirtualClock(false);
+    QList<BaseToolButton *> buttons = buttonHash.values();
+    for(int i=0;i<buttons.size();i++)
+    {
+        disconnect(buttons.at(i),SIGNAL(clicked()),this,SLOT(traceClickedSlot()));
+        disconnect(buttons.at(i),SIGNAL(longPressSig(uint)),this,SLOT(traceLongPressSlot(uint)));
+    }
+    emit finished();
+}
+/*
+ *@brief:   原速回放的定时响应槽 按真实经过的时间推进虚拟时钟，投递已到时刻的事件
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseInputReplayer::realTimeSlot()
+{
+    qint64 targetMs = baseTimestampMs+realTimeClock.elapsed();
+    while(hasPendingEvent && pendingTimestampMs <= targetMs)
+    {
+        BaseTimerWheel::instance()->advanceTo(pendingTimestampMs);
+        deliverEvent(pendingBtnIndex,pendingType,pendingTimestampMs);
+        endTimestampMs = pendingTimestampMs;
+        hasPendingEvent = readEvent(&pendingBtnIndex,&pendingType,&pendingTimestampMs);
+    }
+    qint64 stopMs = hasPendingEvent?pendingTimestampMs:endTimestampMs+tailMs;
+    BaseTimerWheel::instance()->advanceTo(qMin(targetMs,stopMs));
+    if(!hasPendingEvent && targetMs >= stopMs)
+    {
+        finishReplay();
+        return;
+    }
+    //等到下一个事件或下一格时间轮到期(不超过一格分辨率)
+    qint64 waitMs = qMin(stopMs-targetMs,qint64(BaseTimerWheel::instance()->getResolution()));
+    realTimeTimer->start(int(qMax(waitMs,qint64(1))));
+}
+/*
+ *@brief:   记录按钮的clicked()信号
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseInputReplayer::traceClickedSlot()
+{
+    BaseToolButton *btn = qobject_cast<BaseToolButton *>(sender());
+    if(btn != NULL)
+    {
+        appendTrace(btn,"clicked");
+    }
+}
+/*
+ *@brief:   记录按钮的longPressSig()信号
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   longPressMs:长按时间 ms
+ */
+void BaseInputReplayer::traceLongPressSlot(uint longPressMs)
+{
+    BaseToolButton *btn = qobject_cast<BaseToolButton *>(sender());
+    if(btn != NULL)
+    {
+        appendTrace(btn,"longPress "+QByteArray::number(longPressMs));
+    }
+}
@@ -0,0 +1,152 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮输入的录制(BaseInputRecorder)与回放(BaseInputReplayer)
+ *
+ * 1.防抖和长按的时序问题往往只在现场快速或交叠的输入下出现，难以复现。BaseInputRecorder通过事件过滤器
+ * 录制按钮的按下/释放事件、按下期间移出/移回按钮的移动及其时间戳，保存为紧凑的二进制格式；BaseInputReplayer将其回放到按钮上，并记录
+ * 按钮发出的clicked()/longPressSig()序列(轨迹)，可以与事先保存的标准轨迹比较。
+ * 2.回放时时间轮(BaseTimerWheel)切换到虚拟时钟，每个事件前先将虚拟时钟推进到事件时间戳，防抖和长按定时
+ * 都只由录制的时间戳驱动，所以同一份录制的回放结果逐位相同。可以按原速(1x，按真实时间等待)或以最快速度
+ * (同步执行，不等待)回放，两者得到的轨迹相同，最快速度下可以无界面地回放上百万个事件。
+ * 3.二进制格式(小端变长整数varint):
+ *   头部:"BBIR" 版本(1字节) 按钮数(varint) 各按钮名称(varint长度+UTF-8)
+ *   事件:(按钮序号<<3|类型)(varint) 与上一个事件的时间差ms(varint，第一个事件为其时间戳)
+ *   类型:0=按下 1=在按钮内释放(会发出clicked) 2=在按钮外释放/取消(同releaseBtn()) 3=按下期间移出按钮
+ *   (发出released，停止长按) 4=按下期间移回按钮(重新按下)
+ *   常见的事件只占2~3个字节。只支持当前版本(2)的数据，其他版本的数据设置时返回false。
+ * 注:按钮以btnName区分，录制和回放的按钮名称应唯一。回放应使用新创建的按钮，保证防抖等状态从初始值开始。
+ */
+#ifndef BASEINPUTRECORDER_H
+#define BASEINPUTRECORDER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "basetoolbutton.h"
+
+class BaseInputRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    //事件类型
+    enum EventType
+    {
+        Press = 0,//按下
+        Release = 1,//在按钮内释放
+        ReleaseOutside = 2,//在按钮外释放或取消
+        Leave = 3,//按下期间移出按钮
+        Enter = 4//按下期间移回按钮
+    };
+
+    explicit BaseInputRecorder(QObject *parent=0);
+
+    //添加/移除录制的按钮 按钮名称为空时使用对象名
+    void addButton(BaseToolButton *btn);
+    void removeButton(BaseToolButton *btn);
+    //直接追加事件(可用于生成压力测试数据)
+    void appendEvent(const QString &btnName,EventType type,qint64 timestampMs);
+
+    QByteArray data();//录制结果(二进制格式)
+    bool save(const QString &fileName);
+    int eventCount(){return events;}
+    void clear();
+
+protected:
+    virtual bool eventFilter(QObject *watched,QEvent *event);
+
+private:
+    int buttonIndex(const QString &btnName);
+    void recordPress(BaseToolButton *btn,const QString &btnName,qint64 timestampMs);
+    void recordMove(BaseToolButton *btn,const QString &btnName,const QPoint &pos,qint64 timestampMs);
+    void recordRelease(BaseToolButton *btn,const QString &btnName,const QPoint &pos,qint64 timestampMs);
+
+    QHash<QObject *,QString> buttonHash;//录制的按钮->名称
+    QHash<QObject *,bool> pressInsideHash;//按下中的按钮->当前是否在按钮内
+    QStringList buttonNames;//按钮名称 序号即事件中的按钮序号
+    QByteArray eventData;//事件部分的数据
+    qint64 lastTimestampMs;//上一个事件的时间戳 ms
+    int events;//事件数
+};
+
+class BaseInputReplayer : public QObject
+{
+    Q_OBJECT
+public:
+    //回放速度
+    enum Speed
+    {
+        RealTime = 0,//原速(1x) 异步回放，结束时发出finished()
+        AsFastAsPossible//最快速度 同步回放，返回时已结束
+    };
+
+    explicit BaseInputReplayer(QObject *parent=0);
+    ~BaseInputReplayer();
+
+    //加载录制数据
+    bool load(const QString &fileName);
+    bool setData(const QByteArray &data);
+    //添加回放的按钮(按btnName与录制的按钮对应，名称为空时使用对象名)
+    void addButton(BaseToolButton *btn);
+    //设置最后一个事件之后继续推进虚拟时钟的时间 ms(让未结束的长按等定时走完)
+    void setTailMs(uint tailMs){this->tailMs = tailMs;}
+
+    bool replay(Speed speed = AsFastAsPossible);
+    bool isReplaying(){return replaying;}
+    int eventCount(){return events;}//已回放的事件数
+
+    //回放轨迹 每行为"时刻 按钮名称 clicked"或"时刻 按钮名称 longPress 长按时间"，时刻相对第一个事件
+    void setTraceEnabled(bool traceEnabled){this->traceEnabled = traceEnabled;}
+    QByteArray trace(){return traceData;}
+    quint64 traceHash(){return traceHashValue;}//轨迹的FNV-1a哈希(未保存轨迹文本时同样计算)
+
+private:
+    bool readEvent(int *btnIndex,int *type,qint64 *timestampMs);
+    void deliverEvent(int btnIndex,int type,qint64 timestampMs);
+    void appendTrace(BaseToolButton *btn,const QByteArray &line);
+    void finishReplay();
+
+    QByteArray replayData;//录制数据
+    int eventOffset;//事件部分的起始位置
+    int readOffset;//当前读取位置
+    qint64 readTimestampMs;//上一个读取的事件时间戳 ms
+    QList<BaseToolButton *> replayButtons;//事件中的按钮序号->回放的按钮 没有对应按钮时为NULL
+    QStringList replayNames;//录制的按钮名称
+    QHash<QString,BaseToolButton *> buttonHash;//按钮名称->回放的按钮
+    uint tailMs;//最后一个事件之后推进的时间 ms
+    bool replaying;//是否正在回放
+    int events;//已回放的事件数
+    qint64 baseTimestampMs;//第一个事件的时间戳 ms
+    qint64 endTimestampMs;//回放结束的时刻 ms(最后一个事件+tailMs)
+    //原速回放
+    QTimer *realTimeTimer;//推进虚拟时钟的定时器
+    QElapsedTimer realTimeClock;//回放开始后经过的真实时间
+    bool hasPendingEvent;//是否有已读取但还未投递的事件
+    int pendingBtnIndex;
+    int pendingType;
+    qint64 pendingTimestampMs;
+    //轨迹
+    bool traceEnabled;//是否保存轨迹文本 默认保存
+    QByteArray traceData;//轨迹文本
+    quint64 traceHashValue;//轨迹哈希
+
+signals:
+    void finished();//回放结束
+
+private slots:
+    void realTimeSlot();
+    void traceClickedSlot();
+    void traceLongPressSlot(uint longPressMs);
+};
+
+#endif // BASEINPUTRECORDER_H
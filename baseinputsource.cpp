@@ -0,0 +1,551 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  外部按键输入源(后台线程读取，映射到按钮)
+ */
+#include "baseinputsource.h"
+#include <QThread>
+#include <QApplication>
+#include <QFile>
+#include <QDebug>
+#include <string.h>
+#ifdef Q_OS_UNIX
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+#ifdef Q_OS_LINUX
+#include <linux/input.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#endif
+
+#define INPUT_READ_BUFFER_SIZE 1024 //单次读取的缓冲区大小
+#define INPUT_KEY_CODE_COUNT 65536 //按键码的个数(quint16)
+
+//后台读取线程:poll()等待事件源和唤醒管道，解析后放入环形队列
+class BaseInputReader : public QThread
+{
+public:
+    BaseInputReader(BaseInputSource *source,int fd,bool ownFd,BaseInputSource::Format format)
+        :source(source),fd(fd),ownFd(ownFd),format(format),evdevMonotonic(false),evdevDropping(false),
+          heldCount(0)
+    {
+        wakePipe[0] = -1;
+        wakePipe[1] = -1;
+        memset(heldKeys,0,sizeof(heldKeys));
+    }
+    ~BaseInputReader()
+    {
+#ifdef Q_OS_UNIX
+        if(wakePipe[0] >= 0)
+        {
+            ::close(wakePipe[0]);
+            ::close(wakePipe[1]);
+        }
+        if(ownFd)
+        {
+            ::close(fd);
+        }
+#endif
+    }
+
+    //创建唤醒管道 evdev设备切换为单调时钟的事件时间(内核默认为CLOCK_REALTIME)
+    bool init()
+    {
+#ifdef Q_OS_LINUX
+        if(format == BaseInputSource::EvdevFormat)
+        {
+            int clockId = CLOCK_MONOTONIC;
+            evdevMonotonic = (::ioctl(fd,EVIOCSCLOCKID,&clockId) == 0);
+        }
+#endif
+#ifdef Q_OS_UNIX
+        return (::pipe(wakePipe) == 0);
+#else
+        return false;
+#endif
+    }
+    //唤醒读取线程使其退出
+    void wake()
+    {
+#ifdef Q_OS_UNIX
+        char wakeByte = 1;
+        while(::write(wakePipe[1],&wakeByte,1) < 0 && errno == EINTR)
+        {
+        }
+#endif
+    }
+
+protected:
+    virtual void run()
+    {
+#ifdef Q_OS_UNIX
+        int recordSize = recordBytes();
+        if(recordSize <= 0)
+        {
+            return;
+        }
+        char buffer[INPUT_READ_BUFFER_SIZE];
+        int bufferedBytes = 0;//不足一个事件的剩余字节
+        struct pollfd pollFds[2];
+        pollFds[0].fd = fd;
+        pollFds[0].events = POLLIN;
+        pollFds[1].fd = wakePipe[0];
+        pollFds[1].events = POLLIN;
+        forever
+        {
+            pollFds[0].revents = 0;
+            pollFds[1].revents = 0;
+            if(::poll(pollFds,2,-1) < 0)
+            {
+                if(errno == EINTR)
+                {
+                    continue;
+                }
+                break;
+            }
+            if(pollFds[1].revents != 0)//停止
+            {
+                break;
+            }
+            if(pollFds[0].revents & POLLNVAL)
+            {
+                break;
+            }
+            ssize_t readBytes = ::read(fd,buffer+bufferedBytes,
+                                       sizeof(buffer)-bufferedBytes);
+            if(readBytes < 0)
+            {
+                if(errno == EINTR || errno == EAGAIN)
+                {
+                    continue;
+                }
+                break;
+            }
+            if(readBytes == 0)//事件源关闭
+            {
+                break;
+            }
+            bufferedBytes += int(readBytes);
+            int offset = 0;
+            while(bufferedBytes-offset >= recordSize)
+            {
+                parseRecord(buffer+offset);
+                offset += recordSize;
+            }
+            bufferedBytes -= offset;
+            if(bufferedBytes > 0)
+            {
+                memmove(buffer,buffer+offset,bufferedBytes);
+            }
+        }
+#endif
+    }
+
+private:
+    //每个事件的字节数
+    int recordBytes()
+    {
+        if(format == BaseInputSource::RawFormat)
+        {
+            return 4;
+        }
+#ifdef Q_OS_LINUX
+        return int(sizeof(struct input_event));
+#else
+        return 0;
+#endif
+    }
+    //解析一个事件并放入队列
+    void parseRecord(const char *record)
+    {
+        //Qt的输入事件时间戳(xcb/libinput/wayland)为CLOCK_MONOTONIC的ms，与QElapsedTimer的参考时刻相同
+        qint64 timestampMs = QElapsedTimer::msecsSinceReference();
+        if(format == BaseInputSource::RawFormat)
+        {
+            quint16 code;
+            memcpy(&code,record,sizeof(quint16));
+            pushKeyEvent(code,record[2] != 0,timestampMs,0);
+            return;
+        }
+#ifdef Q_OS_LINUX
+        struct input_event evdevEvent;
+        memcpy(&evdevEvent,record,sizeof(evdevEvent));
+        //使用内核记录的事件时刻，不包含事件在内核缓冲区和队列中等待的时间
+        if(evdevMonotonic)
+        {
+            timestampMs = qint64(evdevEvent.time.tv_sec)*1000+evdevEvent.time.tv_usec/1000;
+        }
+        if(evdevEvent.type == EV_SYN)
+        {
+            /*内核缓冲区溢出(SYN_DROPPED)后到下一个SYN_REPORT之间的事件不完整，全部丢弃，
+             * 到SYN_REPORT时读取设备当前的按键状态重新同步*/
+            if(evdevEvent.code == SYN_DROPPED)
+            {
+                evdevDropping = true;
+            }
+            else if(evdevEvent.code == SYN_REPORT && evdevDropping)
+            {
+                evdevDropping = false;
+                resyncKeys(timestampMs);
+            }
+            return;
+        }
+        //value:0释放 1按下 2自动重复(忽略，长按由按钮自身处理)
+        if(evdevDropping || evdevEvent.type != EV_KEY || evdevEvent.value > 1)
+        {
+            return;
+        }
+        pushKeyEvent(evdevEvent.code,evdevEvent.value == 1,timestampMs,0);
+#else
+        Q_UNUSED(record)
+#endif
+    }
+#ifdef Q_OS_LINUX
+    /*
+     *@brief:   evdev事件丢失后按设备当前的按键状态重新同步:已按下但设备上已抬起的按键补发释放(不产生
+     * 点击)，设备上按下但未记录的按键补发按下。读取按键状态失败时(如事件源不是evdev设备)释放所有按键。
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   timestampMs:同步时刻 ms
+     */
+    void resyncKeys(qint64 timestampMs)
+    {
+        quint8 keyBits[KEY_CNT/8+1];
+        memset(keyBits,0,sizeof(keyBits));
+        bool stateKnown = (::ioctl(fd,EVIOCGKEY(sizeof(keyBits)),keyBits) >= 0);
+        for(int code=0;code<KEY_CNT;code++)
+        {
+            bool deviceDown = stateKnown && (keyBits[code/8] & (1 << (code%8))) != 0;
+            if(isHeld(quint16(code)) && !deviceDown)
+            {
+                pushKeyEvent(quint16(code),false,timestampMs,INPUT_EVENT_RESYNC);
+            }
+            else if(!isHeld(quint16(code)) && deviceDown)
+            {
+                pushKeyEvent(quint16(code),true,timestampMs,INPUT_EVENT_RESYNC);
+            }
+        }
+    }
+#endif
+    bool isHeld(quint16 code){return (heldKeys[code/8] & (1 << (code%8))) != 0;}
+    /*
+     *@brief:   将一个按键事件放入队列
+     * 队列中始终为已按下的按键保留释放事件的位置:按下只有在放入后仍能容纳所有按下中按键的释放时才放入，
+     * 否则丢弃(计数)，所以已放入按下的按键的释放不会因队列满而丢失，按钮不会一直保持按下。按下被丢弃的
+     * 按键的释放与按下一起丢弃(对应的按钮未被按下)。
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   code:按键码
+     *@param:   pressed:是否按下
+     *@param:   timestampMs:事件时刻 ms
+     *@param:   flags:事件标记
+     */
+    void pushKeyEvent(quint16 code,bool pressed,qint64 timestampMs,quint8 flags)
+    {
+        BaseInputEvent inputEvent;
+        inputEvent.code = code;
+        inputEvent.pressed = pressed?1:0;
+        inputEvent.flags = flags;
+        //与Qt的ulong时间戳一样截断为32位，截断后为0时改为1(0表示无效，防抖会改用时间轮的时钟)
+        inputEvent.timestampMs = quint32(timestampMs);
+        if(inputEvent.timestampMs == 0)
+        {
+            inputEvent.timestampMs = 1;
+        }
+        bool held = isHeld(code);
+        if(pressed)
+        {
+            quint32 required = source->eventRing.size()+quint32(heldCount)+(held?1:2);
+            if(required > source->eventRing.capacity() || !source->eventRing.push(inputEvent))
+            {
+                source->droppedCount.fetchAndAddRelaxed(1);
+                return;
+            }
+            if(!held)
+            {
+                heldKeys[code/8] |= quint8(1 << (code%8));
+                heldCount++;
+            }
+        }
+        else
+        {
+            //按下已被丢弃(或在开始读取前按下)的按键，释放一并丢弃，不占用为其他按键保留的位置
+            if(!held)
+            {
+                return;
+            }
+            source->eventRing.push(inputEvent);//已保留位置，不会失败
+            heldKeys[code/8] &= quint8(~(1 << (code%8)));
+            heldCount--;
+        }
+        //队列由空变为非空(没有待处理的取出请求)时通知GUI线程
+        if(source->drainScheduled.testAndSetOrdered(0,1))
+        {
+            QMetaObject::invokeMethod(source,"drainSlot",Qt::QueuedConnection);
+        }
+    }
+
+    BaseInputSource *source;
+    int fd;//事件源
+    bool ownFd;//是否由读取线程关闭事件源
+    BaseInputSource::Format format;
+    bool evdevMonotonic;//evdev事件时间是否为CLOCK_MONOTONIC
+    bool evdevDropping;//evdev事件丢失(SYN_DROPPED)后等待SYN_REPORT重新同步
+    quint8 heldKeys[INPUT_KEY_CODE_COUNT/8];//已放入按下(尚未放入释放)的按键
+    int heldCount;//heldKeys中的按键数
+    int wakePipe[2];//唤醒管道(自管道)
+};
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ *@param:   ringCapacity:事件队列容量(向上取整为2的幂)
+ */
+BaseInputSource::BaseInputSource(QObject *parent, quint32 ringCapacity)
+    :QObject(parent),eventRing(qMax(ringCapacity,quint32(2))),drainScheduled(0),droppedCount(0),reader(NULL)
+{
+}
+/*
+ *@brief:   析构函数 停止读取线程
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseInputSource::~BaseInputSource()
+{
+    stop();
+}
+/*
+ *@brief:   打开设备文件并开始读取
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   devicePath:设备文件路径 如/dev/input/event0
+ *@param:   format:数据格式
+ *@return:  bool:成功返回true
+ */
+bool BaseInputSource::open(const QString &devicePath, Format format)
+{
+#ifdef Q_OS_UNIX
+    int fd = ::open(QFile::encodeName(devicePath).constData(),O_RDONLY|O_NONBLOCK|O_CLOEXEC);
+    if(fd < 0)
+    {
+        qWarning()<<"BaseInputSource: can't open"<<devicePath;
+        return false;
+    }
+    return startReader(fd,true,format);//失败时读取线程对象析构会关闭fd
+#else
+    Q_UNUSED(devicePath)
+    Q_UNUSED(format)
+    return false;
+#endif
+}
+/*
+ *@brief:   使用已有的文件描述符开始读取(如管道或socketpair的读端)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   fd:文件描述符 需要在stop()之后由调用者关闭
+ *@param:   format:数据格式
+ *@return:  bool:成功返回true
+ */
+bool BaseInputSource::start(int fd, Format format)
+{
+    return startReader(fd,false,format);
+}
+/*
+ *@brief:   停止读取线程(阻塞等待线程退出)，已放入队列的事件仍会在GUI线程处理
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseInputSource::stop()
+{
+    if(reader == NULL)
+    {
+        return;
+    }
+    reader->wake();
+    reader->wait();
+    delete reader;
+    reader = NULL;
+}
+/*
+ *@brief:   读取线程是否在运行
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  bool:是否在运行
+ */
+bool BaseInputSource::isRunning()
+{
+    return (reader != NULL && reader->isRunning());
+}
+/*
+ *@brief:   将按键码映射到指定名称(btnName)的按钮 按钮在映射时查找一次，此时还不存在的按钮在第一次
+ * 路由时再查找一次，之后不再查找
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   code:按键码
+ *@param:   btnName:按钮名称
+ */
+void BaseInputSource::mapKeyToButton(quint16 code, const QString &btnName)
+{
+    KeyRoute route;
+    route.btnName = btnName;
+    route.id = -1;
+    route.btn = findButton(btnName);
+    route.resolved = !route.btn.isNull();
+    routeHash.insert(code,route);
+}
+/*
+ *@brief:   将按键码映射到指定的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   code:按键码
+ *@param:   btn:按钮 析构后映射失效
+ */
+void BaseInputSource::mapKeyToButton(quint16 code, BaseToolButton *btn)
+{
+    KeyRoute route;
+    route.id = -1;
+    route.btn = btn;
+    route.resolved = true;
+    routeHash.insert(code,route);
+}
+/*
+ *@brief:   将按键码映射到按钮组中指定id的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   code:按键码
+ *@param:   buttonGroup:按钮组
+ *@param:   id:按钮在组中的id
+ */
+void BaseInputSource::mapKeyToGroup(quint16 code, QButtonGroup *buttonGroup, int id)
+{
+    KeyRoute route;
+    route.buttonGroup = buttonGroup;
+    route.id = id;
+    route.resolved = false;
+    routeHash.insert(code,route);
+}
+/*
+ *@brief:   取消按键码的映射
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   code:按键码
+ */
+void BaseInputSource::unmapKey(quint16 code)
+{
+    routeHash.remove(code);
+}
+/*
+ *@brief:   创建并启动读取线程
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   fd:文件描述符
+ *@param:   ownFd:是否由读取线程关闭
+ *@param:   format:数据格式
+ *@return:  bool:成功返回true
+ */
+bool BaseInputSource::startReader(int fd, bool ownFd, Format format)
+{
+    stop();
+    reader = new BaseInputReader(this,fd,ownFd,format);
+    if(!reader->init())
+    {
+        qWarning()<<"BaseInputSource: reader is not supported on this platform";
+        delete reader;
+        reader = NULL;
+        return false;
+    }
+    reader->start();
+    return true;
+}
+/*
+ *@brief:   获取映射对应的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   route:按键映射
+ *@return:  BaseToolButton*:按钮 不存在时返回NULL
+ */
+BaseToolButton *BaseInputSource::routeButton(KeyRoute &route)
+{
+    if(route.btnName.isEmpty() && !route.resolved)
+    {
+        if(route.buttonGroup.isNull())
+        {
+            return NULL;
+        }
+        return qobject_cast<BaseToolButton *>(route.buttonGroup->button(route.id));
+    }
+    if(!route.resolved)
+    {
+        route.btn = findButton(route.btnName);
+        route.resolved = true;
+    }
+    return route.btn.data();
+}
+/*
+ *@brief:   按名称查找按钮(遍历所有部件，只在映射时使用)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btnName:按钮名称
+ *@return:  BaseToolButton*:按钮 不存在时返回NULL
+ */
+BaseToolButton *BaseInputSource::findButton(const QString &btnName)
+{
+    QWidgetList widgetList = QApplication::allWidgets();
+    for(int i=0;i<widgetList.size();i++)
+    {
+        BaseToolButton *btn = qobject_cast<BaseToolButton *>(widgetList.at(i));
+        if(btn != NULL && btn->getBtnName() == btnName)
+        {
+            return btn;
+        }
+    }
+    return NULL;
+}
+/*
+ *@brief:   取出队列中的所有事件并路由到按钮(GUI线程)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseInputSource::drainSlot()
+{
+    //先清除标记再取出，之后放入的事件会投递新的取出请求，不会遗漏
+    drainScheduled.storeRelease(0);
+    BaseInputEvent inputEvent;
+    while(eventRing.pop(&inputEvent))
+    {
+        emit keyEvent(inputEvent.code,inputEvent.pressed != 0);
+        QHash<quint16,KeyRoute>::iterator it = routeHash.find(inputEvent.code);
+        if(it == routeHash.end())
+        {
+            continue;
+        }
+        BaseToolButton *btn = routeButton(it.value());
+        if(btn == NULL)
+        {
+            continue;
+        }
+        if(inputEvent.pressed != 0)
+        {
+            btn->externalPressBtn(inputEvent.timestampMs);
+        }
+        else if(inputEvent.flags & INPUT_EVENT_RESYNC)
+        {
+            btn->releaseBtn();//真实的释放已丢失，只释放按钮不发出clicked
+        }
+        else
+        {
+            btn->externalReleaseBtn(inputEvent.timestampMs);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  外部按键输入源(后台线程读取，映射到按钮)
+ *
+ * 1.设备上的物理按键与界面按钮一一对应时，以往只能伪造鼠标事件或手动调用releaseBtn()。该类在后台
+ * 线程中通过poll()读取外部事件源(evdev设备文件，测试时可以用管道或socketpair代替)，将按键事件放入
+ * 无锁的单生产者单消费者环形队列(BaseSpscRing)，GUI线程不会因I/O阻塞。
+ * 2.队列由空变为非空时向GUI线程投递一次取出请求，GUI线程在一次事件循环中取出所有事件，按键码按
+ * 映射(按钮名称btnName或按钮组+id)路由到对应的BaseToolButton，按下/释放与鼠标操作走相同的防抖和
+ * 长按处理。事件时间戳与Qt输入事件为同一单调时钟(evdev设备使用内核记录的事件时刻)。
+ * 3.队列满时新的按下事件会被丢弃并计数(getDroppedCount())。队列始终为已放入按下的按键保留释放事件的
+ * 位置，所以释放不会丢失，按钮不会因此一直保持按下(长按也不会持续到最大时间)。evdev设备的内核缓冲区
+ * 溢出(SYN_DROPPED)时丢弃不完整的事件，并按设备当前的按键状态重新同步:补发的释放只释放按钮，不发出clicked。
+ * 4.按名称映射的按钮在映射时(找不到时在第一次路由时)查找一次，之后通过QPointer引用，不再遍历所有部件；
+ * 按钮析构后该映射失效，重新创建的按钮需要重新映射(或直接按按钮指针映射)。
+ * 注:读取线程只在类Unix系统上可用。
+ */
+#ifndef BASEINPUTSOURCE_H
+#define BASEINPUTSOURCE_H
+
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QButtonGroup>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include "basespscring.h"
+#include "basetoolbutton.h"
+
+class BaseInputReader;
+
+#define INPUT_EVENT_RESYNC 0x1 //事件丢失后重新同步按键状态时补发的事件
+
+//一个外部按键事件
+struct BaseInputEvent
+{
+    quint16 code;//按键码
+    quint8 pressed;//1:按下 0:释放
+    quint8 flags;//事件标记 INPUT_EVENT_RESYNC:重新同步时补发的事件
+    quint32 timestampMs;//事件时刻 ms 与Qt输入事件的timestamp()为同一单调时钟
+};
+
+class BaseInputSource : public QObject
+{
+    Q_OBJECT
+public:
+    //事件源数据格式
+    enum Format
+    {
+        EvdevFormat = 0,//linux evdev的struct input_event，只处理EV_KEY的按下/释放(忽略自动重复)
+        RawFormat//紧凑格式 每个事件4字节:按键码(quint16,本机字节序)+按下标记(quint8)+保留(quint8)
+    };
+
+    explicit BaseInputSource(QObject *parent=0,quint32 ringCapacity=256);//容量至少为2(按下与释放)
+    ~BaseInputSource();
+
+    //打开设备文件或使用已有的文件描述符(不接管其关闭)开始读取
+    bool open(const QString &devicePath,Format format = EvdevFormat);
+    bool start(int fd,Format format = RawFormat);
+    void stop();
+    bool isRunning();
+
+    //按键码映射到按钮(按名称或按钮组+id)
+    void mapKeyToButton(quint16 code,const QString &btnName);
+    void mapKeyToButton(quint16 code,BaseToolButton *btn);
+    void mapKeyToGroup(quint16 code,QButtonGroup *buttonGroup,int id);
+    void unmapKey(quint16 code);
+
+    int getDroppedCount(){return droppedCount.loadAcquire();}//队列满时丢弃的事件数(不含保留位置的释放)
+
+private:
+    //按键映射
+    struct KeyRoute
+    {
+        QString btnName;//按钮名称 为空且btn未设置时使用按钮组
+        QPointer<QButtonGroup> buttonGroup;
+        int id;
+        QPointer<BaseToolButton> btn;//映射的按钮(按名称映射时为查找到的按钮)
+        bool resolved;//是否已查找过按钮(按名称只查找一次)
+    };
+
+    bool startReader(int fd,bool ownFd,Format format);
+    BaseToolButton *routeButton(KeyRoute &route);
+    static BaseToolButton *findButton(const QString &btnName);
+
+    BaseSpscRing<BaseInputEvent> eventRing;//读取线程->GUI线程的事件队列
+    QAtomicInt drainScheduled;//是否已投递取出请求
+    QAtomicInt droppedCount;//丢弃的事件数
+    BaseInputReader *reader;//读取线程
+    QHash<quint16,KeyRoute> routeHash;//按键码->映射
+
+    friend class BaseInputReader;
+
+signals:
+    void keyEvent(quint16 code,bool pressed);//取出的每个按键事件(包括未映射的按键)
+
+private slots:
+    void drainSlot();
+};
+
+#endif // BASEINPUTSOURCE_H
@@ -0,0 +1,96 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  合并投递的信号中继(只投递最新值)
+ */
+#include "baselatestrelay.h"
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象(需要移动到其他线程时不能有父对象)
+ */
+BaseLatestRelay::BaseLatestRelay(QObject *parent)
+    :QObject(parent),latestValue(0),pendingFlag(0),generation(0),coalescedCount(0)
+{
+}
+/*
+ *@brief:   保存最新值，没有待投递事件时向中继对象所在线程投递一个，否则只替换值
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   value:值
+ */
+void BaseLatestRelay::post(uint value)
+{
+    quint64 gen = quint32(generation.loadAcquire());
+    latestValue.storeRelease((gen<<32)|value);
+    if(pendingFlag.testAndSetOrdered(0,1))
+    {
+        QMetaObject::invokeMethod(this,"deliverSlot",Qt::QueuedConnection);
+    }
+    else
+    {
+        coalescedCount.fetchAndAddRelaxed(1);
+    }
+}
+/*
+ *@brief:   丢弃尚未投递的值(已在队列中的投递事件到达时不再发出信号)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseLatestRelay::cancel()
+{
+    generation.fetchAndAddOrdered(1);
+}
+/*
+ *@brief:   绑定发送者 中继已绑定其他(仍存在的)发送者时拒绝
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   owner:发送者
+ *@return:  bool:是否绑定成功
+ */
+bool BaseLatestRelay::bindOwner(QObject *owner)
+{
+    if(!this->owner.isNull() && this->owner.data() != owner)
+    {
+        return false;
+    }
+    this->owner = owner;
+    return true;
+}
+/*
+ *@brief:   解除绑定发送者 丢弃该发送者尚未投递的值
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   owner:发送者 不是当前绑定的发送者时不做处理
+ */
+void BaseLatestRelay::unbindOwner(QObject *owner)
+{
+    if(this->owner.data() == owner)
+    {
+        cancel();
+        this->owner = NULL;
+    }
+}
+/*
+ *@brief:   投递槽(中继对象所在线程) 先清除待投递标记再读取最新值，之后的post()会投递新的事件
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseLatestRelay::deliverSlot()
+{
+    pendingFlag.storeRelease(0);
+    quint64 packedValue = latestValue.loadAcquire();
+    if(quint32(packedValue>>32) != quint32(generation.loadAcquire()))
+    {
+        return;
+    }
+    emit latestSig(uint(packedValue&0xFFFFFFFFu));
+}
@@ -0,0 +1,58 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  合并投递的信号中继(只投递最新值)
+ *
+ * 1.长按信号以队列连接(Qt::QueuedConnection)关联到较慢的工作线程(如写设备)时，工作线程处理不过来的
+ * 信号会在事件队列中堆积，用户松开按钮后动作仍在继续执行。该类将中继对象移动到接收者所在的线程，
+ * post()只保存最新值，事件队列中同时最多只有一个待投递事件，投递时取当时的最新值发出latestSig()。
+ * 2.cancel()使已保存但尚未投递的值失效(按钮释放时调用)，之后不会再投递松开前的旧值。
+ * 3.post()/cancel()可以在任意线程调用，latestSig()在中继对象所在的线程发出。
+ * 4.最新值和代数属于整个中继，一个中继只能对应一个发送者(如一个按钮):多个发送者共享时，一个发送者的cancel()
+ * 会丢弃其他发送者的值，接收者也无法区分值来自哪个发送者。发送者通过bindOwner()绑定中继，已绑定其他发送者
+ * 的中继拒绝绑定；接收者可以在槽函数中通过sender()得到中继，再由getOwner()得到发送者。
+ */
+#ifndef BASELATESTRELAY_H
+#define BASELATESTRELAY_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QPointer>
+
+class BaseLatestRelay : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BaseLatestRelay(QObject *parent=0);
+
+    void post(uint value);//保存最新值，没有待投递事件时投递一个
+    void cancel();//丢弃尚未投递的值
+    quint32 getCoalescedCount(){return coalescedCount.loadAcquire();}//被新值替换掉的次数
+
+    //绑定/解除绑定发送者(在发送者所在线程调用)
+    bool bindOwner(QObject *owner);
+    void unbindOwner(QObject *owner);
+    QObject *getOwner(){return owner.data();}
+
+private:
+    QAtomicInteger<quint64> latestValue;//高32位为代数，低32位为值
+    QAtomicInt pendingFlag;//是否已有待投递事件
+    QAtomicInt generation;//代数 cancel()时递增
+    QAtomicInt coalescedCount;//被替换的次数
+    QPointer<QObject> owner;//绑定的发送者 只在发送者所在线程访问
+
+signals:
+    void latestSig(uint value);//投递最新值(在中继对象所在线程发出)
+
+private slots:
+    void deliverSlot();
+};
+
+#endif // BASELATESTRELAY_H
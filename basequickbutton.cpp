@@ -0,0 +1,605 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  基于Qt Quick场景图的按钮
+ */
+#include "basequickbutton.h"
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QSGRectangleNode>
+#include <QSGNode>
+#include <QImage>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#define QUICK_DISABLED_OPACITY 0.4 //没有禁用图标时正常图标的不透明度
+
+/* 每个窗口共享的图标纹理缓存
+ * 纹理属于窗口的场景图，只能在该窗口的渲染线程中创建和销毁，所以缓存按窗口区分，在场景图失效
+ * (sceneGraphInvalidated，渲染线程中发出)时销毁所有纹理。缓存对象本身是窗口的子对象，只在GUI线程中
+ * 创建(按钮加入窗口时)和销毁(随窗口析构，此时场景图已经失效)，渲染线程只查找不创建。
+ */
+class BaseQuickTextureCache : public QObject
+{
+public:
+    static void attachWindow(QQuickWindow *window);
+    static BaseQuickTextureCache *forWindow(QQuickWindow *window);
+    static int totalCount();
+
+    QSGTexture *texture(const QString &iconUrl,QSize iconSize,bool scaledUp);
+    void clear();
+
+private:
+    explicit BaseQuickTextureCache(QQuickWindow *window);
+    ~BaseQuickTextureCache();
+
+    QQuickWindow *window;//纹理所属的窗口
+    QHash<QString,QSGTexture *> textureHash;//图标键->纹理 加载失败的图标为NULL
+
+    static QMutex cacheMutex;//保护cacheHash及各缓存的纹理数(多个窗口可能在不同的渲染线程中)
+    static QHash<QQuickWindow *,BaseQuickTextureCache *> cacheHash;//窗口->纹理缓存
+};
+
+QMutex BaseQuickTextureCache::cacheMutex;
+QHash<QQuickWindow *,BaseQuickTextureCache *> BaseQuickTextureCache::cacheHash;
+
+/*
+ *@brief:   为窗口创建纹理缓存(GUI线程) 已存在时不重复创建
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   window:窗口
+ */
+void BaseQuickTextureCache::attachWindow(QQuickWindow *window)
+{
+    QMutexLocker locker(&cacheMutex);
+    if(window != NULL && !cacheHash.contains(window))
+    {
+        cacheHash.insert(window,new BaseQuickTextureCache(window));
+    }
+}
+/*
+ *@brief:   获取窗口的纹理缓存(渲染线程)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   window:窗口
+ *@return:  BaseQuickTextureCache*:纹理缓存 没有按钮加入过该窗口时为NULL
+ */
+BaseQuickTextureCache *BaseQuickTextureCache::forWindow(QQuickWindow *window)
+{
+    QMutexLocker locker(&cacheMutex);
+    return cacheHash.value(window,NULL);
+}
+/*
+ *@brief:   获取所有窗口中的纹理数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  int:纹理数
+ */
+int BaseQuickTextureCache::totalCount()
+{
+    QMutexLocker locker(&cacheMutex);
+    int count = 0;
+    QHash<QQuickWindow *,BaseQuickTextureCache *>::const_iterator it = cacheHash.constBegin();
+    for(;it != cacheHash.constEnd();++it)
+    {
+        count += it.value()->textureHash.size();
+    }
+    return count;
+}
+/*
+ *@brief:   构造函数(GUI线程) 父对象为窗口，与窗口同属GUI线程
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   window:窗口
+ */
+BaseQuickTextureCache::BaseQuickTextureCache(QQuickWindow *window)
+    :QObject(window),window(window)
+{
+    //渲染线程中直接清理(此时场景图的上下文仍然有效)
+    connect(window,&QQuickWindow::sceneGraphInvalidated,this,&BaseQuickTextureCache::clear,
+            Qt::DirectConnection);
+}
+/*
+ *@brief:   析构函数(GUI线程，随窗口析构) 纹理已在场景图失效时销毁
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseQuickTextureCache::~BaseQuickTextureCache()
+{
+    QMutexLocker locker(&cacheMutex);
+    cacheHash.remove(window);
+}
+/*
+ *@brief:   获取图标纹理(渲染线程) 首次获取时解码并创建纹理，允许放入场景图的纹理图集
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否将图标放大(缩放)到iconSize
+ *@return:  QSGTexture*:纹理 加载失败时为NULL
+ */
+QSGTexture *BaseQuickTextureCache::texture(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    //路径中可能含有%符号，所以这里直接拼接而不使用QString::arg()
+    QString key = iconUrl+QString("|%1x%2|%3").arg(iconSize.width()).arg(iconSize.height()).arg(scaledUp?1:0);
+    QHash<QString,QSGTexture *>::const_iterator it = textureHash.constFind(key);
+    if(it != textureHash.constEnd())
+    {
+        return it.value();
+    }
+    QSGTexture *iconTexture = NULL;
+    QImage image(iconUrl);
+    if(!image.isNull())
+    {
+        if(scaledUp)
+        {
+            image = image.scaled(iconSize,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+        }
+        else if(image.width() > iconSize.width() || image.height() > iconSize.height())
+        {
+            image = image.scaled(iconSize,Qt::KeepAspectRatio,Qt::SmoothTransformation);
+        }
+        iconTexture = window->createTextureFromImage(image.convertToFormat(QImage::Format_ARGB32_Premultiplied),
+                                                     QQuickWindow::TextureCanUseAtlas);
+    }
+    QMutexLocker locker(&cacheMutex);
+    textureHash.insert(key,iconTexture);
+    return iconTexture;
+}
+/*
+ *@brief:   销毁所有纹理(渲染线程) 之后重新获取时再创建
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseQuickTextureCache::clear()
+{
+    QMutexLocker locker(&cacheMutex);
+    qDeleteAll(textureHash);
+    textureHash.clear();
+}
+
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseQuickButton::BaseQuickButton(QQuickItem *parent)
+    :QQuickItem(parent)
+{
+    iconSize = QSize(32,32);
+    iconScaledUp = false;
+    downVisible = false;
+    //与BaseToolButton一致，防抖和长按默认不开启
+    btnCore.config().setAntiShakeEnabled(false);
+    btnCore.config().setLongPressEnabled(false);
+    this->setFlag(QQuickItem::ItemHasContents,true);
+    this->setAcceptedMouseButtons(Qt::LeftButton);
+    //构造时已有父项并位于窗口中时，基类构造期间发出的ItemSceneChange不会到达本类的itemChange()
+    BaseQuickTextureCache::attachWindow(this->window());
+}
+/*
+ *@brief:   析构函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseQuickButton::~BaseQuickButton()
+{
+    BaseTimerWheel::instance()->stop(this);
+}
+/*
+ *@brief:   设置按钮图标
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:是否将图标放大(缩放)到iconSize
+ */
+void BaseQuickButton::setBtnIcon(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    iconUrls[0] = iconUrl;
+    iconUrls[1].clear();
+    iconUrls[2].clear();
+    this->iconSize = iconSize;
+    iconScaledUp = scaledUp;
+    update();
+}
+/*
+ *@brief:   设置按钮多状态图标 图标缩放到iconSize
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   normalIcon:正常状态图标
+ *@param:   checkedIcon:选中状态图标 为空时使用正常图标
+ *@param:   disabledIcon:禁用状态图标 为空时以半透明绘制正常图标
+ *@param:   iconSize:图标size
+ */
+void BaseQuickButton::setBtnIcons(QString normalIcon, QString checkedIcon, QString disabledIcon, QSize iconSize)
+{
+    iconUrls[0] = normalIcon;
+    iconUrls[1] = checkedIcon;
+    iconUrls[2] = disabledIcon;
+    this->iconSize = iconSize;
+    iconScaledUp = true;
+    update();
+}
+/*
+ *@brief:   设置按钮主题
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   theme:主题
+ */
+void BaseQuickButton::setBtnTheme(const BaseToolButtonTheme &theme)
+{
+    btnTheme = theme;
+    update();
+}
+/*
+ *@brief:   设置按钮是否可以选中 取消时清除选中状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   checkable:是否可以选中
+ */
+void BaseQuickButton::setCheckable(bool checkable)
+{
+    bool checked = btnCore.isChecked();
+    btnCore.setCheckable(checkable);
+    if(checked != btnCore.isChecked())
+    {
+        update();
+        emit toggled(false);
+    }
+}
+/*
+ *@brief:   设置选中状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   checked:选中状态
+ */
+void BaseQuickButton::setChecked(bool checked)
+{
+    if(btnCore.setChecked(checked) & BaseButtonEvent::Toggled)
+    {
+        update();
+        emit toggled(checked);
+    }
+}
+/*
+ *@brief:   设置按钮防抖属性
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   antiShakeEnabled:防抖使能状态
+ *@param:   antiShakeMs:防抖窗口时间 ms
+ */
+void BaseQuickButton::setBtnAntiShakeProperty(bool antiShakeEnabled, uint antiShakeMs)
+{
+    btnCore.config().setAntiShakeEnabled(antiShakeEnabled);
+    btnCore.config().setAntiShakeWindowMs(antiShakeMs);
+}
+/*
+ *@brief:   设置按钮长按属性
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   longPressEnabled:长按使能状态
+ *@param:   longPressRespondMs:长按响应时间 ms
+ *@param:   longPressMaxMs:长按最大时间 ms
+ */
+void BaseQuickButton::setBtnLongPressProperty(bool longPressEnabled, uint longPressRespondMs, uint longPressMaxMs)
+{
+    btnCore.config().setLongPressEnabled(longPressEnabled);
+    btnCore.config().setLongPressRespondMs(longPressRespondMs);
+    btnCore.config().setLongPressMaxMs(longPressMaxMs);
+    if(!longPressEnabled)
+    {
+        stopLongPress();
+    }
+}
+/*
+ *@brief:   设置长按加速曲线(先慢后快)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   longPressMinRespondMs:加速后的最小定时间隔 ms
+ *@param:   longPressRampFactor:每次响应后定时间隔的缩放系数 (0,1)之外的值表示不加速
+ */
+void BaseQuickButton::setBtnLongPressRamp(uint longPressMinRespondMs, qreal longPressRampFactor)
+{
+    btnCore.config().setLongPressRamp(longPressMinRespondMs,(longPressRampFactor > 0 && longPressRampFactor < 1)?
+                                          longPressRampFactor:1.0);
+}
+/*
+ *@brief:   手动释放按钮(不发出clicked信号)，避免因长按信号触发(半)模态窗口导致按钮释放操作无法响应
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseQuickButton::releaseBtn()
+{
+    if(!btnCore.isDown())
+    {
+        return;
+    }
+    stopLongPress();
+    btnCore.release(false);
+    if(downVisible)
+    {
+        setDownVisible(false);
+        emit released();
+    }
+}
+/*
+ *@brief:   获取所有窗口中共享的图标纹理数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  int:纹理数
+ */
+int BaseQuickButton::textureCount()
+{
+    return BaseQuickTextureCache::totalCount();
+}
+/*
+ *@brief:   鼠标按下事件处理 由状态机核心判断防抖，并在时间轮上开启长按定时
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:鼠标事件
+ */
+void BaseQuickButton::mousePressEvent(QMouseEvent *e)
+{
+    if(e->button() != Qt::LeftButton)
+    {
+        e->ignore();
+        return;
+    }
+    //被防抖丢弃的按下同样接受事件，之后的释放不做处理
+    e->accept();
+    if(btnCore.press(e->timestamp()) & BaseButtonEvent::Rejected)
+    {
+        return;
+    }
+    setDownVisible(true);
+    emit pressed();
+    if(btnCore.isLongPressActive())
+    {
+        BaseTimerWheel::instance()->start(this,"longPressTimerSlot",btnCore.longPressIntervalMs());
+    }
+}
+/*
+ *@brief:   鼠标移动事件处理 与QAbstractButton一致，移出按钮时显示为释放状态(发出released并停止长按)，
+ * 移回时重新显示为按下状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:鼠标事件
+ */
+void BaseQuickButton::mouseMoveEvent(QMouseEvent *e)
+{
+    if(!btnCore.isDown())
+    {
+        return;
+    }
+    bool inside = this->contains(e->localPos());
+    if(inside == downVisible)
+    {
+        return;
+    }
+    setDownVisible(inside);
+    if(inside)
+    {
+        emit pressed();
+    }
+    else
+    {
+        stopLongPress();
+        emit released();
+    }
+}
+/*
+ *@brief:   鼠标释放事件处理 在按钮内释放时发出clicked，并自动切换选中状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:鼠标事件
+ */
+void BaseQuickButton::mouseReleaseEvent(QMouseEvent *e)
+{
+    if(e->button() != Qt::LeftButton || !btnCore.isDown())
+    {
+        return;
+    }
+    stopLongPress();
+    bool wasDownVisible = downVisible;
+    uint events = btnCore.release(this->contains(e->localPos()));
+    setDownVisible(false);
+    if(wasDownVisible)
+    {
+        emit released();
+    }
+    if(events & BaseButtonEvent::Toggled)
+    {
+        emit toggled(btnCore.isChecked());
+    }
+    if(events & BaseButtonEvent::Clicked)
+    {
+        emit clicked();
+    }
+}
+/*
+ *@brief:   失去鼠标捕获(如弹出窗口、触摸被取消)时释放按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseQuickButton::mouseUngrabEvent()
+{
+    releaseBtn();
+}
+/*
+ *@brief:   状态改变处理 禁用时释放按钮，并重绘禁用状态；加入窗口时在GUI线程创建窗口的纹理缓存
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   change:改变类型
+ *@param:   value:改变后的值
+ */
+void BaseQuickButton::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if(change == QQuickItem::ItemEnabledHasChanged)
+    {
+        if(!value.boolValue)
+        {
+            releaseBtn();
+        }
+        update();
+    }
+    else if(change == QQuickItem::ItemSceneChange)
+    {
+        BaseQuickTextureCache::attachWindow(value.window);
+    }
+    QQuickItem::itemChange(change,value);
+}
+/*
+ *@brief:   更新场景图节点(渲染线程，GUI线程此时阻塞) 节点结构为背景矩形节点->透明度节点->图标图片节点
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   oldNode:上一次返回的节点
+ *@param:   updatePaintNodeData:未使用
+ *@return:  QSGNode*:按钮的根节点
+ */
+QSGNode *BaseQuickButton::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *updatePaintNodeData)
+{
+    Q_UNUSED(updatePaintNodeData);
+    QQuickWindow *quickWindow = this->window();
+    if(quickWindow == NULL)
+    {
+        delete oldNode;
+        return NULL;
+    }
+    BaseToolButtonTheme::State state = BaseToolButtonTheme::Normal;
+    if(!this->isEnabled())
+    {
+        state = BaseToolButtonTheme::Disabled;
+    }
+    else if(downVisible)
+    {
+        state = BaseToolButtonTheme::Pressed;
+    }
+    else if(btnCore.isChecked())
+    {
+        state = BaseToolButtonTheme::Checked;
+    }
+    QSGRectangleNode *backgroundNode = static_cast<QSGRectangleNode *>(oldNode);
+    if(backgroundNode == NULL)
+    {
+        backgroundNode = quickWindow->createRectangleNode();
+    }
+    backgroundNode->setRect(this->boundingRect());
+    backgroundNode->setColor(btnTheme.getBackgroundColor(state));
+
+    //当前状态的图标 选中/禁用图标为空时使用正常图标(禁用时半透明)
+    QSGTexture *iconTexture = NULL;
+    qreal iconOpacity = 1.0;
+    if(!iconUrls[0].isEmpty())
+    {
+        QString iconUrl = iconUrls[0];
+        if(state == BaseToolButtonTheme::Disabled)
+        {
+            iconUrl = iconUrls[2].isEmpty()?iconUrls[0]:iconUrls[2];
+            iconOpacity = iconUrls[2].isEmpty()?QUICK_DISABLED_OPACITY:1.0;
+        }
+        else if(btnCore.isChecked() && !iconUrls[1].isEmpty())
+        {
+            iconUrl = iconUrls[1];
+        }
+        BaseQuickTextureCache *textureCache = BaseQuickTextureCache::forWindow(quickWindow);
+        if(textureCache != NULL)
+        {
+            iconTexture = textureCache->texture(iconUrl,iconSize,iconScaledUp);
+        }
+    }
+    QSGOpacityNode *opacityNode = static_cast<QSGOpacityNode *>(backgroundNode->firstChild());
+    if(iconTexture == NULL)
+    {
+        if(opacityNode != NULL)
+        {
+            backgroundNode->removeChildNode(opacityNode);
+            delete opacityNode;//子节点(图片节点)随之析构
+        }
+        return backgroundNode;
+    }
+    if(opacityNode == NULL)
+    {
+        opacityNode = new QSGOpacityNode;
+        QSGImageNode *imageNode = quickWindow->createImageNode();
+        imageNode->setOwnsTexture(false);//纹理由窗口的纹理缓存共享
+        opacityNode->appendChildNode(imageNode);
+        backgroundNode->appendChildNode(opacityNode);
+    }
+    opacityNode->setOpacity(iconOpacity);
+    QSGImageNode *imageNode = static_cast<QSGImageNode *>(opacityNode->firstChild());
+    imageNode->setTexture(iconTexture);
+    //图标在填充宽度以内居中，超出时保持比例缩小
+    int padding = btnTheme.getPadding(state);
+    QRectF contentRect = this->boundingRect().adjusted(padding,padding,-padding,-padding);
+    QSizeF drawSize = iconTexture->textureSize();
+    if(drawSize.width() > contentRect.width() || drawSize.height() > contentRect.height())
+    {
+        drawSize.scale(contentRect.size(),Qt::KeepAspectRatio);
+        imageNode->setFiltering(QSGTexture::Linear);
+    }
+    else
+    {
+        imageNode->setFiltering(QSGTexture::Nearest);
+    }
+    QRectF drawRect(QPointF(0,0),drawSize);
+    drawRect.moveCenter(contentRect.center());
+    imageNode->setRect(drawRect);
+    return backgroundNode;
+}
+/*
+ *@brief:   设置按下的显示状态
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   downVisible:是否显示为按下状态
+ */
+void BaseQuickButton::setDownVisible(bool downVisible)
+{
+    if(this->downVisible == downVisible)
+    {
+        return;
+    }
+    this->downVisible = downVisible;
+    update();
+    emit downChanged();
+}
+/*
+ *@brief:   停止长按定时
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseQuickButton::stopLongPress()
+{
+    btnCore.cancelLongPress();
+    BaseTimerWheel::instance()->stop(this);
+}
+/*
+ *@brief:   长按定时的响应槽 由状态机核心推进长按，定时间隔变化或长按结束时调整时间轮上的定时
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseQuickButton::longPressTimerSlot()
+{
+    uint longPressIntervalMs = btnCore.longPressIntervalMs();
+    uint events = btnCore.longPressTick(BaseTimerWheel::instance()->now());
+    if(!btnCore.isLongPressActive())
+    {
+        BaseTimerWheel::instance()->stop(this);
+    }
+    else if(btnCore.longPressIntervalMs() != longPressIntervalMs)
+    {
+        BaseTimerWheel::instance()->start(this,"longPressTimerSlot",btnCore.longPressIntervalMs());
+    }
+    if(events & BaseButtonEvent::LongPressed)
+    {
+        emit longPressSig(btnCore.longPressElapsedMs());
+    }
+}
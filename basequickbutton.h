@@ -0,0 +1,106 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  基于Qt Quick场景图的按钮
+ *
+ * 1.在Qt Quick界面中嵌入基于QWidget的BaseToolButton需要经过QQuickWidget/窗口容器，代价较高。该类继承自
+ * QQuickItem，提供与BaseToolButton相同的按钮功能:点击自动切换选中状态、防抖、长按(longPressSig)、
+ * setBtnIcons()多状态图标以及手动释放按钮releaseBtn()。判断逻辑直接使用按钮状态机核心BaseButtonCore，
+ * 长按定时注册到共享的时间轮BaseTimerWheel。
+ * 2.通过场景图节点绘制:背景为矩形节点(颜色取自BaseToolButtonTheme各状态的背景色)，图标为图片节点。
+ * 相同(路径,尺寸,scaledUp)的图标在每个窗口中只创建一个纹理，并允许放入场景图的纹理图集，所以大量按钮的
+ * 背景和图标可以分别合并为少数几次绘制调用。
+ * 3.使用QQuickWindow::createRectangleNode()/createImageNode()创建节点，可以在没有GPU的机器上使用软件
+ * 场景图后端(QT_QUICK_BACKEND=software)。
+ * 4.可以直接在C++中创建，也可以通过qmlRegisterType()注册后在QML中使用。
+ * 注:场景图节点不支持圆角矩形，主题的边角弧度不生效；按钮不绘制文本，需要文本时在QML中叠加Text。
+ */
+#ifndef BASEQUICKBUTTON_H
+#define BASEQUICKBUTTON_H
+
+#include <QQuickItem>
+#include "basebuttoncore.h"
+#include "basedebounce.h"
+#include "basetimerwheel.h"
+#include "basetoolbuttontheme.h"
+
+class BaseQuickButton : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString btnName READ getBtnName WRITE setBtnName)
+    Q_PROPERTY(bool checkable READ isCheckable WRITE setCheckable)
+    Q_PROPERTY(bool checked READ isChecked WRITE setChecked NOTIFY toggled)
+    Q_PROPERTY(bool down READ isDown NOTIFY downChanged)
+public:
+    explicit BaseQuickButton(QQuickItem *parent=0);
+    ~BaseQuickButton();
+
+    //设置按钮名称
+    void setBtnName(QString btnName){this->btnName = btnName;}
+    QString getBtnName(){return this->btnName;}
+    //设置按钮图标
+    void setBtnIcon(const QString &iconUrl,QSize iconSize = QSize(32,32),bool scaledUp = false);
+    void setBtnIcons(QString normalIcon,QString checkedIcon,QString disabledIcon,QSize iconSize = QSize(32,32));
+    //设置按钮主题(各状态的背景色及填充宽度)
+    void setBtnTheme(const BaseToolButtonTheme &theme);
+    BaseToolButtonTheme getBtnTheme(){return btnTheme;}
+    //设置选中状态
+    void setCheckable(bool checkable);
+    bool isCheckable(){return btnCore.isCheckable();}
+    void setChecked(bool checked);
+    bool isChecked(){return btnCore.isChecked();}
+    bool isDown(){return downVisible;}
+    //设置按钮点击时是否自动切换选中状态
+    void setBtnAutoChecked(bool isAutoChecked){btnCore.config().setAutoChecked(isAutoChecked);}
+    bool getBtnAutoChecked(){return btnCore.config().getAutoChecked();}
+    //设置按钮防抖属性
+    void setBtnAntiShakeProperty(bool antiShakeEnabled,uint antiShakeMs = 200);
+    void setBtnAntiShakePolicy(BaseDebounce::Policy policy){btnCore.config().setAntiShakePolicy(policy);}
+    quint32 getBtnAntiShakeRejectedCount(){return btnCore.debounce().getRejectedCount();}
+    //设置按钮长按属性
+    void setBtnLongPressProperty(bool longPressEnabled,uint longPressRespondMs = 3000,
+                                 uint longPressMaxMs=3000);
+    void setBtnLongPressRamp(uint longPressMinRespondMs,qreal longPressRampFactor = 0.8);
+    void releaseBtn();//手动释放按钮
+
+    static int textureCount();//所有窗口中共享的图标纹理数
+
+protected:
+    virtual void mousePressEvent(QMouseEvent *e);
+    virtual void mouseMoveEvent(QMouseEvent *e);
+    virtual void mouseReleaseEvent(QMouseEvent *e);
+    virtual void mouseUngrabEvent();
+    virtual void itemChange(ItemChange change,const ItemChangeData &value);
+    virtual QSGNode *updatePaintNode(QSGNode *oldNode,UpdatePaintNodeData *updatePaintNodeData);
+
+private:
+    void setDownVisible(bool downVisible);
+    void stopLongPress();
+
+    BaseButtonCore<BaseTimerWheelClock,BaseButtonFeature::AllFeatures> btnCore;//按钮状态机核心(含按钮自己的配置)
+    QString btnName;//按钮名 类似于objectname,存放一些特定信息
+    QString iconUrls[3];//正常/选中/禁用图标路径 选中和禁用图标为空时使用正常图标
+    QSize iconSize;//图标size
+    bool iconScaledUp;//图标是否放大(缩放)到iconSize
+    BaseToolButtonTheme btnTheme;//按钮主题
+    bool downVisible;//是否显示为按下状态(按下后移出按钮时为false)
+
+signals:
+    void pressed();
+    void released();
+    void clicked();
+    void toggled(bool checked);
+    void downChanged();
+    void longPressSig(uint longPressMs);//长按信号,参数为长按的时间
+
+public slots:
+    void longPressTimerSlot();//长按定时的响应槽
+};
+
+#endif // BASEQUICKBUTTON_H
@@ -0,0 +1,68 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮外观渲染缓存(进程内共享)
+ */
+#include "baserendercache.h"
+
+#define RENDER_CACHE_LIMIT_KB 16384 //默认的缓存内存预算 KB
+
+/*
+ *@brief:   获取缓存单例
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseRenderCache*:缓存单例指针
+ */
+BaseRenderCache *BaseRenderCache::instance()
+{
+    static BaseRenderCache renderCache;
+    return &renderCache;
+}
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseRenderCache::BaseRenderCache()
+    :hits(0),misses(0)
+{
+    renderCache.setMaxCost(RENDER_CACHE_LIMIT_KB);
+}
+/*
+ *@brief:   查找缓存的外观，并更新命中/未命中计数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   key:外观缓存键
+ *@param:   pixmap:命中时返回缓存的外观图片
+ *@return:  bool:是否命中
+ */
+bool BaseRenderCache::find(const BaseRenderCacheKey &key, QPixmap *pixmap)
+{
+    QPixmap *cachedPixmap = renderCache.object(key);//object()会将该项标记为最近使用
+    if(cachedPixmap == NULL)
+    {
+        misses++;
+        return false;
+    }
+    hits++;
+    *pixmap = *cachedPixmap;
+    return true;
+}
+/*
+ *@brief:   缓存外观，超出预算时QCache会自动淘汰最久未使用的项
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   key:外观缓存键
+ *@param:   pixmap:外观图片
+ */
+void BaseRenderCache::insert(const BaseRenderCacheKey &key, const QPixmap &pixmap)
+{
+    qint64 bytes = qint64(pixmap.width())*pixmap.height()*pixmap.depth()/8;
+    renderCache.insert(key,new QPixmap(pixmap),qMax(int(bytes/1024),1));
+}
@@ -0,0 +1,75 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  按钮外观渲染缓存(进程内共享)
+ *
+ * 1.尺寸、文本、图标、样式以及状态(normal/pressed/checked/disabled等)都相同的按钮每次重绘的像素完全
+ * 一样，比如一排数字键。开启渲染缓存的BaseToolButton会将每种外观只渲染一次到离屏QPixmap中，所有外观
+ * 相同的按钮共享该图片，在paintEvent()中直接贴图。
+ * 2.缓存键(BaseRenderCacheKey)由外观数据、外观哈希和按钮状态组成。外观数据是按钮将尺寸、设备像素比、文本、
+ * 图标、样式、布局方向、调色板、字体、主题等属性依次写入的字节序列，外观哈希为其64位FNV-1a哈希，二者只在
+ * 这些属性改变时重新生成，重绘时只需组合当前状态，不再拼接字符串。查找时先比较哈希，哈希相同再比较完整的
+ * 外观数据(隐式共享的字节数组，相同外观的按钮通常直接比较到同一份数据)，所以哈希碰撞不会命中其他外观。
+ * 尺寸、DPI以及样式变化时自然不会命中旧的外观；样式表变化时(QEvent::StyleChange)按钮会清空整个缓存。
+ * 3.缓存基于QCache实现，以KB为单位计算开销，超出内存预算时按LRU淘汰。
+ * 注:QPixmap只能在GUI线程使用，所以该缓存也只能在GUI线程访问。
+ */
+#ifndef BASERENDERCACHE_H
+#define BASERENDERCACHE_H
+
+#include <QCache>
+#include <QPixmap>
+#include <QByteArray>
+
+//外观缓存键
+struct BaseRenderCacheKey
+{
+    QByteArray appearance;//除按钮状态外所有影响绘制结果的属性(可比较的完整值)
+    quint64 appearanceKey;//appearance的哈希
+    quint32 state;//按钮状态(使能/按下/选中/悬停/焦点/窗口激活)
+
+    bool operator==(const BaseRenderCacheKey &other) const
+    {
+        return appearanceKey == other.appearanceKey && state == other.state &&
+                appearance == other.appearance;
+    }
+};
+inline uint qHash(const BaseRenderCacheKey &key,uint seed = 0)
+{
+    return uint(key.appearanceKey^(key.appearanceKey >> 32))^(key.state*0x9E3779B1u)^seed;
+}
+
+class BaseRenderCache
+{
+public:
+    static BaseRenderCache *instance();
+
+    bool find(const BaseRenderCacheKey &key,QPixmap *pixmap);//查找缓存的外观
+    void insert(const BaseRenderCacheKey &key,const QPixmap &pixmap);//缓存外观
+
+    //设置/获取缓存的内存预算 KB
+    void setCacheLimit(int cacheLimitKb){renderCache.setMaxCost(cacheLimitKb);}
+    int cacheLimit(){return renderCache.maxCost();}
+    int cacheCost(){return renderCache.totalCost();}//当前缓存占用 KB
+    int cacheCount(){return renderCache.count();}//当前缓存的外观数
+    //命中/未命中计数
+    quint64 hitCount(){return hits;}
+    quint64 missCount(){return misses;}
+    void resetCounters(){hits = 0;misses = 0;}
+    void clear(){renderCache.clear();}
+
+private:
+    BaseRenderCache();
+
+    QCache<BaseRenderCacheKey,QPixmap> renderCache;//外观缓存 开销单位KB
+    quint64 hits;//命中次数
+    quint64 misses;//未命中次数
+};
+
+#endif // BASERENDERCACHE_H
@@ -0,0 +1,94 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  无锁单生产者单消费者环形队列
+ *
+ * 1.固定容量(向上取整为2的幂)，push()只能由一个生产者线程调用，pop()只能由一个消费者线程调用，
+ * 两端只通过读/写索引的acquire/release原子操作同步，不加锁也不分配内存。
+ * 2.队列满时push()返回false，由调用者决定丢弃或重试。
+ * 3.T需要可默认构造和赋值，建议使用小的POD类型。
+ */
+#ifndef BASESPSCRING_H
+#define BASESPSCRING_H
+
+#include <QAtomicInteger>
+
+template <typename T>
+class BaseSpscRing
+{
+public:
+    explicit BaseSpscRing(quint32 capacity = 256)
+        :headIndex(0),tailIndex(0)
+    {
+        ringCapacity = 1;
+        while(ringCapacity < capacity)
+        {
+            ringCapacity <<= 1;
+        }
+        ringMask = ringCapacity-1;
+        ringBuffer = new T[ringCapacity];
+    }
+    ~BaseSpscRing()
+    {
+        delete[] ringBuffer;
+    }
+
+    /*
+     *@brief:   放入一个元素(生产者线程)
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   value:元素
+     *@return:  bool:队列已满时返回false
+     */
+    bool push(const T &value)
+    {
+        quint32 tail = tailIndex.loadAcquire();
+        if(tail-headIndex.loadAcquire() >= ringCapacity)
+        {
+            return false;
+        }
+        ringBuffer[tail&ringMask] = value;
+        tailIndex.storeRelease(tail+1);
+        return true;
+    }
+    /*
+     *@brief:   取出一个元素(消费者线程)
+     *@author:  缪庆瑞
+     *@date:    2026.10.17
+     *@param:   value:取出的元素
+     *@return:  bool:队列为空时返回false
+     */
+    bool pop(T *value)
+    {
+        quint32 head = headIndex.loadAcquire();
+        if(head == tailIndex.loadAcquire())
+        {
+            return false;
+        }
+        *value = ringBuffer[head&ringMask];
+        headIndex.storeRelease(head+1);
+        return true;
+    }
+
+    bool isEmpty(){return headIndex.loadAcquire() == tailIndex.loadAcquire();}
+    quint32 size(){return tailIndex.loadAcquire()-headIndex.loadAcquire();}
+    quint32 capacity(){return ringCapacity;}
+
+private:
+    Q_DISABLE_COPY(BaseSpscRing)
+
+    T *ringBuffer;//元素缓冲区
+    quint32 ringCapacity;//容量(2的幂)
+    quint32 ringMask;//索引掩码
+    QAtomicInteger<quint32> headIndex;//读索引(消费者写)
+    char padding[64];//读写索引分开在不同的缓存行，避免两个线程互相影响
+    QAtomicInteger<quint32> tailIndex;//写索引(生产者写)
+};
+
+#endif // BASESPSCRING_H
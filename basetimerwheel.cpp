@@ -0,0 +1,277 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  共享的时间轮定时器(哈希时间轮)
+ */
+#include "basetimerwheel.h"
+#include <QCoreApplication>
+#include <QPointer>
+
+#define WHEEL_SLOT_COUNT 256 //时间轮槽位数
+#define WHEEL_RESOLUTION_MS 10 //默认分辨率 ms
+#define WHEEL_MAX_CATCHUP_TICKS 1000 //单次最多追赶的格数，避免系统休眠唤醒后长时间循环
+
+/*
+ *@brief:   获取时间轮单例(父对象为应用程序对象，随应用程序一起析构)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseTimerWheel*:时间轮单例指针
+ */
+BaseTimerWheel *BaseTimerWheel::instance()
+{
+    static QPointer<BaseTimerWheel> timerWheel;
+    if(timerWheel.isNull())
+    {
+        timerWheel = new BaseTimerWheel(QCoreApplication::instance());
+    }
+    return timerWheel.data();
+}
+/*
+ *@brief:   构造函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   parent:父对象
+ */
+BaseTimerWheel::BaseTimerWheel(QObject *parent)
+    :QObject(parent)
+{
+    resolutionMs = WHEEL_RESOLUTION_MS;
+    wheelSlots.resize(WHEEL_SLOT_COUNT);
+    cursor = 0;
+    wheelStartMs = 0;
+    processedTicks = 0;
+    nextSerial = 1;
+    virtualClock = false;
+    virtualNowMs = 0;
+    monotonicTimer.start();
+
+    wheelTimer = new QTimer(this);
+    wheelTimer->setInterval(resolutionMs);
+    connect(wheelTimer,SIGNAL(timeout()),this,SLOT(wheelTimerSlot()));
+}
+/*
+ *@brief:   启动接收者的周期定时，如果该接收者已有定时则重新启动
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   receiver:接收者，析构时会自动停止定时
+ *@param:   member:到期调用的槽函数名(不带参数及SLOT宏)，如"longPressTimerSlot"
+ *@param:   intervalMs:定时间隔 ms，会按分辨率向上取整为格数
+ */
+void BaseTimerWheel::start(QObject *receiver, const char *member, uint intervalMs)
+{
+    if(receiver == NULL)
+    {
+        return;
+    }
+    stop(receiver);
+    bool wasIdle = entryHash.isEmpty();
+
+    WheelEntry entry;
+    entry.member = member;
+    entry.intervalTicks = qMax((intervalMs+resolutionMs-1)/resolutionMs,1u);
+    entry.rounds = 0;
+    entry.slot = 0;
+    entry.serial = nextSerial++;
+    scheduleEntry(receiver,entry);
+    entryHash.insert(receiver,entry);
+    connect(receiver,SIGNAL(destroyed(QObject*)),this,SLOT(receiverDestroyedSlot(QObject*)),
+            Qt::UniqueConnection);
+
+    //第一个活动定时启动时重置时间基准(虚拟时钟下由advanceTo()驱动，不启动定时器)
+    if(wasIdle)
+    {
+        wheelStartMs = now();
+        processedTicks = 0;
+        if(!virtualClock)
+        {
+            wheelTimer->start(resolutionMs);
+        }
+    }
+}
+/*
+ *@brief:   停止接收者的定时，没有活动定时时停止驱动定时器
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   receiver:接收者
+ */
+void BaseTimerWheel::stop(QObject *receiver)
+{
+    QHash<QObject *,WheelEntry>::iterator it = entryHash.find(receiver);
+    if(it == entryHash.end())
+    {
+        return;
+    }
+    removeSlotItem(it->slot,it->serial);
+    entryHash.erase(it);
+    if(entryHash.isEmpty())
+    {
+        wheelTimer->stop();
+    }
+}
+/*
+ *@brief:   设置时间轮分辨率
+ * 注:已启动的定时以格数保存，修改分辨率会使其实际间隔随之变化，建议在没有活动定时时设置。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   resolutionMs:分辨率 ms
+ */
+void BaseTimerWheel::setResolution(uint resolutionMs)
+{
+    this->resolutionMs = qMax(resolutionMs,1u);
+    wheelTimer->setInterval(this->resolutionMs);
+    wheelStartMs = now();
+    processedTicks = 0;
+}
+/*
+ *@brief:   设置是否使用虚拟时钟 切换时以新时钟的当前时刻作为活动定时的时间基准
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   virtualClock:true=使用虚拟时钟(由advanceTo()推进) false=使用单调时钟
+ *@param:   startMs:虚拟时钟的起始时刻 ms
+ */
+void BaseTimerWheel::setVirtualClock(bool virtualClock, qint64 startMs)
+{
+    this->virtualClock = virtualClock;
+    virtualNowMs = startMs;
+    wheelStartMs = now();
+    processedTicks = 0;
+    if(virtualClock || entryHash.isEmpty())
+    {
+        wheelTimer->stop();
+    }
+    else
+    {
+        wheelTimer->start(resolutionMs);
+    }
+}
+/*
+ *@brief:   将虚拟时钟推进到指定时刻，按顺序处理期间到期的定时 处理每一格时虚拟时钟停在该格的时刻，
+ * 所以槽函数中获取的now()与真实运行时一致，结果只取决于推进的时刻序列
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   targetMs:目标时刻 ms 不大于当前时刻时不做处理
+ */
+void BaseTimerWheel::advanceTo(qint64 targetMs)
+{
+    if(!virtualClock)
+    {
+        return;
+    }
+    while(!entryHash.isEmpty())
+    {
+        qint64 tickMs = wheelStartMs+(processedTicks+1)*resolutionMs;
+        if(tickMs > targetMs)
+        {
+            break;
+        }
+        virtualNowMs = qMax(virtualNowMs,tickMs);
+        processedTicks++;
+        advanceTick();
+    }
+    virtualNowMs = qMax(virtualNowMs,targetMs);
+}
+/*
+ *@brief:   将定时项按间隔排入时间轮对应的槽位
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   receiver:接收者
+ *@param:   entry:定时项
+ */
+void BaseTimerWheel::scheduleEntry(QObject *receiver, WheelEntry &entry)
+{
+    entry.slot = (cursor+entry.intervalTicks)%WHEEL_SLOT_COUNT;
+    entry.rounds = (entry.intervalTicks-1)/WHEEL_SLOT_COUNT;
+    SlotItem item;
+    item.receiver = receiver;
+    item.serial = entry.serial;
+    wheelSlots[entry.slot].append(item);
+}
+/*
+ *@brief:   从槽位中移除指定的定时项
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   slot:槽位
+ *@param:   serial:定时项启动序号
+ */
+void BaseTimerWheel::removeSlotItem(int slot, quint32 serial)
+{
+    QList<SlotItem> &items = wheelSlots[slot];
+    for(int i=0;i<items.size();i++)
+    {
+        if(items.at(i).serial == serial)
+        {
+            items.removeAt(i);
+            return;
+        }
+    }
+}
+/*
+ *@brief:   时间轮走一格，处理当前槽位中到期的定时项
+ * 注:到期项先重新排入时间轮再调用槽函数，槽函数中可以安全地停止/重启任意定时(包括自身)，
+ * 即使槽函数中开启了局部事件循环(如模态对话框)也不会重复处理。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseTimerWheel::advanceTick()
+{
+    cursor = (cursor+1)%WHEEL_SLOT_COUNT;
+    QList<SlotItem> dueItems;
+    dueItems.swap(wheelSlots[cursor]);
+    for(int i=0;i<dueItems.size();i++)
+    {
+        const SlotItem item = dueItems.at(i);
+        QHash<QObject *,WheelEntry>::iterator it = entryHash.find(item.receiver);
+        //已停止或已重新启动的项直接丢弃
+        if(it == entryHash.end() || it->serial != item.serial)
+        {
+            continue;
+        }
+        //还未转满圈数的项留在原槽位
+        if(it->rounds > 0)
+        {
+            it->rounds--;
+            wheelSlots[cursor].append(item);
+            continue;
+        }
+        scheduleEntry(item.receiver,it.value());
+        QByteArray member = it->member;//槽函数中可能修改entryHash，先复制出来
+        QMetaObject::invokeMethod(item.receiver,member.constData(),Qt::DirectConnection);
+    }
+}
+/*
+ *@brief:   驱动定时器的响应槽，根据单调时钟追赶应走的格数，避免定时器延迟造成累计误差
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseTimerWheel::wheelTimerSlot()
+{
+    qint64 dueTicks = (now()-wheelStartMs)/resolutionMs-processedTicks;
+    if(dueTicks > WHEEL_MAX_CATCHUP_TICKS)
+    {
+        processedTicks += dueTicks-WHEEL_MAX_CATCHUP_TICKS;
+        dueTicks = WHEEL_MAX_CATCHUP_TICKS;
+    }
+    //槽函数中停止全部定时后又重新启动会重置时间基准，此时不再继续追赶
+    qint64 startMs = wheelStartMs;
+    for(qint64 i=0;i<dueTicks && !entryHash.isEmpty() && startMs == wheelStartMs;i++)
+    {
+        processedTicks++;
+        advanceTick();
+    }
+}
+/*
+ *@brief:   接收者析构时自动清理其定时
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   receiver:接收者
+ */
+void BaseTimerWheel::receiverDestroyedSlot(QObject *receiver)
+{
+    stop(receiver);
+}
@@ -0,0 +1,100 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  共享的时间轮定时器(哈希时间轮)
+ *
+ * 1.每个使能长按的按钮原本各自持有一个QTimer，按钮较多时会产生大量定时器对象以及事件循环中的定时器注册。
+ * 这里提供一个进程内共享的粗粒度定时调度器，所有按钮将周期定时注册到该时间轮上，整个时间轮只由一个QTimer
+ * 驱动，定时器数量不随按钮数量增长。
+ * 2.时间轮按固定的分辨率(默认10ms)走格，定时间隔会被折算为格数，所以定时精度为一个分辨率。到期的定时
+ * 会通过QMetaObject::invokeMethod()同步调用注册时指定的槽函数，且自动按原间隔重新排入时间轮(周期定时)。
+ * 3.没有活动的定时时驱动定时器自动停止，不占用事件循环。
+ * 4.可以切换到虚拟时钟:此时驱动定时器不运行，now()返回虚拟时刻，由advanceTo()推进时钟并同步处理到期的
+ * 定时，用于输入回放(BaseInputReplayer)等需要确定性结果的场景。
+ * 注:该类只能在GUI(主)线程使用。
+ */
+#ifndef BASETIMERWHEEL_H
+#define BASETIMERWHEEL_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+#include <QList>
+
+class BaseTimerWheel : public QObject
+{
+    Q_OBJECT
+public:
+    static BaseTimerWheel *instance();
+
+    //启动/停止接收者的周期定时 member为槽函数名(不带参数及SLOT宏)
+    void start(QObject *receiver,const char *member,uint intervalMs);
+    void stop(QObject *receiver);
+    bool isActive(QObject *receiver){return entryHash.contains(receiver);}
+
+    //设置/获取时间轮分辨率 ms
+    void setResolution(uint resolutionMs);
+    uint getResolution(){return resolutionMs;}
+    int activeCount(){return entryHash.size();}//活动的定时数
+    int timerCount(){return wheelTimer->isActive()?1:0;}//实际运行的QTimer数(0或1)
+    qint64 now(){return virtualClock?virtualNowMs:monotonicTimer.elapsed();}//单调(或虚拟)时钟 ms
+
+    //虚拟时钟
+    void setVirtualClock(bool virtualClock,qint64 startMs = 0);
+    bool isVirtualClock(){return virtualClock;}
+    void advanceTo(qint64 targetMs);//将虚拟时钟推进到指定时刻，并处理期间到期的定时
+
+private:
+    //时间轮中的定时项
+    struct WheelEntry
+    {
+        QByteArray member;//到期调用的槽函数名
+        uint intervalTicks;//定时间隔(格数)
+        uint rounds;//距离到期还需转动的圈数
+        int slot;//所在的槽位
+        quint32 serial;//启动序号，用来识别重新启动或已停止的项
+    };
+    //槽位中保存的定时项索引
+    struct SlotItem
+    {
+        QObject *receiver;
+        quint32 serial;
+    };
+
+    explicit BaseTimerWheel(QObject *parent=0);
+    void scheduleEntry(QObject *receiver,WheelEntry &entry);
+    void removeSlotItem(int slot,quint32 serial);
+    void advanceTick();
+
+    QTimer *wheelTimer;//驱动时间轮的唯一定时器
+    QElapsedTimer monotonicTimer;//单调时钟
+    uint resolutionMs;//时间轮分辨率 ms
+    QVector<QList<SlotItem> > wheelSlots;//时间轮槽位
+    int cursor;//当前槽位
+    qint64 wheelStartMs;//时间轮启动时刻 ms
+    qint64 processedTicks;//启动后已处理的格数
+    quint32 nextSerial;//下一个启动序号
+    bool virtualClock;//是否使用虚拟时钟
+    qint64 virtualNowMs;//虚拟时钟的当前时刻 ms
+    QHash<QObject *,WheelEntry> entryHash;//接收者->定时项
+
+private slots:
+    void wheelTimerSlot();
+    void receiverDestroyedSlot(QObject *receiver);
+};
+
+//时间轮的时钟(单调或虚拟时钟) 作为按钮状态机核心(BaseButtonCore)的Clock参数
+struct BaseTimerWheelClock
+{
+    static qint64 nowMs(){return BaseTimerWheel::instance()->now();}
+};
+
+#endif // BASETIMERWHEEL_H
@@ -10,6 +10,23 @@
  *@brief:  基类工具按钮(提供按钮常用的功能接口实现)
  */
 #include "basetoolbutton.h"
+#include "baseiconcache.h"
+#include "basetimerwheel.h"
+#include "basedebounce.h"
+#include "baserendercache.h"
+#include "baseiconloader.h"
+#include "basebuttonstats.h"
+#include "basebuttongroup.h"
+#include "baseanimationdriver.h"
+#include "baseiconbundle.h"
+#include <QSet>
+#include <QDebug>
+#include <QPainter>
+#include <QStyleOptionToolButton>
+#include <QtMath>
+
+#define FEEDBACK_RIPPLE_MS 250 //按下波纹扩散到整个按钮的时间 ms
+#define FEEDBACK_FADE_MS 200 //波纹释放后及选中渐变的淡出时间 ms
 
 /*这里默认提供一组样式表(父类QToolButton作为选择器,使用pressed,checked,disabled伪状态来设置
  * 按钮不同状态的样式,{}内为声明(属性名:属性值))
@@ -24,6 +41,68 @@
 QToolButton:pressed{padding:6px;background-color:orange;}\
 QToolButton:checked{padding:6px;background-color:orange;}\
 QToolButton:disabled{padding:2px;color:white;background-color:lightGray;}"
+/* 使用大量按钮时建议以主题(BaseToolButtonTheme)代替样式表，主题由paintEvent()直接绘制，不经过
+ * 样式表的解析和polish。BaseToolButtonTheme的默认值与上面的BTN_STYLE效果一致。*/
+static BaseToolButtonTheme btnDefaultTheme;//按钮的默认(共享)主题
+static QSet<BaseToolButton *> defaultThemeBtnSet;//使用默认主题的按钮集合
+/* 自动check、防抖、长按等行为配置默认由所有按钮共享同一份策略数据，按钮单独修改时写时复制。*/
+static BaseToolButtonPolicy btnDefaultPolicy;//按钮的默认(共享)行为策略
+#define RENDER_KEY_FNV_OFFSET_BASIS Q_UINT64_C(14695981039346656037)
+#define RENDER_KEY_FNV_PRIME Q_UINT64_C(1099511628211)
+
+/* 外观缓存键的计算状态。尺寸、文本、图标等属性改变时Qt不会通知按钮，所以保存计算哈希时的值，重绘时逐项
+ * 比较(都是整数或隐式共享字符串的比较)；字体、调色板、样式等有changeEvent()通知的属性以及按钮自己的
+ * 设置函数只标记dirty。*/
+struct BaseToolButton::RenderKeyState
+{
+    QByteArray appearance;//除按钮状态外的外观数据
+    quint64 appearanceKey;//外观数据的哈希
+    bool dirty;//需要重新计算哈希
+    bool styleSheetStyle;//计算时是否由样式表绘制(此时对象名参与哈希)
+    QSize size;
+    qreal pixelRatio;
+    QString text;
+    qint64 iconKey;
+    QSize iconSize;
+    int toolButtonFlags;//ToolButtonStyle/ArrowType/PopupMode/autoRaise/菜单
+    quint32 themeKey;//使用主题时主题的内容标识
+    quint32 atlasGeneration;//使用图集图标时图集的代数
+    QString objectName;
+};
+/*
+ *@brief:   计算数据的FNV-1a哈希
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   data:数据
+ *@return:  quint64:哈希值
+ */
+static inline quint64 renderKeyHash(const QByteArray &data)
+{
+    quint64 hash = RENDER_KEY_FNV_OFFSET_BASIS;
+    const uchar *bytes = reinterpret_cast<const uchar *>(data.constData());
+    for(int i=0;i<data.size();i++)
+    {
+        hash = (hash^bytes[i])*RENDER_KEY_FNV_PRIME;
+    }
+    return hash;
+}
+/*
+ *@brief:   将属性值追加到外观数据
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   appearance:外观数据
+ *@param:   value:属性值
+ */
+template<typename T>
+static inline void renderKeyAppend(QByteArray &appearance, T value)
+{
+    appearance.append(reinterpret_cast<const char *>(&value),int(sizeof(value)));
+}
+static inline void renderKeyAppend(QByteArray &appearance, const QString &text)
+{
+    renderKeyAppend(appearance,text.size());//先写入长度，相邻字符串的边界不会混淆
+    appearance.append(reinterpret_cast<const char *>(text.constData()),text.size()*int(sizeof(QChar)));
+}
 /*
  *@brief:   构造函数
  *@author:  缪庆瑞
@@ -35,8 +114,18 @@ BaseToolButton::BaseToolButton(QWidget *parent)
 {
     this->initBtnPropertyValue();
     this->setSizePolicy(QSizePolicy::Preferred,QSizePolicy::Preferred);
-
-    //this->setStyleSheet(BTN_STYLE);
+    /* 默认既不设置样式表也不开启主题，按钮使用平台的原生风格；需要上面的外观时由使用者调用
+     * setBtnThemeEnabled(true)(推荐)或setStyleSheet(BTN_STYLE)*/
+}
+/*
+ *@brief:   析构函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseToolButton::~BaseToolButton()
+{
+    defaultThemeBtnSet.remove(this);
+    delete renderKeyState;
 }
 /*
  *@brief:   设置按钮显示的图标(正常(非选中)状态)
@@ -47,16 +136,51 @@ BaseToolButton::BaseToolButton(QWidget *parent)
  *@param:   scaledUp:图标放大。因为这里图标的大小是通过QAbstractButton::setIconSize()方法设置的，
  *该方法设置的大小受限于图标文件本身的size，即无法放大。所以这里采用的放大方式是使用QPixmap放大图标本身，
  *但如果可以的话建议尽量还是选取合适大小的图标，因为靠这里的放大方式会使图标有些失真。
+ *注:解码(缩放)后的图标缓存在BaseIconCache中，由所有按钮共享。
  */
 void BaseToolButton::setBtnIcon(const QString &iconUrl, QSize iconSize, bool scaledUp)
 {
-    QPixmap iconPixmap(iconUrl);
-    if(scaledUp)
+    QString iconUrls[3] = {iconUrl,QString(),QString()};
+    if(setBtnBundleIcons(iconUrls,iconSize,scaledUp))
+    {
+        return;
+    }
+    //图标从进程共享的缓存获取，相同配置的按钮只解码(缩放)一次
+    BaseIconLoader::cancelRequest(this);//取消之前未完成的异步请求，避免覆盖本次设置
+    clearBtnAtlasIcons();
+    this->setIcon(BaseIconCache::instance()->icon(iconUrl,iconSize,scaledUp));
+    this->setIconSize(iconSize);
+}
+/*
+ *@brief:   异步设置按钮显示的图标(正常(非选中)状态)
+ * 图标在工作线程中解码(缩放)，完成前显示占位图标，完成后在GUI线程每帧统一设置。图标已在缓存中时
+ * 直接同步设置。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径，可以是ico或png格式图片
+ *@param:   iconSize:图标size
+ *@param:   scaledUp:图标放大，同setBtnIcon()
+ *@param:   placeholder:解码完成前显示的占位图标，默认为空图标
+ */
+void BaseToolButton::setBtnIconAsync(const QString &iconUrl, QSize iconSize, bool scaledUp,
+                                     const QIcon &placeholder)
+{
+    QString iconUrls[3] = {iconUrl,QString(),QString()};
+    if(setBtnBundleIcons(iconUrls,iconSize,scaledUp))
     {
-        iconPixmap = iconPixmap.scaled(iconSize,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+        return;
     }
-    this->setIcon(QIcon(iconPixmap));
     this->setIconSize(iconSize);
+    clearBtnAtlasIcons();
+    QIcon icon;
+    if(BaseIconCache::instance()->findIcon(iconUrl,iconSize,scaledUp,&icon))
+    {
+        BaseIconLoader::cancelRequest(this);
+        this->setIcon(icon);
+        return;
+    }
+    this->setIcon(placeholder);
+    BaseIconLoader::instance()->requestIcon(this,iconUrl,iconSize,scaledUp);
 }
 /*
  *@brief:   设置按钮不同状态下显示的图标
@@ -68,41 +192,295 @@ void BaseToolButton::setBtnIcon(const QString &iconUrl, QSize iconSize, bool sca
  *@param:   checkedIcon:选中状态图标路径
  *@param:   disabledIcon:禁用状态图标路径
  *@return:  iconSize:图标尺寸
+ * 注:早期版本通过QIcon::addFile()添加各状态的图标，图片在第一次绘制时才按需解码；现在设置时立即解码
+ * 三个状态的图标并组合放入共享缓存(BaseIconCache)，设置的耗时包含解码，绘制时不再解码，相同组合的
+ * 按钮只解码一次。启动时设置大量图标可以使用预解码的图标包(BaseIconBundle)。
  */
 void BaseToolButton::setBtnIcons(QString normalIcon, QString checkedIcon,
                                  QString disabledIcon, QSize iconSize)
 {
-    QIcon icon;
-    if(!normalIcon.isEmpty())
+    QString iconUrls[3] = {normalIcon,checkedIcon,disabledIcon};
+    if(setBtnBundleIcons(iconUrls,iconSize,false))
+    {
+        return;
+    }
+    //组合后的多状态图标同样从缓存获取
+    BaseIconLoader::cancelRequest(this);
+    clearBtnAtlasIcons();
+    this->setIcon(BaseIconCache::instance()->icons(normalIcon,checkedIcon,disabledIcon,iconSize));
+    this->setIconSize(iconSize);
+}
+/*
+ *@brief:   异步设置按钮不同状态下显示的图标
+ * 三个状态的图标在工作线程的同一个任务中解码，完成前显示占位图标，完成后组合为多状态图标放入缓存并在
+ * GUI线程每帧统一设置。组合图标已在缓存中时直接同步设置。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   normalIcon:正常状态图标路径
+ *@param:   checkedIcon:选中状态图标路径
+ *@param:   disabledIcon:禁用状态图标路径
+ *@param:   iconSize:图标尺寸
+ *@param:   placeholder:解码完成前显示的占位图标，默认为空图标
+ */
+void BaseToolButton::setBtnIconsAsync(QString normalIcon, QString checkedIcon,
+                                      QString disabledIcon, QSize iconSize,
+                                      const QIcon &placeholder)
+{
+    QString iconUrls[3] = {normalIcon,checkedIcon,disabledIcon};
+    if(setBtnBundleIcons(iconUrls,iconSize,false))
     {
-        icon.addFile(normalIcon,iconSize,QIcon::Normal,QIcon::Off);
+        return;
     }
-    if(!checkedIcon.isEmpty())
+    this->setIconSize(iconSize);
+    clearBtnAtlasIcons();
+    QIcon icon;
+    if(BaseIconCache::instance()->findIcons(normalIcon,checkedIcon,disabledIcon,iconSize,&icon))
     {
-        icon.addFile(checkedIcon,iconSize,QIcon::Normal,QIcon::On);
+        BaseIconLoader::cancelRequest(this);
+        this->setIcon(icon);
+        return;
     }
-    if(!disabledIcon.isEmpty())
+    this->setIcon(placeholder);
+    BaseIconLoader::instance()->requestIcons(this,normalIcon,checkedIcon,disabledIcon,iconSize);
+}
+/*
+ *@brief:   设置按钮从共享图集(BaseIconAtlas)绘制的图标(正常(非选中)状态)
+ * 图标在首次使用时解码并装入图集，按钮只保存图标在图集中的位置，绘制时从图集页中直接贴出，不再持有
+ * QIcon。禁用状态下以半透明绘制。
+ * 注:按钮的QIcon为空，所以sizeHint()不包含图标，通常由布局或固定尺寸决定按钮大小。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrl:图标路径
+ *@param:   iconSize:图标size 图标大于该尺寸时保持比例缩小
+ *@param:   scaledUp:是否将图标放大(缩放)到iconSize
+ */
+void BaseToolButton::setBtnAtlasIcon(const QString &iconUrl, QSize iconSize, bool scaledUp)
+{
+    BaseIconLoader::cancelRequest(this);
+    clearBtnAtlasIcons();
+    atlasRegions[0] = BaseIconAtlas::instance()->region(iconUrl,iconSize,scaledUp);
+    this->setIcon(QIcon());
+    this->setIconSize(iconSize);
+    this->update();
+}
+/*
+ *@brief:   设置按钮不同状态下从共享图集绘制的图标 未设置选中/禁用图标时使用正常图标
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   normalIcon:正常状态图标路径
+ *@param:   checkedIcon:选中状态图标路径
+ *@param:   disabledIcon:禁用状态图标路径
+ *@param:   iconSize:图标尺寸
+ */
+void BaseToolButton::setBtnAtlasIcons(QString normalIcon, QString checkedIcon,
+                                      QString disabledIcon, QSize iconSize)
+{
+    BaseIconLoader::cancelRequest(this);
+    clearBtnAtlasIcons();
+    QString iconUrls[3] = {normalIcon,checkedIcon,disabledIcon};
+    for(int i=0;i<3;i++)
     {
-        icon.addFile(disabledIcon,iconSize,QIcon::Disabled,QIcon::Off);
+        if(!iconUrls[i].isEmpty())
+        {
+            atlasRegions[i] = BaseIconAtlas::instance()->region(iconUrls[i],iconSize,false);
+        }
     }
-    this->setIcon(icon);
+    this->setIcon(QIcon());
     this->setIconSize(iconSize);
+    this->update();
 }
 /*
- *@brief:   设置按钮文本居左
- * 注1:QToolButton在只显示文本的情况下，默认居中对齐，没有提供方便的接口修改为其他
- * 对齐方式。如果项目中对按钮文本对齐方式统一要求居左/居右时，建议换用QPushButton,
- * 可以参考该类重新实现一个继承QPushButton的按钮基类，添加一些方便的接口。但如果只
- * 是个别按钮文本需要左对齐，且依然想使用该类生成按钮，可以调用该接口实现，不过前提
- * 是按钮类型设置为:ToolButtonTextBesideIcon。
- * 注2:该接口实际是借助QToolButton在水平显示图标+文本时默认居左的特性实现的。
+ *@brief:   设置按钮文本居左(垂直居中)
+ * 注:该接口原来借助QToolButton在水平显示图标+文本时默认居左的特性，通过设置1x1的占位图标实现，
+ * 现在直接调用setBtnTextAlignment()，不再需要占位图标及ToolButtonTextBesideIcon类型。
  *@author:  缪庆瑞
  *@date:    2020.10.27
  */
 void BaseToolButton::setBtnTextAlignLeft()
 {
-    this->setIcon(QIcon(QPixmap(1,1)));//Icon必须有效，否则内部会当成ToolButtonTextOnly处理
-    this->setIconSize(QSize(0,0));
+    this->setBtnTextAlignment(Qt::AlignLeft|Qt::AlignVCenter);
+}
+/*
+ *@brief:   设置按钮文本对齐方式
+ * QToolButton只显示文本时默认居中，没有提供修改对齐方式的接口。设置对齐方式后，按钮背景仍由样式(表)
+ * 或主题绘制，图标和文本由按钮自己绘制，文本排版结果缓存在QStaticText中。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   textAlignment:对齐方式(水平和垂直可以组合) 为0时恢复样式默认的对齐方式
+ */
+void BaseToolButton::setBtnTextAlignment(Qt::Alignment textAlignment)
+{
+    this->textAlignment = textAlignment;
+    markRenderKeyDirty();
+    this->update();
+}
+/*
+ *@brief:   设置按钮文本的省略方式 文本超出可用宽度时按指定位置显示省略号
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   textElideMode:省略方式 Qt::ElideNone表示不省略
+ */
+void BaseToolButton::setBtnTextElideMode(Qt::TextElideMode textElideMode)
+{
+    this->textElideMode = textElideMode;
+    labelTextDirty = true;
+    markRenderKeyDirty();
+    this->update();
+}
+/*
+ *@brief:   设置按钮是否使用默认(共享)主题绘制
+ * 注:按钮自身设置了样式表时，仍然使用样式表绘制。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   themeEnabled:true=使用默认主题  false=使用样式(表)绘制
+ */
+void BaseToolButton::setBtnThemeEnabled(bool themeEnabled)
+{
+    if(themeEnabled)
+    {
+        themeMode = DefaultTheme;
+        defaultThemeBtnSet.insert(this);
+    }
+    else
+    {
+        themeMode = NoTheme;
+        defaultThemeBtnSet.remove(this);
+    }
+    markRenderKeyDirty();
+    this->update();
+}
+/*
+ *@brief:   设置按钮使用的主题(不再跟随默认主题变化)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   theme:主题，隐式共享，多个按钮使用同一主题时只共享一份数据
+ */
+void BaseToolButton::setBtnTheme(const BaseToolButtonTheme &theme)
+{
+    themeMode = CustomTheme;
+    customTheme = theme;
+    defaultThemeBtnSet.remove(this);
+    markRenderKeyDirty();
+    this->update();
+}
+/*
+ *@brief:   设置所有按钮的默认(共享)主题，使用默认主题的按钮只需重绘一次，不需要重新polish
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   theme:主题
+ */
+void BaseToolButton::setBtnDefaultTheme(const BaseToolButtonTheme &theme)
+{
+    btnDefaultTheme = theme;
+    QSet<BaseToolButton *>::const_iterator it;
+    for(it = defaultThemeBtnSet.constBegin();it != defaultThemeBtnSet.constEnd();++it)
+    {
+        (*it)->update();
+    }
+}
+/*
+ *@brief:   获取所有按钮的默认(共享)主题
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseToolButtonTheme:默认主题
+ */
+BaseToolButtonTheme BaseToolButton::getBtnDefaultTheme()
+{
+    return btnDefaultTheme;
+}
+/*
+ *@brief:   设置按钮的反馈动画 动画由共享的逐帧动画驱动(BaseAnimationDriver)推进，只重绘变化的区域
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   feedbacks:反馈动画的组合 NoFeedback表示关闭
+ */
+void BaseToolButton::setBtnFeedback(Feedbacks feedbacks)
+{
+    this->feedbacks = feedbacks;
+    //鼠标移出按钮区域时同样会发出released信号，所以通过信号开始淡出
+    if(feedbacks & (PressRipple|LongPressRing))
+    {
+        connect(this,&QAbstractButton::released,this,&BaseToolButton::feedbackReleasedSlot,
+                Qt::UniqueConnection);
+    }
+    else
+    {
+        disconnect(this,&QAbstractButton::released,this,&BaseToolButton::feedbackReleasedSlot);
+        feedbackPressMs = -1;
+    }
+    if(feedbacks & CheckedFade)
+    {
+        connect(this,&QAbstractButton::toggled,this,&BaseToolButton::feedbackToggledSlot,
+                Qt::UniqueConnection);
+    }
+    else
+    {
+        disconnect(this,&QAbstractButton::toggled,this,&BaseToolButton::feedbackToggledSlot);
+        feedbackCheckedMs = -1;
+    }
+    if(feedbackPressMs < 0 && feedbackCheckedMs < 0)
+    {
+        BaseAnimationDriver::instance()->stop(this);
+    }
+    this->update();
+}
+/*
+ *@brief:   设置按钮的行为策略 策略是显式共享的，多个按钮设置同一策略后共享同一份数据，之后通过策略
+ * 对象修改会同时作用到这些按钮；通过按钮的setBtnXxx()接口修改时按钮会先复制一份私有的策略。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   policy:行为策略
+ */
+void BaseToolButton::setBtnPolicy(const BaseToolButtonPolicy &policy)
+{
+    longPressStopSlot();
+    btnCore.config() = policy;
+}
+/*
+ *@brief:   获取所有按钮的默认(共享)行为策略 通过返回的策略修改会作用到所有仍使用默认策略的按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseToolButtonPolicy:默认策略
+ */
+BaseToolButtonPolicy BaseToolButton::getBtnDefaultPolicy()
+{
+    return btnDefaultPolicy;
+}
+/*
+ *@brief:   设置按钮是否使用外观渲染缓存
+ * 开启后按钮的每种外观只渲染一次到离屏图片，外观相同(尺寸、文本、图标、样式、状态都相同)的按钮共享
+ * 该图片，重绘时直接贴图。适合大量外观相同的按钮同时切换状态的场景(如整个数字键盘)。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   renderCacheEnabled:渲染缓存使能状态
+ */
+void BaseToolButton::setBtnRenderCacheEnabled(bool renderCacheEnabled)
+{
+    if(renderCacheEnabled && renderKeyState == NULL)
+    {
+        renderKeyState = new RenderKeyState;
+        renderKeyState->dirty = true;
+    }
+    else if(!renderCacheEnabled)
+    {
+        delete renderKeyState;
+        renderKeyState = NULL;
+    }
+    this->update();
+}
+/*
+ *@brief:   设置按钮是否自动check 值改变时才复制私有的策略
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   isAutoChecked:是否自动check
+ */
+void BaseToolButton::setBtnAutoChecked(bool isAutoChecked)
+{
+    if(isAutoChecked != btnCore.config().getAutoChecked())
+    {
+        btnCore.config().detach();
+        btnCore.config().setAutoChecked(isAutoChecked);
+    }
 }
 /*
  *@brief:   设置按钮防抖属性
@@ -113,25 +491,64 @@ void BaseToolButton::setBtnTextAlignLeft()
  */
 void BaseToolButton::setBtnAntiShakeProperty(bool antiShakeEnabled, uint antiShakeMs)
 {
-    this->antiShakeEnabled = antiShakeEnabled;
-    this->antiShakeMs = antiShakeMs;
-    if(this->antiShakeEnabled)//防抖功能使能
+    //防抖通过比较事件时间戳实现，不需要分配定时器
+    //只有值改变时才复制私有的策略，设置相同的值不会使按钮脱离共享策略
+    if(antiShakeEnabled != btnCore.config().getAntiShakeEnabled() ||
+            antiShakeMs != btnCore.config().getAntiShakeWindowMs())
     {
-        //初始化防抖定时器
-        if(antiShakeTimer == NULL)
-        {
-            antiShakeTimer = new QTimer(this);
-            antiShakeTimer->setSingleShot(true);//单次定时器
-        }
+        btnCore.config().detach();
+        btnCore.config().setAntiShakeEnabled(antiShakeEnabled);
+        btnCore.config().setAntiShakeWindowMs(antiShakeMs);
     }
-    else//防抖功能禁用
+    if(!antiShakeGroup.isNull())
     {
-        if(antiShakeTimer != NULL)
-        {
-            antiShakeTimer->deleteLater();//清理防抖定时器
-            antiShakeTimer = NULL;
-        }
+        antiShakeGroup->debounce().setWindowMs(antiShakeMs);
+    }
+}
+/*
+ *@brief:   设置按钮防抖策略(前沿/后沿/节流)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   policy:防抖策略
+ */
+void BaseToolButton::setBtnAntiShakePolicy(BaseDebounce::Policy policy)
+{
+    if(policy != btnCore.config().getAntiShakePolicy())
+    {
+        btnCore.config().detach();
+        btnCore.config().setAntiShakePolicy(policy);
     }
+    if(!antiShakeGroup.isNull())
+    {
+        antiShakeGroup->debounce().setPolicy(policy);
+    }
+}
+/*
+ *@brief:   设置按钮共享防抖窗口的按钮组，组内按钮作为一个整体防抖(组内任一按钮被响应后，整个组都进入
+ * 防抖窗口)。共享的防抖策略和窗口时间取最后一次设置的值。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   buttonGroup:按钮组  为NULL时恢复按钮独立防抖
+ */
+void BaseToolButton::setBtnAntiShakeGroup(QButtonGroup *buttonGroup)
+{
+    antiShakeGroup = BaseDebounceGroup::fromButtonGroup(buttonGroup);
+    if(!antiShakeGroup.isNull())
+    {
+        antiShakeGroup->debounce().setPolicy(btnCore.config().getAntiShakePolicy());
+        antiShakeGroup->debounce().setWindowMs(btnCore.config().getAntiShakeWindowMs());
+    }
+}
+/*
+ *@brief:   获取被防抖丢弃的按下次数(共享防抖窗口时为整个组的计数)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  quint32:丢弃次数
+ */
+quint32 BaseToolButton::getBtnAntiShakeRejectedCount()
+{
+    return antiShakeGroup.isNull()?btnCore.debounce().getRejectedCount():
+                                   antiShakeGroup->debounce().getRejectedCount();
 }
 /*
  *@brief:   设置按钮长按属性
@@ -144,31 +561,84 @@ void BaseToolButton::setBtnAntiShakeProperty(bool antiShakeEnabled, uint antiSha
 void BaseToolButton::setBtnLongPressProperty(bool longPressEnabled, uint longPressRespondMs,
                                              uint longPressMaxMs)
 {
-    this->longPressEnabled = longPressEnabled;
-    this->longPressRespondMs = longPressRespondMs;
-    this->longPressMaxMs = longPressMaxMs;
-    if(this->longPressEnabled)//长按功能使能
+    if(longPressEnabled != btnCore.config().getLongPressEnabled() ||
+            longPressRespondMs != btnCore.config().getLongPressRespondMs() ||
+            longPressMaxMs != btnCore.config().getLongPressMaxMs())
     {
-        //初始化长按定时器
-        if(longPressTimer == NULL)
-        {
-            longPressTimer = new QTimer(this);
-            connect(longPressTimer,SIGNAL(timeout()),this,SLOT(longPressTimerSlot()));
-            /* 当鼠标在按钮上按下然后脱离按钮区域时会触发released信号，但不会执行mouseReleaseEvent
-             * 处理函数(释放鼠标才进入该函数)，所以为了确保鼠标离开按钮区域就不再发送长按信号，这里
-             * 关联了released信号和长按定时器的stop槽*/
-            connect(this,SIGNAL(released()),longPressTimer,SLOT(stop()));
-        }
+        btnCore.config().detach();
+        btnCore.config().setLongPressEnabled(longPressEnabled);
+        btnCore.config().setLongPressRespondMs(longPressRespondMs);
+        btnCore.config().setLongPressMaxMs(longPressMaxMs);
     }
-    else//长按功能禁用
+    /* 长按定时统一注册到共享的时间轮(BaseTimerWheel)上，不再为每个按钮单独创建定时器。
+     * released信号与停止长按定时的槽在长按开始时关联(见mousePressEvent())，这样通过共享策略
+     * 开启长按的按钮也能正确停止。*/
+    if(!longPressEnabled)//长按功能禁用
     {
-        if(longPressTimer != NULL)
-        {
-            longPressTimer->deleteLater();//清理长按定时器
-            longPressTimer = NULL;
-        }
+        disconnect(this,&QAbstractButton::released,this,&BaseToolButton::longPressStopSlot);
+        longPressStopSlot();
+    }
+}
+/*
+ *@brief:   设置长按加速曲线(先慢后快) 每次响应后定时间隔乘以缩放系数，直到最小间隔
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   longPressMinRespondMs:加速后的最小定时间隔 ms
+ *@param:   longPressRampFactor:缩放系数(0,1) 大于等于1时不加速
+ */
+void BaseToolButton::setBtnLongPressRamp(uint longPressMinRespondMs, qreal longPressRampFactor)
+{
+    //与策略相同的规范化后再比较
+    longPressMinRespondMs = qMax(longPressMinRespondMs,1u);
+    longPressRampFactor = (longPressRampFactor > 0 && longPressRampFactor < 1)?longPressRampFactor:1.0;
+    if(longPressMinRespondMs != btnCore.config().getLongPressMinRespondMs() ||
+            !qFuzzyCompare(longPressRampFactor,btnCore.config().getLongPressRampFactor()))
+    {
+        btnCore.config().detach();
+        btnCore.config().setLongPressRamp(longPressMinRespondMs,longPressRampFactor);
+    }
+}
+/*
+ *@brief:   设置长按信号的最高频率 两次信号间隔不足时跳过本次，下一次信号携带最新的长按时间
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   longPressMaxRate:每秒最多发出的长按信号数 0表示不限制
+ */
+void BaseToolButton::setBtnLongPressRateLimit(uint longPressMaxRate)
+{
+    if(longPressMaxRate != btnCore.config().getLongPressMaxRate())
+    {
+        btnCore.config().detach();
+        btnCore.config().setLongPressMaxRate(longPressMaxRate);
     }
 }
+/*
+ *@brief:   设置合并投递长按时间的中继  每次长按响应时除了发出longPressSig()，还将长按时间交给中继，
+ * 中继所在线程(较慢的接收者)只会收到最新的长按时间，按钮释放后尚未投递的旧值会被丢弃。
+ * 每个按钮需要使用单独的中继，已被其他按钮使用的中继设置失败。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   longPressRelay:中继(通常已移动到接收者线程)，需要在按钮之后析构，为NULL时不使用中继
+ *@return:  bool:是否设置成功
+ */
+bool BaseToolButton::setBtnLongPressRelay(BaseLatestRelay *longPressRelay)
+{
+    if(longPressRelay == this->longPressRelay.data())
+    {
+        return true;
+    }
+    if(longPressRelay != NULL && !longPressRelay->bindOwner(this))
+    {
+        qWarning()<<"BaseToolButton::setBtnLongPressRelay: relay is already used by another button";
+        return false;
+    }
+    if(!this->longPressRelay.isNull())
+    {
+        this->longPressRelay->unbindOwner(this);
+    }
+    this->longPressRelay = longPressRelay;
+    return true;
+}
 /*
  *@brief:   手动释放按钮，避免因长按信号触发(半)模态窗口导致按钮释放操作无法响应
  *@author:  缪庆瑞
@@ -180,10 +650,127 @@ void BaseToolButton::releaseBtn()
      * 第二个参数表示鼠标指针相对按钮的位置,这里设置为(-1,-1)表示鼠标是在按钮之外
      * 释放的，这样既不会触发按钮的clicked()信号,也能让按钮(样式)回到正常状态。
      */
+    touchPointId = -1;
     QMouseEvent mouseEvent(QMouseEvent::MouseButtonRelease,
                            QPoint(-1,-1),Qt::LeftButton,Qt::LeftButton,Qt::NoModifier);
     mouseReleaseEvent(&mouseEvent);
 }
+/*
+ *@brief:   外部输入(如物理按键)按下按钮  以按钮中心位置构造鼠标按下事件，直接调用鼠标事件处理函数
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   timestamp:按下的时间戳 ms 用于防抖判断，为0时使用单调时钟
+ */
+void BaseToolButton::externalPressBtn(ulong timestamp)
+{
+    if(!this->isEnabled() || this->isDown())
+    {
+        return;
+    }
+    QPoint center = this->rect().center();
+    QMouseEvent mouseEvent(QEvent::MouseButtonPress,QPointF(center),QPointF(mapToGlobal(center)),
+                           Qt::LeftButton,Qt::LeftButton,Qt::NoModifier);
+    mouseEvent.setTimestamp(timestamp);
+    mousePressEvent(&mouseEvent);
+}
+/*
+ *@brief:   外部输入(如物理按键)释放按钮  与releaseBtn()不同，这里在按钮内释放，会发出clicked信号
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   timestamp:释放的时间戳 ms
+ */
+void BaseToolButton::externalReleaseBtn(ulong timestamp)
+{
+    if(!this->isDown())
+    {
+        return;
+    }
+    QPoint center = this->rect().center();
+    QMouseEvent mouseEvent(QEvent::MouseButtonRelease,QPointF(center),QPointF(mapToGlobal(center)),
+                           Qt::LeftButton,Qt::NoButton,Qt::NoModifier);
+    mouseEvent.setTimestamp(timestamp);
+    mouseReleaseEvent(&mouseEvent);
+}
+/*
+ *@brief:   外部输入(如录制回放)在按下期间移出/移回按钮  以按钮外(-1,-1)或中心位置构造按住左键的鼠标移动
+ * 事件，移出时按钮弹起并发出released(停止长按)，移回时重新按下，与拖动鼠标的处理相同
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   inside:是否移回按钮内
+ *@param:   timestamp:移动的时间戳 ms
+ */
+void BaseToolButton::externalMoveBtn(bool inside, ulong timestamp)
+{
+    QPoint pos = inside?this->rect().center():QPoint(-1,-1);
+    QMouseEvent mouseEvent(QEvent::MouseMove,QPointF(pos),QPointF(mapToGlobal(pos)),
+                           Qt::NoButton,Qt::LeftButton,Qt::NoModifier);
+    mouseEvent.setTimestamp(timestamp);
+    mouseMoveEvent(&mouseEvent);
+}
+/*
+ *@brief:   设置按钮是否直接处理触摸事件
+ * 注:默认情况下触摸屏的每次点击都要经过Qt的触摸->鼠标事件合成，防抖和长按要等合成的鼠标按下事件
+ * 到达后才开始计时。使能后按钮接收触摸事件(WA_AcceptTouchEvents)，按触摸事件的时间戳直接执行与
+ * 鼠标相同的按下/移动/释放处理，信号语义不变，并忽略合成的鼠标事件。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   touchEnabled:是否直接处理触摸事件
+ */
+void BaseToolButton::setBtnTouchEnabled(bool touchEnabled)
+{
+    this->touchEnabled = touchEnabled;
+    this->setAttribute(Qt::WA_AcceptTouchEvents,touchEnabled);
+    if(!touchEnabled && touchPointId >= 0)
+    {
+        releaseBtn();
+    }
+}
+/*
+ *@brief:   事件处理  使能触摸时直接处理触摸事件，并丢弃由触摸合成的鼠标事件
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:事件
+ *@return:  bool:事件是否被处理
+ */
+bool BaseToolButton::event(QEvent *e)
+{
+    if(!touchEnabled || !this->isEnabled())
+    {
+        return QToolButton::event(e);
+    }
+    switch(e->type())
+    {
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+    case QEvent::TouchCancel:
+        handleTouchEvent(static_cast<QTouchEvent *>(e));
+        return true;
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    {
+        //触摸已经直接处理过，合成的鼠标事件不再重复处理
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(e);
+#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
+        bool synthesized = (mouseEvent->device() != NULL &&
+                            mouseEvent->device()->type() == QInputDevice::DeviceType::TouchScreen);
+#else
+        bool synthesized = (mouseEvent->source() != Qt::MouseEventNotSynthesized);
+#endif
+        if(synthesized)
+        {
+            e->accept();
+            return true;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return QToolButton::event(e);
+}
 /*
  *@brief:   这是QAbstractButton类提供的一个抽象方法,当按钮被点击时会自动调用。该方法默认的实现是
  *"calls setChecked(!isChecked()) if the button isCheckable()."，这里重新实现该方法，通过
@@ -193,8 +780,13 @@ void BaseToolButton::releaseBtn()
  */
 void BaseToolButton::nextCheckState()
 {
-    if(isAutoChecked)
+    if(btnCore.config().getAutoChecked())
     {
+        //互斥的BaseButtonGroup中已选中的按钮再次点击时保持选中
+        if(this->isChecked() && !baseBtnGroup.isNull() && baseBtnGroup->getExclusive())
+        {
+            return;
+        }
         QToolButton::nextCheckState();
     }
 }
@@ -206,27 +798,41 @@ void BaseToolButton::nextCheckState()
  */
 void BaseToolButton::mousePressEvent(QMouseEvent *e)
 {
-    //判断防抖是否使能以及防抖定时器是否为激活状态,激活状态(防抖时间未结束)则直接返回不做响应
-    if(antiShakeEnabled && antiShakeTimer->isActive())
+    /* 状态机核心直接读取(可能被共享修改的)行为策略，判断本次按下是否在防抖窗口内；共享防抖窗口时使用
+     * 按钮组的防抖引擎(按钮组可能已析构，所以每次按下时重新获取)*/
+    btnCore.setSharedDebounce(antiShakeGroup.isNull()?NULL:&antiShakeGroup->debounce());
+    //个别平台或手动构造的事件时间戳为0，此时状态机核心使用时间轮的单调时钟
+    if(btnCore.press(e->timestamp()) & BaseButtonEvent::Rejected)
     {
+        BASE_BUTTON_STATS(BaseButtonStats::instance()->recordRejected(btnStatsRecords()));
         return;
     }
-    /* 非激活状态则调用父类的mousePressEvent()进行默认处理,并在其后根据使能状态开启定时器
+    /* 窗口外则调用父类的mousePressEvent()进行默认处理,并在其后根据使能状态开启定时器
      * 查看QAbstractButton::mousePressEvent()的源码实现可知,如果这里没有调用父类的
      * 处理函数，则在mouseReleaseEvent()处理函数中也不会发出released和clicked信号,
      * 即这里添加防抖处理不会引起信号逻辑混乱。
      */
+    //统计事件时间戳到pressed()发出的延迟，并记下按下时刻用于统计按下时长和长按延迟
+    BASE_BUTTON_STATS(BaseButtonStats::instance()->recordPress(btnStatsRecords(),e->timestamp());
+                      statsPressUs = BaseButtonStats::instance()->nowUs());
     QToolButton::mousePressEvent(e);
-    //如果防抖使能，则开启防抖定时器
-    if(antiShakeEnabled)
+    //如果长按使能，则在时间轮上开启长按定时
+    if(btnCore.config().getLongPressEnabled())
     {
-        antiShakeTimer->start(antiShakeMs);
+        /* 当鼠标在按钮上按下然后脱离按钮区域时会触发released信号，但不会执行mouseReleaseEvent
+         * 处理函数(释放鼠标才进入该函数)，所以为了确保鼠标离开按钮区域就不再发送长按信号，这里
+         * 关联了released信号和停止长按定时的槽*/
+        connect(this,&QAbstractButton::released,this,&BaseToolButton::longPressStopSlot,
+                Qt::UniqueConnection);
+        BaseTimerWheel::instance()->start(this,"longPressTimerSlot",btnCore.longPressIntervalMs());
     }
-    //如果长按使能，则开启长按定时器
-    if(longPressEnabled)
+    //按下波纹及长按进度环从按下时刻开始
+    if((feedbacks & (PressRipple|LongPressRing)) && this->isDown())
     {
-        longPressRespondedCount = 0;
-        longPressTimer->start(longPressRespondMs);
+        feedbackPressPos = e->pos();
+        feedbackPressMs = BaseAnimationDriver::instance()->now();
+        feedbackReleaseMs = -1;
+        BaseAnimationDriver::instance()->start(this,"animationFrameSlot");
     }
 }
 /*
@@ -237,47 +843,871 @@ void BaseToolButton::mousePressEvent(QMouseEvent *e)
  */
 void BaseToolButton::mouseReleaseEvent(QMouseEvent *e)
 {
-    //如果长按使能，则关闭长按定时器
-    if(longPressEnabled)
+    btnCore.release(e->button() == Qt::LeftButton && hitButton(e->pos()));
+    //如果长按使能，则关闭长按定时(并丢弃中继中尚未投递的长按时间)
+    if(btnCore.config().getLongPressEnabled())
     {
-        longPressTimer->stop();
+        longPressStopSlot();
     }
+    //统计按下时长，以及(本次释放会发出clicked()时)事件时间戳到clicked()的延迟
+    BASE_BUTTON_STATS(if(e->button() == Qt::LeftButton && isDown())
+                      {
+                          BaseButtonStats::instance()->recordRelease(
+                                      btnStatsRecords(),e->timestamp(),statsPressUs,hitButton(e->pos()));
+                          statsPressUs = -1;
+                      });
     QToolButton::mouseReleaseEvent(e);
 }
 /*
- *@brief:   初始化按钮属性(参数变量)值
+ *@brief:   绘制事件处理  使用主题时直接绘制按钮，不经过样式表
  *@author:  缪庆瑞
- *@date:    2020.03.13
+ *@date:    2026.10.17
+ *@param:   e:绘制事件
  */
-void BaseToolButton::initBtnPropertyValue()
+void BaseToolButton::paintEvent(QPaintEvent *e)
 {
-    btnName = "";
-    isAutoChecked = true;
-    /* 注:按钮的长按和防抖功能默认是不开启的，同时对应定时器
-     * 默认情况下也不分配内存空间，避免资源浪费。*/
-    //防抖
-    antiShakeEnabled = false;
-    antiShakeMs = 200;
-    antiShakeTimer = NULL;
-    //长按
-    longPressEnabled = false;
-    longPressRespondMs = 3000;
-    longPressRespondedCount = 0;
-    longPressMaxMs = 3000;
-    longPressTimer = NULL;
-}
-/*
- *@brief:   长按定时器的响应槽
- *@author:  缪庆瑞
- *@date:    2019.12.17
+    //开启渲染缓存时，从缓存中获取(或渲染一次)当前外观后直接贴图
+    if(renderKeyState != NULL)
+    {
+        BaseRenderCacheKey key = renderCacheKey();
+        QPixmap btnPixmap;
+        if(!BaseRenderCache::instance()->find(key,&btnPixmap))
+        {
+            qreal pixelRatio = this->devicePixelRatioF();
+            btnPixmap = QPixmap(this->size()*pixelRatio);
+            btnPixmap.setDevicePixelRatio(pixelRatio);
+            btnPixmap.fill(Qt::transparent);
+            QPainter pixmapPainter(&btnPixmap);
+            renderBtn(&pixmapPainter);
+            pixmapPainter.end();
+            BaseRenderCache::instance()->insert(key,btnPixmap);
+        }
+        QPainter painter(this);
+        painter.drawPixmap(0,0,btnPixmap);
+    }
+    //未使用主题且不需要自己绘制内容时由样式(表)绘制
+    else if(!isThemeActive() && !isCustomLabelActive())
+    {
+        QToolButton::paintEvent(e);
+    }
+    else
+    {
+        QPainter painter(this);
+        renderBtn(&painter);
+    }
+    //反馈动画绘制在按钮外观之上(不进入渲染缓存)
+    if(feedbackPressMs >= 0 || feedbackCheckedMs >= 0)
+    {
+        QPainter painter(this);
+        drawBtnFeedback(&painter);
+    }
+}
+/*
+ *@brief:   状态改变事件处理  样式(表)变化时清空外观缓存，字体变化时重新排版文本，字体/调色板/样式/父部件
+ * 等改变后重新计算外观缓存键
+ * 注:样式表的规则可能来自父部件，仅凭按钮自身的属性无法判断外观是否改变，所以直接清空整个缓存。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:事件
+ */
+void BaseToolButton::changeEvent(QEvent *e)
+{
+    if(e->type() == QEvent::FontChange)
+    {
+        labelTextDirty = true;
+    }
+    markRenderKeyDirty();
+    if(renderKeyState != NULL && e->type() == QEvent::StyleChange)
+    {
+        BaseRenderCache::instance()->clear();
+    }
+    QToolButton::changeEvent(e);
+}
+/*
+ *@brief:   将触摸事件转换为鼠标事件处理  按钮只跟踪按下它的第一个触摸点，其他触摸点由各自所在的
+ * 按钮处理，所以多个按钮可以同时按住
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   e:触摸事件
+ */
+void BaseToolButton::handleTouchEvent(QTouchEvent *e)
+{
+    e->accept();//接受触摸事件，Qt不再为其合成鼠标事件
+    if(e->type() == QEvent::TouchCancel)
+    {
+        if(touchPointId >= 0)
+        {
+            releaseBtn();
+        }
+        return;
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
+    const QList<QEventPoint> &touchPoints = e->points();
+#else
+    const QList<QTouchEvent::TouchPoint> &touchPoints = e->touchPoints();
+#endif
+    for(int i=0;i<touchPoints.size();i++)
+    {
+#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
+        const QEventPoint &touchPoint = touchPoints.at(i);
+        bool pressed = (touchPoint.state() == QEventPoint::Pressed);
+        bool released = (touchPoint.state() == QEventPoint::Released);
+        bool moved = (touchPoint.state() == QEventPoint::Updated);
+        QPointF localPos = touchPoint.position();
+        QPointF screenPos = touchPoint.globalPosition();
+#else
+        const QTouchEvent::TouchPoint &touchPoint = touchPoints.at(i);
+        bool pressed = (touchPoint.state() == Qt::TouchPointPressed);
+        bool released = (touchPoint.state() == Qt::TouchPointReleased);
+        bool moved = (touchPoint.state() == Qt::TouchPointMoved);
+        QPointF localPos = touchPoint.pos();
+        QPointF screenPos = touchPoint.screenPos();
+#endif
+        if(touchPointId < 0)
+        {
+            if(pressed)
+            {
+                touchPointId = touchPoint.id();
+                sendTouchMouseEvent(QEvent::MouseButtonPress,localPos,screenPos,e->timestamp());
+            }
+        }
+        else if(touchPoint.id() == touchPointId)
+        {
+            if(released)
+            {
+                touchPointId = -1;
+                sendTouchMouseEvent(QEvent::MouseButtonRelease,localPos,screenPos,e->timestamp());
+            }
+            else if(moved)
+            {
+                sendTouchMouseEvent(QEvent::MouseMove,localPos,screenPos,e->timestamp());
+            }
+        }
+    }
+}
+/*
+ *@brief:   以触摸点的位置和触摸事件的时间戳构造鼠标事件，直接调用鼠标事件处理函数(不经过事件分发)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   type:鼠标事件类型(按下/移动/释放)
+ *@param:   localPos:按钮坐标系中的位置
+ *@param:   screenPos:屏幕坐标系中的位置
+ *@param:   timestamp:触摸事件的时间戳 ms
+ */
+void BaseToolButton::sendTouchMouseEvent(QEvent::Type type, const QPointF &localPos,
+                                         const QPointF &screenPos, ulong timestamp)
+{
+    Qt::MouseButton button = (type == QEvent::MouseMove)?Qt::NoButton:Qt::LeftButton;
+    Qt::MouseButtons buttons = (type == QEvent::MouseButtonRelease)?Qt::NoButton:Qt::LeftButton;
+    QMouseEvent mouseEvent(type,localPos,screenPos,button,buttons,Qt::NoModifier);
+    mouseEvent.setTimestamp(timestamp);
+    if(type == QEvent::MouseButtonPress)
+    {
+        mousePressEvent(&mouseEvent);
+    }
+    else if(type == QEvent::MouseButtonRelease)
+    {
+        mouseReleaseEvent(&mouseEvent);
+    }
+    else
+    {
+        mouseMoveEvent(&mouseEvent);
+    }
+}
+/*
+ *@brief:   判断当前是否使用主题绘制(未使用主题或者按钮自身设置了样式表时，由样式(表)绘制)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  bool:是否使用主题绘制
+ */
+bool BaseToolButton::isThemeActive()
+{
+    return (themeMode != NoTheme && this->styleSheet().isEmpty());
+}
+/*
+ *@brief:   将按钮当前外观绘制到指定画笔(可以是按钮本身或者离屏图片)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   painter:画笔
+ */
+void BaseToolButton::renderBtn(QPainter *painter)
+{
+    if(isThemeActive())
+    {
+        drawBtnTheme(painter,(themeMode == CustomTheme)?customTheme:btnDefaultTheme);
+        return;
+    }
+    //与QToolButton::paintEvent()的绘制方式一致
+    QStyleOptionToolButton opt;
+    this->initStyleOption(&opt);
+    if(!isCustomLabelActive())
+    {
+        this->style()->drawComplexControl(QStyle::CC_ToolButton,&opt,painter,this);
+        return;
+    }
+    //自己绘制内容时，样式只绘制背景(不含图标和文本)，内容区域与样式绘制CE_ToolButtonLabel时一致
+    QStyleOptionToolButton bevelOpt = opt;
+    bevelOpt.text.clear();
+    bevelOpt.icon = QIcon();
+    this->style()->drawComplexControl(QStyle::CC_ToolButton,&bevelOpt,painter,this);
+    int frameWidth = this->style()->pixelMetric(QStyle::PM_DefaultFrameWidth,&opt,this);
+    opt.rect = this->style()->subControlRect(QStyle::CC_ToolButton,&opt,QStyle::SC_ToolButton,this)
+            .adjusted(frameWidth,frameWidth,-frameWidth,-frameWidth);
+    drawBtnLabel(painter,opt,opt.palette.color(QPalette::ButtonText));
+}
+/*
+ *@brief:   获取按钮当前外观的缓存键  外观数据及其哈希只在影响绘制结果的属性改变时重新生成，每次重绘
+ * 只比较没有改变通知的属性并组合当前状态，不分配内存(外观数据隐式共享)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseRenderCacheKey:缓存键
+ */
+BaseRenderCacheKey BaseToolButton::renderCacheKey()
+{
+    RenderKeyState *keyState = renderKeyState;
+    qreal pixelRatio = this->devicePixelRatioF();
+    qint64 iconKey = this->icon().cacheKey();
+    int toolButtonFlags = int(this->toolButtonStyle())|(int(this->arrowType()) << 4)|
+            (int(this->popupMode()) << 8)|(this->autoRaise()?0x1000:0)|((this->menu() != NULL)?0x2000:0);
+    bool themeActive = isThemeActive();
+    quint32 themeKey = !themeActive?0:((themeMode == CustomTheme)?customTheme.cacheKey():
+                                                                 btnDefaultTheme.cacheKey());
+    quint32 atlasGeneration = atlasRegions[0].isNull()?0:BaseIconAtlas::instance()->getGeneration();
+    if(keyState->dirty || keyState->size != this->size() || keyState->pixelRatio != pixelRatio ||
+            keyState->iconKey != iconKey || keyState->iconSize != this->iconSize() ||
+            keyState->toolButtonFlags != toolButtonFlags || keyState->themeKey != themeKey ||
+            keyState->atlasGeneration != atlasGeneration || keyState->text != this->text() ||
+            (keyState->styleSheetStyle && keyState->objectName != this->objectName()))
+    {
+        keyState->dirty = false;
+        keyState->size = this->size();
+        keyState->pixelRatio = pixelRatio;
+        keyState->text = this->text();
+        keyState->iconKey = iconKey;
+        keyState->iconSize = this->iconSize();
+        keyState->toolButtonFlags = toolButtonFlags;
+        keyState->themeKey = themeKey;
+        keyState->atlasGeneration = atlasGeneration;
+        keyState->objectName = this->objectName();
+        keyState->styleSheetStyle = !themeActive && this->style()->inherits("QStyleSheetStyle");
+
+        QStyleOptionToolButton opt;
+        this->initStyleOption(&opt);
+        QByteArray appearance;
+        appearance.reserve(256);
+        renderKeyAppend(appearance,quintptr(this->metaObject()));
+        renderKeyAppend(appearance,opt.rect.width());
+        renderKeyAppend(appearance,opt.rect.height());
+        renderKeyAppend(appearance,pixelRatio);
+        renderKeyAppend(appearance,opt.text);
+        renderKeyAppend(appearance,iconKey);
+        renderKeyAppend(appearance,opt.iconSize.width());
+        renderKeyAppend(appearance,opt.iconSize.height());
+        renderKeyAppend(appearance,toolButtonFlags);
+        renderKeyAppend(appearance,int(opt.direction));
+        renderKeyAppend(appearance,int(opt.features));
+        renderKeyAppend(appearance,quintptr(this->style()));
+        renderKeyAppend(appearance,opt.palette.cacheKey());
+        renderKeyAppend(appearance,opt.font.key());
+        renderKeyAppend(appearance,int(themeMode));
+        renderKeyAppend(appearance,themeKey);
+        renderKeyAppend(appearance,int(textAlignment));
+        renderKeyAppend(appearance,int(textElideMode));
+        for(int i=0;i<3 && !atlasRegions[0].isNull();i++)
+        {
+            renderKeyAppend(appearance,atlasRegions[i].page);
+            renderKeyAppend(appearance,atlasRegions[i].rect.x());
+            renderKeyAppend(appearance,atlasRegions[i].rect.y());
+            renderKeyAppend(appearance,atlasRegions[i].generation);
+        }
+        renderKeyAppend(appearance,atlasGeneration);
+        for(int i=0;i<3 && !bundleImages[0].isNull();i++)
+        {
+            renderKeyAppend(appearance,bundleImages[i].cacheKey());
+        }
+        if(keyState->styleSheetStyle)
+        {
+            /* 样式表的选择器可能依赖对象名以及父部件，所以使用样式表绘制时只在同一父部件下、对象名及
+             * 自身样式表相同的按钮之间共享外观*/
+            renderKeyAppend(appearance,quintptr(this->parentWidget()));
+            renderKeyAppend(appearance,keyState->objectName);
+            renderKeyAppend(appearance,this->styleSheet());
+        }
+        keyState->appearance = appearance;
+        keyState->appearanceKey = renderKeyHash(appearance);
+    }
+
+    //状态每次重绘时组合 对应样式选项中随交互变化的State_Enabled/Sunken/On/MouseOver/HasFocus/Active
+    BaseRenderCacheKey key;
+    key.appearance = keyState->appearance;
+    key.appearanceKey = keyState->appearanceKey;
+    key.state = (this->isEnabled()?0x01:0)|(this->isDown()?0x02:0)|(this->isChecked()?0x04:0)|
+            (this->underMouse()?0x08:0)|(this->hasFocus()?0x10:0)|(this->isActiveWindow()?0x20:0);
+    return key;
+}
+/*
+ *@brief:   标记外观缓存键需要重新计算(未开启渲染缓存时不做任何事)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseToolButton::markRenderKeyDirty()
+{
+    if(renderKeyState != NULL)
+    {
+        renderKeyState->dirty = true;
+    }
+}
+/*
+ *@brief:   按主题绘制按钮  背景为圆角矩形，内容(图标/文本)由样式的CE_ToolButtonLabel绘制在填充后的区域
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   painter:画笔
+ *@param:   theme:主题
+ */
+void BaseToolButton::drawBtnTheme(QPainter *painter, const BaseToolButtonTheme &theme)
+{
+    BaseToolButtonTheme::State state = BaseToolButtonTheme::Normal;
+    if(!this->isEnabled())
+    {
+        state = BaseToolButtonTheme::Disabled;
+    }
+    else if(this->isDown())
+    {
+        state = BaseToolButtonTheme::Pressed;
+    }
+    else if(this->isChecked())
+    {
+        state = BaseToolButtonTheme::Checked;
+    }
+
+    //背景
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing,true);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(theme.getBackgroundColor(state));
+    painter->drawRoundedRect(QRectF(this->rect()),theme.getRadius(),theme.getRadius());
+    painter->restore();
+
+    //内容 与样式表的padding一样，通过填充宽度控制content区域的大小
+    QStyleOptionToolButton opt;
+    this->initStyleOption(&opt);
+    int padding = theme.getPadding(state);
+    opt.rect = this->rect().adjusted(padding,padding,-padding,-padding);
+    //箭头按钮仍由样式绘制，其他情况使用缓存的排版文本绘制
+    if(opt.features & QStyleOptionToolButton::Arrow)
+    {
+        opt.palette.setColor(QPalette::ButtonText,theme.getTextColor(state));
+        this->style()->drawControl(QStyle::CE_ToolButtonLabel,&opt,painter,this);
+        return;
+    }
+    drawBtnLabel(painter,opt,theme.getTextColor(state));
+}
+/*
+ *@brief:   判断是否由按钮自己绘制内容(设置了对齐/省略方式或使用图集图标)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  bool:是否自己绘制
+ */
+bool BaseToolButton::isCustomLabelActive()
+{
+    return (int(textAlignment) != 0 || textElideMode != Qt::ElideNone || !atlasRegions[0].isNull() ||
+            !bundleImages[0].isNull());
+}
+/*
+ *@brief:   清除图集及图标包图标
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseToolButton::clearBtnAtlasIcons()
+{
+    for(int i=0;i<3;i++)
+    {
+        atlasRegions[i] = BaseIconAtlasRegion();
+        bundleImages[i] = QImage();
+    }
+    markRenderKeyDirty();//之后设置的图集/图标包图标在下次绘制时参与哈希
+}
+/*
+ *@brief:   从打开的图标包(BaseIconBundle)设置按钮图标 各个非空路径的图标都在包中时才使用图标包，
+ * 否则由调用者走解码路径。与图集图标一样不持有QIcon，绘制时直接贴出映射的像素。
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   iconUrls:正常/选中/禁用图标路径 选中和禁用图标可以为空
+ *@param:   iconSize:图标尺寸
+ *@param:   scaledUp:是否放大(缩放)到iconSize
+ *@return:  bool:是否已从图标包设置
+ */
+bool BaseToolButton::setBtnBundleIcons(const QString iconUrls[3], QSize iconSize, bool scaledUp)
+{
+    BaseIconBundle *iconBundle = BaseIconBundle::instance();
+    if(!iconBundle->isOpen())
+    {
+        return false;
+    }
+    QImage images[3];
+    for(int i=0;i<3;i++)
+    {
+        if(iconUrls[i].isEmpty() && i > 0)
+        {
+            continue;
+        }
+        images[i] = iconBundle->findImage(iconUrls[i],iconSize,scaledUp);
+        if(images[i].isNull())
+        {
+            return false;
+        }
+    }
+    BaseIconLoader::cancelRequest(this);
+    clearBtnAtlasIcons();
+    for(int i=0;i<3;i++)
+    {
+        bundleImages[i] = images[i];
+    }
+    this->setIcon(QIcon());
+    this->setIconSize(iconSize);
+    this->update();
+    return true;
+}
+/*
+ *@brief:   绘制按钮内容(图标+文本) 图标和文本的位置与QCommonStyle绘制CE_ToolButtonLabel时一致，
+ * 文本使用缓存的QStaticText绘制，并按设置的方式对齐及省略
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   painter:画笔
+ *@param:   opt:样式选项 rect为内容区域
+ *@param:   textColor:文本颜色
+ */
+void BaseToolButton::drawBtnLabel(QPainter *painter, const QStyleOptionToolButton &opt,
+                                  const QColor &textColor)
+{
+    QRect rect = opt.rect;
+    if(opt.state & (QStyle::State_Sunken|QStyle::State_On))
+    {
+        rect.translate(this->style()->pixelMetric(QStyle::PM_ButtonShiftHorizontal,&opt,this),
+                       this->style()->pixelMetric(QStyle::PM_ButtonShiftVertical,&opt,this));
+    }
+    bool atlasIcon = !atlasRegions[0].isNull();
+    bool bundleIcon = !bundleImages[0].isNull();
+    Qt::ToolButtonStyle btnStyle = opt.toolButtonStyle;
+    //图集/图标包图标不设置QIcon，有文本时initStyleOption()会改为只显示文本，这里恢复按钮设置的类型
+    if((atlasIcon || bundleIcon) && btnStyle == Qt::ToolButtonTextOnly)
+    {
+        btnStyle = this->toolButtonStyle();
+        if(btnStyle == Qt::ToolButtonFollowStyle)
+        {
+            btnStyle = Qt::ToolButtonStyle(this->style()->styleHint(QStyle::SH_ToolButtonStyle,&opt,this));
+        }
+    }
+    bool hasIcon = ((atlasIcon || bundleIcon || !opt.icon.isNull()) && btnStyle != Qt::ToolButtonTextOnly);
+    bool hasText = (!opt.text.isEmpty() && btnStyle != Qt::ToolButtonIconOnly);
+    Qt::Alignment alignment = textAlignment;
+    QRect textRect = rect;
+    if(hasIcon)
+    {
+        QIcon::Mode iconMode = QIcon::Normal;
+        if(!(opt.state & QStyle::State_Enabled))
+        {
+            iconMode = QIcon::Disabled;
+        }
+        else if((opt.state & QStyle::State_MouseOver) && (opt.state & QStyle::State_AutoRaise))
+        {
+            iconMode = QIcon::Active;
+        }
+        QIcon::State iconState = (opt.state & QStyle::State_On)?QIcon::On:QIcon::Off;
+        QRect iconRect = rect;
+        if(hasText && btnStyle == Qt::ToolButtonTextUnderIcon)
+        {
+            iconRect.setHeight(opt.iconSize.height()+4);
+            textRect.setTop(iconRect.bottom());
+        }
+        else if(hasText)//图标在左，文本默认紧靠图标居左
+        {
+            iconRect.setWidth(opt.iconSize.width()+4);
+            textRect.setLeft(iconRect.right()+1);
+            if(!alignment)
+            {
+                alignment = Qt::AlignLeft|Qt::AlignVCenter;
+            }
+        }
+        iconRect = QStyle::visualRect(opt.direction,rect,iconRect);
+        textRect = QStyle::visualRect(opt.direction,rect,textRect);
+        if(bundleIcon)
+        {
+            //选中/禁用状态没有单独的图标时使用正常图标，禁用时半透明，与图集图标一致
+            const QImage *image = &bundleImages[0];
+            qreal opacity = 1.0;
+            if(iconMode == QIcon::Disabled)
+            {
+                if(bundleImages[2].isNull())
+                {
+                    opacity = 0.4;
+                }
+                else
+                {
+                    image = &bundleImages[2];
+                }
+            }
+            else if(iconState == QIcon::On && !bundleImages[1].isNull())
+            {
+                image = &bundleImages[1];
+            }
+            BaseIconAtlas::drawImage(painter,iconRect,*image,image->rect(),opacity);
+        }
+        else if(atlasIcon)
+        {
+            //选中/禁用状态没有单独的图集图标时使用正常图标，禁用时半透明
+            const BaseIconAtlasRegion *region = &atlasRegions[0];
+            qreal opacity = 1.0;
+            if(iconMode == QIcon::Disabled)
+            {
+                if(atlasRegions[2].isNull())
+                {
+                    opacity = 0.4;
+                }
+                else
+                {
+                    region = &atlasRegions[2];
+                }
+            }
+            else if(iconState == QIcon::On && !atlasRegions[1].isNull())
+            {
+                region = &atlasRegions[1];
+            }
+            BaseIconAtlas::instance()->draw(painter,iconRect,*region,opacity);
+        }
+        else
+        {
+            opt.icon.paint(painter,iconRect,Qt::AlignCenter,iconMode,iconState);
+        }
+    }
+    if(!hasText)
+    {
+        return;
+    }
+    updateLabelStaticText(opt.text,textRect.width());
+    //未指定的方向居中
+    if(!(alignment & Qt::AlignHorizontal_Mask))
+    {
+        alignment |= Qt::AlignHCenter;
+    }
+    if(!(alignment & Qt::AlignVertical_Mask))
+    {
+        alignment |= Qt::AlignVCenter;
+    }
+    alignment = QStyle::visualAlignment(opt.direction,alignment);
+    QSizeF textSize = labelStaticText.size();
+    QPointF textPos(textRect.left(),textRect.top());
+    if(alignment & Qt::AlignRight)
+    {
+        textPos.setX(textRect.left()+textRect.width()-textSize.width());
+    }
+    else if(alignment & Qt::AlignHCenter)
+    {
+        textPos.setX(textRect.left()+(textRect.width()-textSize.width())/2);
+    }
+    if(alignment & Qt::AlignBottom)
+    {
+        textPos.setY(textRect.top()+textRect.height()-textSize.height());
+    }
+    else if(alignment & Qt::AlignVCenter)
+    {
+        textPos.setY(textRect.top()+(textRect.height()-textSize.height())/2);
+    }
+    painter->save();
+    painter->setFont(this->font());
+    painter->setPen(textColor);
+    painter->drawStaticText(textPos,labelStaticText);
+    painter->restore();
+}
+/*
+ *@brief:   获取按钮及其按钮组的统计记录 记录在第一次使用或名称、所在按钮组改变时查找一次，之后记录点
+ * 直接使用缓存的指针(只做原子递增)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  const BaseButtonStatsRecords&:统计记录
+ */
+const BaseButtonStatsRecords &BaseToolButton::btnStatsRecords()
+{
+    if(statsRecords.btnRecord == NULL || statsRecords.group != group())
+    {
+        BaseButtonStats::instance()->resolveRecords(&statsRecords,btnName,group());
+    }
+    return statsRecords;
+}
+/*
+ *@brief:   更新缓存的排版文本 只有文本、字体(labelTextDirty)或省略时的可用宽度改变才重新排版
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   text:按钮文本(可能含有助记符&)
+ *@param:   textWidth:可用宽度
+ */
+void BaseToolButton::updateLabelStaticText(const QString &text, int textWidth)
+{
+    bool elide = (textElideMode != Qt::ElideNone);
+    if(!labelTextDirty && text == labelSourceText && (!elide || textWidth == labelTextWidth))
+    {
+        return;
+    }
+    labelSourceText = text;
+    labelTextWidth = textWidth;
+    labelTextDirty = false;
+    //与样式绘制时一样去掉助记符(&&表示字符&本身)
+    QString displayText;
+    displayText.reserve(text.size());
+    for(int i=0;i<text.size();i++)
+    {
+        if(text.at(i) == QLatin1Char('&'))
+        {
+            i++;
+            if(i == text.size())
+            {
+                break;
+            }
+        }
+        displayText.append(text.at(i));
+    }
+    if(elide)
+    {
+        displayText = this->fontMetrics().elidedText(displayText,textElideMode,textWidth);
+    }
+    labelStaticText.setTextFormat(Qt::PlainText);
+    labelStaticText.setPerformanceHint(QStaticText::AggressiveCaching);
+    labelStaticText.setText(displayText);
+    labelStaticText.prepare(QTransform(),this->font());
+}
+/*
+ *@brief:   初始化按钮属性(参数变量)值
+ *@author:  缪庆瑞
+ *@date:    2020.03.13
+ */
+void BaseToolButton::initBtnPropertyValue()
+{
+    btnName = "";
+    btnCore.config() = btnDefaultPolicy;
+    baseBtnGroupId = -1;
+    themeMode = NoTheme;
+    renderKeyState = NULL;
+    textAlignment = Qt::Alignment();
+    textElideMode = Qt::ElideNone;
+    labelTextWidth = -1;
+    labelTextDirty = true;
+    /* 注:按钮的长按和防抖功能默认是不开启的。防抖通过比较事件时间戳实现，
+     * 长按定时由共享的时间轮提供，都不需要为按钮分配定时器。*/
+    //触摸
+    touchEnabled = false;
+    touchPointId = -1;
+    statsPressUs = -1;
+    statsRecords.btnRecord = NULL;
+    statsRecords.groupRecord = NULL;
+    statsRecords.group = NULL;
+    //反馈动画
+    feedbacks = NoFeedback;
+    feedbackColor = QColor(255,255,255,110);
+    feedbackPressMs = -1;
+    feedbackReleaseMs = -1;
+    feedbackCheckedMs = -1;
+}
+/*
+ *@brief:   长按定时器的响应槽
+ *@author:  缪庆瑞
+ *@date:    2019.12.17
  */
 void BaseToolButton::longPressTimerSlot()
 {
-    longPressRespondedCount++;
-    if(longPressRespondedCount*longPressRespondMs >= longPressMaxMs)
+    //由状态机核心推进长按(加速曲线及限频)，定时间隔变化或长按结束时调整时间轮上的定时
+    uint longPressIntervalMs = btnCore.longPressIntervalMs();
+    uint events = btnCore.longPressTick(BaseTimerWheel::instance()->now());
+    if(!btnCore.isLongPressActive())
+    {
+        BaseTimerWheel::instance()->stop(this);
+    }
+    else if(btnCore.longPressIntervalMs() != longPressIntervalMs)
+    {
+        BaseTimerWheel::instance()->start(this,"longPressTimerSlot",btnCore.longPressIntervalMs());
+    }
+    if(!(events & BaseButtonEvent::LongPressed))
     {
-        longPressTimer->stop();
+        return;
     }
-    emit longPressSig(longPressRespondedCount*longPressRespondMs);//上报长按信号
+    uint longPressElapsedMs = btnCore.longPressElapsedMs();
+    //统计长按信号相对预定时刻(按下时刻+长按时间)的延迟
+    BASE_BUTTON_STATS(if(statsPressUs >= 0)
+                      {
+                          BaseButtonStats::instance()->recordLongPress(
+                                      btnStatsRecords(),BaseButtonStats::instance()->nowUs()-
+                                      statsPressUs-qint64(longPressElapsedMs)*1000);
+                      });
+    if(!longPressRelay.isNull())
+    {
+        longPressRelay->post(longPressElapsedMs);
+    }
+    emit longPressSig(longPressElapsedMs);//上报长按信号
 }
 
+/*
+ *@brief:   停止长按定时的响应槽(按钮释放时触发)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseToolButton::longPressStopSlot()
+{
+    btnCore.cancelLongPress();
+    BaseTimerWheel::instance()->stop(this);
+    if(!longPressRelay.isNull())
+    {
+        longPressRelay->cancel();
+    }
+}
+/*
+ *@brief:   按钮释放(或鼠标移出按钮)时开始淡出波纹、擦除进度环
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseToolButton::feedbackReleasedSlot()
+{
+    if(feedbackPressMs >= 0 && feedbackReleaseMs < 0)
+    {
+        feedbackReleaseMs = BaseAnimationDriver::instance()->now();
+        BaseAnimationDriver::instance()->start(this,"animationFrameSlot");
+    }
+}
+/*
+ *@brief:   选中状态切换时开始渐变
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseToolButton::feedbackToggledSlot()
+{
+    feedbackCheckedMs = BaseAnimationDriver::instance()->now();
+    BaseAnimationDriver::instance()->start(this,"animationFrameSlot");
+}
+/*
+ *@brief:   动画驱动的帧槽函数 推进反馈动画并只重绘变化的区域，所有动画结束(或停在最终状态)时停止
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   frameMs:当前帧时刻 ms
+ */
+void BaseToolButton::animationFrameSlot(qint64 frameMs)
+{
+    QRect dirtyRect;
+    bool rippleActive = false;
+    bool ringActive = false;
+    bool fadeActive = false;
+    if(feedbackPressMs >= 0)
+    {
+        if(feedbacks & PressRipple)
+        {
+            //半径只增不减，当前波纹的区域包含了上一帧的区域
+            int radius = rippleRadius(frameMs)+1;
+            dirtyRect |= QRect(feedbackPressPos.x()-radius,feedbackPressPos.y()-radius,2*radius,2*radius);
+            rippleActive = (feedbackReleaseMs < 0)?(frameMs-feedbackPressMs < FEEDBACK_RIPPLE_MS):
+                                                   (frameMs-feedbackReleaseMs < FEEDBACK_FADE_MS);
+        }
+        if((feedbacks & LongPressRing) && btnCore.config().getLongPressEnabled())
+        {
+            dirtyRect |= ringRect().adjusted(-2,-2,2,2);
+            ringActive = (feedbackReleaseMs < 0 && frameMs-feedbackPressMs < btnCore.config().getLongPressMaxMs());
+        }
+        //释放后的动画已结束，不再绘制按下反馈(本帧的重绘将其擦除)
+        if(feedbackReleaseMs >= 0 && !rippleActive)
+        {
+            feedbackPressMs = -1;
+        }
+    }
+    if(feedbackCheckedMs >= 0)
+    {
+        dirtyRect = this->rect();
+        fadeActive = (frameMs-feedbackCheckedMs < FEEDBACK_FADE_MS);
+        if(!fadeActive)
+        {
+            feedbackCheckedMs = -1;
+        }
+    }
+    dirtyRect &= this->rect();
+    if(!dirtyRect.isEmpty())
+    {
+        this->update(dirtyRect);
+    }
+    if(!rippleActive && !ringActive && !fadeActive)
+    {
+        BaseAnimationDriver::instance()->stop(this);
+    }
+}
+/*
+ *@brief:   绘制反馈动画(选中渐变、按下波纹、长按进度环)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   painter:画笔
+ */
+void BaseToolButton::drawBtnFeedback(QPainter *painter)
+{
+    qint64 nowMs = BaseAnimationDriver::instance()->now();
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing,true);
+    painter->setClipRect(this->rect());
+    if(feedbackCheckedMs >= 0)
+    {
+        qreal opacity = 1.0-qreal(nowMs-feedbackCheckedMs)/FEEDBACK_FADE_MS;
+        if(opacity > 0)
+        {
+            QColor fadeColor = feedbackColor;
+            fadeColor.setAlphaF(fadeColor.alphaF()*opacity);
+            painter->fillRect(this->rect(),fadeColor);
+        }
+    }
+    if(feedbackPressMs >= 0 && (feedbacks & PressRipple))
+    {
+        qreal opacity = 1.0;
+        if(feedbackReleaseMs >= 0)
+        {
+            opacity = 1.0-qreal(nowMs-feedbackReleaseMs)/FEEDBACK_FADE_MS;
+        }
+        if(opacity > 0)
+        {
+            QColor rippleColor = feedbackColor;
+            rippleColor.setAlphaF(rippleColor.alphaF()*opacity);
+            int radius = rippleRadius(nowMs);
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(rippleColor);
+            painter->drawEllipse(QPointF(feedbackPressPos),radius,radius);
+        }
+    }
+    if(feedbackPressMs >= 0 && feedbackReleaseMs < 0 && (feedbacks & LongPressRing) &&
+            btnCore.config().getLongPressEnabled())
+    {
+        qreal progress = qMin(qreal(nowMs-feedbackPressMs)/qMax(btnCore.config().getLongPressMaxMs(),1u),1.0);
+        painter->setPen(QPen(this->palette().color(QPalette::Highlight),3));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawArc(ringRect(),90*16,-int(progress*360*16));//从12点方向顺时针填充
+    }
+    painter->restore();
+}
+/*
+ *@brief:   获取波纹的半径 从按下位置扩散，FEEDBACK_RIPPLE_MS后覆盖整个按钮
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   frameMs:时刻 ms
+ *@return:  int:半径
+ */
+int BaseToolButton::rippleRadius(qint64 frameMs)
+{
+    //按下位置到最远角的距离
+    int dx = qMax(feedbackPressPos.x(),this->width()-feedbackPressPos.x());
+    int dy = qMax(feedbackPressPos.y(),this->height()-feedbackPressPos.y());
+    qreal maxRadius = qSqrt(qreal(dx)*dx+qreal(dy)*dy);
+    qint64 growMs = qBound(qint64(0),frameMs-feedbackPressMs,qint64(FEEDBACK_RIPPLE_MS));
+    return qCeil(maxRadius*growMs/FEEDBACK_RIPPLE_MS);
+}
+/*
+ *@brief:   获取长按进度环的区域 按钮中央的正方形
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  QRect:区域
+ */
+QRect BaseToolButton::ringRect()
+{
+    int side = qMax(qMin(this->width(),this->height())-8,4);
+    QRect rect(0,0,side,side);
+    rect.moveCenter(this->rect().center());
+    return rect;
+}
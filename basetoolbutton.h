@@ -16,65 +16,212 @@
  * 2.该类重新实现了QAbstractButton的nextCheckState()方法，方便通过check状态模拟按钮的"开关"状态，
  * 并可以配置在点击时自动/手动切换状态。
  * 3.该类重新实现了mousePressEvent()和mouseReleaseEvent()鼠标事件处理方法，添加了防抖和长按的功
- * 能处理。
+ * 能处理。防抖由BaseDebounce根据事件时间戳判断(支持前沿/后沿/节流策略及按钮组共享窗口)，长按
+ * 定时由所有按钮共享的时间轮(BaseTimerWheel)驱动，都不再为每个按钮单独创建定时器。长按响应支持
+ * 先慢后快的加速曲线和最高频率限制，并可以通过BaseLatestRelay向较慢的接收者只投递最新的长按时间。
+ * 4.该类重新实现了paintEvent()，可以使用隐式共享的主题(BaseToolButtonTheme)代替样式表直接绘制按钮，
+ * 避免大量按钮经过样式表解析和polish。同时可以开启外观渲染缓存(BaseRenderCache)，外观相同的按钮
+ * 共享同一份离屏渲染结果。
+ * 5.可以开启直接处理触摸事件，触摸按下时即以触摸事件的时间戳开始防抖和长按判断，不再等待Qt合成的
+ * 鼠标事件，同时忽略合成的鼠标事件避免重复处理。每个按钮跟踪按下自己的触摸点，多个按钮可以同时按住。
+ * 6.可以开启BaseButtonStats统计输入延迟、按下时长、长按及防抖丢弃次数，关闭时几乎没有开销。
+ * 7.自动check、防抖、长按等行为配置保存在共享的策略(BaseToolButtonPolicy)中，默认所有按钮共享同一份
+ * 策略数据，按钮自身只保存运行状态；通过setBtnXxx()单独修改某个按钮时写时复制。
+ * 8.支持文本居左/居右/居中对齐及省略显示。自绘文本(主题绘制或设置了对齐/省略方式)时，排版后的文本缓存
+ * 在QStaticText中，只在文本、字体或可用宽度改变时重新排版，稳定状态下的重绘不再对文本重新排版。
+ * 9.可以从共享的图标图集(BaseIconAtlas)绘制图标，按钮只保存图标在图集中的位置，不再持有QIcon。
+ * 10.可以开启按下波纹、选中渐变和长按进度环等反馈动画，所有按钮的动画由共享的逐帧动画驱动
+ * (BaseAnimationDriver)推进，每帧只重绘变化的区域，没有动画时不运行定时器。
+ * 11.打开预解码的图标包(BaseIconBundle)后，setBtnIcon()/setBtnIcons()优先按名称从包中取图标，直接绘制
+ * 内存映射的像素，不再解码图标文件。
  */
 #ifndef BASETOOLBUTTON_H
 #define BASETOOLBUTTON_H
 
 #include <QToolButton>
-#include <QTimer>
 #include <QMouseEvent>
+#include <QTouchEvent>
+#include <QPointer>
+#include <QPainter>
+#include <QStaticText>
+#include "basedebounce.h"
+#include "basebuttoncore.h"
+#include "basetimerwheel.h"
+#include "basetoolbuttontheme.h"
+#include "basetoolbuttonpolicy.h"
+#include "baselatestrelay.h"
+#include "baseiconatlas.h"
+#include "baseiconbundle.h"
+#include "baserendercache.h"
+#include "basebuttonstats.h"
+
+class BaseButtonGroup;
+class QStyleOptionToolButton;
 
 class BaseToolButton : public QToolButton
 {
     Q_OBJECT
 public:
+    //反馈动画
+    enum Feedback
+    {
+        NoFeedback = 0x0,
+        PressRipple = 0x1,//按下波纹 从按下位置扩散，释放后淡出
+        CheckedFade = 0x2,//选中状态切换时整个按钮闪烁后淡出
+        LongPressRing = 0x4//长按进度环 按住期间向长按最大时间填充
+    };
+    Q_DECLARE_FLAGS(Feedbacks,Feedback)
+
     BaseToolButton(QWidget *parent=0);
+    ~BaseToolButton();
 
     //设置按钮图标
     void setBtnIcon(const QString &iconUrl,QSize iconSize = QSize(32,32),bool scaledUp = false);
     void setBtnIcons(QString normalIcon,QString checkedIcon,QString disabledIcon,QSize iconSize = QSize(32,32));
-    //设置按钮文本居左
+    void setBtnIconAsync(const QString &iconUrl,QSize iconSize = QSize(32,32),bool scaledUp = false,
+                         const QIcon &placeholder = QIcon());
+    void setBtnIconsAsync(QString normalIcon,QString checkedIcon,QString disabledIcon,
+                          QSize iconSize = QSize(32,32),const QIcon &placeholder = QIcon());
+    //设置按钮从共享图集绘制的图标(按钮不持有QIcon)
+    void setBtnAtlasIcon(const QString &iconUrl,QSize iconSize = QSize(32,32),bool scaledUp = false);
+    void setBtnAtlasIcons(QString normalIcon,QString checkedIcon,QString disabledIcon,
+                          QSize iconSize = QSize(32,32));
+    //设置按钮文本对齐及省略方式
     void setBtnTextAlignLeft();
+    void setBtnTextAlignment(Qt::Alignment textAlignment);
+    Qt::Alignment getBtnTextAlignment(){return textAlignment;}
+    void setBtnTextElideMode(Qt::TextElideMode textElideMode);
+    Qt::TextElideMode getBtnTextElideMode(){return textElideMode;}
+    //设置按钮主题(代替样式表，由paintEvent()直接绘制)
+    void setBtnThemeEnabled(bool themeEnabled);
+    void setBtnTheme(const BaseToolButtonTheme &theme);
+    static void setBtnDefaultTheme(const BaseToolButtonTheme &theme);
+    static BaseToolButtonTheme getBtnDefaultTheme();
+    //设置按钮是否使用外观渲染缓存(外观相同的按钮共享同一份离屏渲染结果)
+    void setBtnRenderCacheEnabled(bool renderCacheEnabled);
 
     //设置/获取按钮名称
-    void setBtnName(QString btnName){this->btnName = btnName;}
+    void setBtnName(QString btnName){this->btnName = btnName;statsRecords.btnRecord = NULL;}
     QString getBtnName(){return this->btnName;}
     //设置按钮是否可以自动check
-    void setBtnAutoChecked(bool isAutoChecked){this->isAutoChecked = isAutoChecked;}
+    void setBtnAutoChecked(bool isAutoChecked);
+    //设置/获取按钮的行为策略(多个按钮可以共享同一份策略)
+    void setBtnPolicy(const BaseToolButtonPolicy &policy);
+    BaseToolButtonPolicy getBtnPolicy(){return btnCore.config();}
+    static BaseToolButtonPolicy getBtnDefaultPolicy();
+    //获取按钮所在的BaseButtonGroup及id(由BaseButtonGroup::addButton()设置)
+    BaseButtonGroup *getBtnGroup(){return baseBtnGroup.data();}
+    int getBtnGroupId(){return baseBtnGroupId;}
     //设置按钮防抖属性
     void setBtnAntiShakeProperty(bool antiShakeEnabled,uint antiShakeMs = 200);
+    void setBtnAntiShakePolicy(BaseDebounce::Policy policy);
+    void setBtnAntiShakeGroup(QButtonGroup *buttonGroup);
+    quint32 getBtnAntiShakeRejectedCount();
     //设置按钮长按属性
     void setBtnLongPressProperty(bool longPressEnabled,uint longPressRespondMs = 3000,
                                  uint longPressMaxMs=3000);
+    void setBtnLongPressRamp(uint longPressMinRespondMs,qreal longPressRampFactor = 0.8);
+    void setBtnLongPressRateLimit(uint longPressMaxRate);
+    bool setBtnLongPressRelay(BaseLatestRelay *longPressRelay);
     void releaseBtn();//手动释放按钮
+    //外部输入(如物理按键、录制回放)按下/释放/移出按钮，与鼠标操作走相同的防抖和长按处理
+    void externalPressBtn(ulong timestamp = 0);
+    void externalReleaseBtn(ulong timestamp = 0);
+    void externalMoveBtn(bool inside,ulong timestamp = 0);
+    //设置按钮是否直接处理触摸事件(不经过Qt由触摸合成的鼠标事件)
+    void setBtnTouchEnabled(bool touchEnabled);
+    bool getBtnTouchEnabled(){return touchEnabled;}
+    //设置按钮的反馈动画及颜色(波纹和选中渐变使用该颜色，进度环使用调色板的Highlight)
+    void setBtnFeedback(Feedbacks feedbacks);
+    Feedbacks getBtnFeedback(){return feedbacks;}
+    void setBtnFeedbackColor(const QColor &feedbackColor){this->feedbackColor = feedbackColor;}
 
 protected:
+    virtual bool event(QEvent *e);
     virtual void nextCheckState();
     virtual void mousePressEvent(QMouseEvent *e);
     virtual void mouseReleaseEvent(QMouseEvent *e);
+    virtual void paintEvent(QPaintEvent *e);
+    virtual void changeEvent(QEvent *e);
 
 private:
+    //按钮主题模式
+    enum ThemeMode
+    {
+        NoTheme = 0,//不使用主题，由样式(表)绘制
+        DefaultTheme,//使用默认(共享)主题
+        CustomTheme//使用按钮自身设置的主题
+    };
+
     void initBtnPropertyValue();//初始化按钮属性(参数变量)值
+    bool isThemeActive();//是否使用主题绘制
+    void renderBtn(QPainter *painter);//绘制按钮当前外观
+    void drawBtnTheme(QPainter *painter,const BaseToolButtonTheme &theme);//按主题绘制按钮
+    bool isCustomLabelActive();//是否由按钮自己绘制内容(设置了对齐/省略方式或使用图集/图标包图标)
+    void clearBtnAtlasIcons();//清除图集及图标包图标
+    bool setBtnBundleIcons(const QString iconUrls[3],QSize iconSize,bool scaledUp);//从图标包设置图标
+    void drawBtnLabel(QPainter *painter,const QStyleOptionToolButton &opt,const QColor &textColor);
+    const BaseButtonStatsRecords &btnStatsRecords();//获取(缓存的)统计记录
+    void updateLabelStaticText(const QString &text,int textWidth);//更新缓存的排版文本
+    void drawBtnFeedback(QPainter *painter);//绘制反馈动画
+    int rippleRadius(qint64 frameMs);//波纹的半径
+    QRect ringRect();//长按进度环的区域
+    BaseRenderCacheKey renderCacheKey();//当前外观的缓存键
+    void markRenderKeyDirty();//影响外观的属性改变后重新计算缓存键
+    void handleTouchEvent(QTouchEvent *e);//将触摸事件转换为鼠标事件处理
+    void sendTouchMouseEvent(QEvent::Type type,const QPointF &localPos,const QPointF &screenPos,
+                             ulong timestamp);
 
     QString btnName;//按钮名 类似于objectname,存放一些特定信息
-    bool isAutoChecked;//是否可以自动(通过点击)切换check状态  默认为true
-    /*按钮防抖*/
-    bool antiShakeEnabled;//防抖使能标记 默认不使能
-    QTimer *antiShakeTimer;//按钮防抖定时器
-    uint antiShakeMs;//按钮防抖时间 ms
-    /*按钮长按*/
-    bool longPressEnabled;//长按使能标记 默认不使能
-    QTimer *longPressTimer;//按钮长按定时器
-    uint longPressRespondMs;//按钮长按响应时间(长按定时器超时时间) ms
-    uint longPressRespondedCount;//按钮长按响应计数(长按定时器的超时次数)
-    uint longPressMaxMs;//按钮长按最大时间 ms
+    QPointer<BaseButtonGroup> baseBtnGroup;//按钮所在的BaseButtonGroup
+    int baseBtnGroupId;//按钮在BaseButtonGroup中的id 不在组中时为-1
+    ThemeMode themeMode;//主题模式 默认不使用主题
+    BaseToolButtonTheme customTheme;//按钮自身设置的主题
+    struct RenderKeyState;
+    RenderKeyState *renderKeyState;//外观缓存键及计算时的属性值 不为NULL时开启外观渲染缓存 默认不开启
+    /*文本排版*/
+    Qt::Alignment textAlignment;//文本对齐方式 为0时使用样式默认的对齐方式
+    Qt::TextElideMode textElideMode;//文本省略方式 默认不省略
+    QStaticText labelStaticText;//缓存的排版文本
+    QString labelSourceText;//labelStaticText对应的原始文本
+    int labelTextWidth;//labelStaticText排版时的可用宽度
+    bool labelTextDirty;//字体等改变后需要重新排版
+    BaseIconAtlasRegion atlasRegions[3];//图集图标(正常/选中/禁用)在图集中的位置 正常图标无效时不使用图集
+    QImage bundleImages[3];//图标包中的图标(正常/选中/禁用) 引用映射的像素 正常图标为空时不使用图标包
+    /*按钮防抖和长按 判断逻辑在状态机核心中，核心的配置即行为策略(自动check、防抖及长按配置，默认共享
+     *默认策略)，按钮只保存运行状态*/
+    BaseButtonCore<BaseTimerWheelClock,BaseButtonFeature::AntiShake|BaseButtonFeature::LongPress,
+                   BaseToolButtonPolicy> btnCore;
+    QPointer<BaseDebounceGroup> antiShakeGroup;//共享防抖窗口的按钮组 为空时独立防抖
+    QPointer<BaseLatestRelay> longPressRelay;//合并投递长按时间的中继 为空时不使用
+    /*触摸*/
+    bool touchEnabled;//直接处理触摸事件的使能标记 默认不使能
+    int touchPointId;//当前按下按钮的触摸点id 小于0表示没有
+    qint64 statsPressUs;//统计用的按下时刻 us 小于0表示未记录(见BaseButtonStats)
+    BaseButtonStatsRecords statsRecords;//缓存的统计记录 名称或所在按钮组改变时重新查找
+    /*反馈动画*/
+    Feedbacks feedbacks;//开启的反馈动画 默认不开启
+    QColor feedbackColor;//波纹及选中渐变的颜色
+    QPoint feedbackPressPos;//按下位置
+    qint64 feedbackPressMs;//按下时刻 ms 小于0表示没有按下动画
+    qint64 feedbackReleaseMs;//释放时刻 ms 小于0表示还未释放
+    qint64 feedbackCheckedMs;//选中状态切换时刻 ms 小于0表示没有选中渐变
 
 signals:
     void longPressSig(uint longPressMs);//长按信号,参数为长按的时间
 
 public slots:
     void longPressTimerSlot();//长按定时器的响应槽
+
+private slots:
+    void longPressStopSlot();//停止长按定时
+    void feedbackReleasedSlot();//按钮释放(或鼠标移出按钮)时开始淡出
+    void feedbackToggledSlot();//选中状态切换时开始渐变
+    void animationFrameSlot(qint64 frameMs);//动画驱动的帧槽函数
+
+    friend class BaseButtonGroup;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(BaseToolButton::Feedbacks)
+
 #endif // BASETOOLBUTTON_H
@@ -0,0 +1,58 @@
+#-------------------------------------------------
+#
+# BaseToolButton组件源文件，供演示程序和基准测试共用
+#
+#-------------------------------------------------
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+SOURCES += $$PWD/basetoolbutton.cpp \
+    $$PWD/baseiconcache.cpp \
+    $$PWD/basetimerwheel.cpp \
+    $$PWD/basedebounce.cpp \
+    $$PWD/basetoolbuttontheme.cpp \
+    $$PWD/basetoolbuttonpolicy.cpp \
+    $$PWD/baserendercache.cpp \
+    $$PWD/basebuttonpanel.cpp \
+    $$PWD/baseiconloader.cpp \
+    $$PWD/baseiconatlas.cpp \
+    $$PWD/basebuttonloader.cpp \
+    $$PWD/baselatestrelay.cpp \
+    $$PWD/basebuttonstats.cpp \
+    $$PWD/baseinputsource.cpp \
+    $$PWD/basebuttongroup.cpp \
+    $$PWD/baseanimationdriver.cpp \
+    $$PWD/baseinputrecorder.cpp \
+    $$PWD/basebuttonupdater.cpp \
+    $$PWD/baseiconbundle.cpp
+
+HEADERS += $$PWD/basetoolbutton.h \
+    $$PWD/baseiconcache.h \
+    $$PWD/basetimerwheel.h \
+    $$PWD/basedebounce.h \
+    $$PWD/basebuttoncore.h \
+    $$PWD/basetoolbuttontheme.h \
+    $$PWD/basetoolbuttonpolicy.h \
+    $$PWD/baserendercache.h \
+    $$PWD/basebuttonpanel.h \
+    $$PWD/baseiconloader.h \
+    $$PWD/baseiconatlas.h \
+    $$PWD/basebuttonloader.h \
+    $$PWD/baselatestrelay.h \
+    $$PWD/basebuttonstats.h \
+    $$PWD/basespscring.h \
+    $$PWD/baseinputsource.h \
+    $$PWD/basebuttongroup.h \
+    $$PWD/baseanimationdriver.h \
+    $$PWD/baseinputrecorder.h \
+    $$PWD/basebuttonupdater.h \
+    $$PWD/baseiconbundle.h
+
+#Qt Quick场景图按钮 只在有quick模块时编译(定义BASE_QUICK_BUTTON宏)
+qtHaveModule(quick) {
+    QT += quick
+    DEFINES += BASE_QUICK_BUTTON
+    SOURCES += $$PWD/basequickbutton.cpp
+    HEADERS += $$PWD/basequickbutton.h
+}
@@ -0,0 +1,213 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  基类工具按钮的行为策略(共享，按钮单独修改时写时复制)
+ */
+#include "basetoolbuttonpolicy.h"
+
+//策略共享数据
+class BaseToolButtonPolicyData : public QSharedData
+{
+public:
+    BaseToolButtonPolicyData()
+    {
+        //与按钮原来的默认值一致:自动check，防抖和长按默认不开启
+        autoChecked = true;
+        antiShakeEnabled = false;
+        antiShakePolicy = BaseDebounce::LeadingEdge;
+        antiShakeWindowMs = 200;
+        longPressEnabled = false;
+        longPressRespondMs = 3000;
+        longPressMaxMs = 3000;
+        longPressMinRespondMs = 3000;
+        longPressRampFactor = 1.0;
+        longPressMaxRate = 0;
+    }
+
+    bool autoChecked;//是否可以自动切换check状态
+    bool antiShakeEnabled;//防抖使能
+    BaseDebounce::Policy antiShakePolicy;//防抖策略
+    uint antiShakeWindowMs;//防抖窗口时间 ms
+    bool longPressEnabled;//长按使能
+    uint longPressRespondMs;//长按响应时间 ms
+    uint longPressMaxMs;//长按最大时间 ms
+    uint longPressMinRespondMs;//加速后的最小响应间隔 ms
+    qreal longPressRampFactor;//响应间隔的缩放系数 1表示不加速
+    uint longPressMaxRate;//每秒最多发出的长按信号数 0表示不限制
+};
+
+/*
+ *@brief:   构造函数(默认策略)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseToolButtonPolicy::BaseToolButtonPolicy()
+    :d(new BaseToolButtonPolicyData)
+{
+}
+//复制得到的策略与other共享同一份数据(显式共享)
+BaseToolButtonPolicy::BaseToolButtonPolicy(const BaseToolButtonPolicy &other)
+    :d(other.d)
+{
+}
+
+BaseToolButtonPolicy &BaseToolButtonPolicy::operator=(const BaseToolButtonPolicy &other)
+{
+    d = other.d;
+    return *this;
+}
+
+BaseToolButtonPolicy::~BaseToolButtonPolicy()
+{
+}
+/*
+ *@brief:   复制一份独立的策略(修改不影响原策略)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  BaseToolButtonPolicy:策略副本
+ */
+BaseToolButtonPolicy BaseToolButtonPolicy::clone() const
+{
+    BaseToolButtonPolicy policy(*this);
+    policy.detach();
+    return policy;
+}
+/*
+ *@brief:   与其他副本分离 数据被共享时复制一份私有数据，未共享时不做任何操作
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+void BaseToolButtonPolicy::detach()
+{
+    d.detach();
+}
+/*
+ *@brief:   是否与other共享同一份数据
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   other:其他策略
+ *@return:  bool:是否共享
+ */
+bool BaseToolButtonPolicy::isSharedWith(const BaseToolButtonPolicy &other) const
+{
+    return (d.data() == other.d.data());
+}
+/*
+ *@brief:   策略数据的字节数(用于评估共享策略节省的内存)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  int:字节数
+ */
+int BaseToolButtonPolicy::dataSize()
+{
+    return int(sizeof(BaseToolButtonPolicyData));
+}
+
+void BaseToolButtonPolicy::setAutoChecked(bool autoChecked)
+{
+    d->autoChecked = autoChecked;
+}
+
+bool BaseToolButtonPolicy::getAutoChecked() const
+{
+    return d->autoChecked;
+}
+
+void BaseToolButtonPolicy::setAntiShakeEnabled(bool antiShakeEnabled)
+{
+    d->antiShakeEnabled = antiShakeEnabled;
+}
+
+bool BaseToolButtonPolicy::getAntiShakeEnabled() const
+{
+    return d->antiShakeEnabled;
+}
+
+void BaseToolButtonPolicy::setAntiShakeWindowMs(uint antiShakeMs)
+{
+    d->antiShakeWindowMs = antiShakeMs;
+}
+
+uint BaseToolButtonPolicy::getAntiShakeWindowMs() const
+{
+    return d->antiShakeWindowMs;
+}
+
+void BaseToolButtonPolicy::setAntiShakePolicy(BaseDebounce::Policy policy)
+{
+    d->antiShakePolicy = policy;
+}
+
+BaseDebounce::Policy BaseToolButtonPolicy::getAntiShakePolicy() const
+{
+    return d->antiShakePolicy;
+}
+
+void BaseToolButtonPolicy::setLongPressEnabled(bool longPressEnabled)
+{
+    d->longPressEnabled = longPressEnabled;
+}
+
+bool BaseToolButtonPolicy::getLongPressEnabled() const
+{
+    return d->longPressEnabled;
+}
+
+void BaseToolButtonPolicy::setLongPressRespondMs(uint longPressRespondMs)
+{
+    d->longPressRespondMs = longPressRespondMs;
+}
+
+uint BaseToolButtonPolicy::getLongPressRespondMs() const
+{
+    return d->longPressRespondMs;
+}
+
+void BaseToolButtonPolicy::setLongPressMaxMs(uint longPressMaxMs)
+{
+    d->longPressMaxMs = longPressMaxMs;
+}
+
+uint BaseToolButtonPolicy::getLongPressMaxMs() const
+{
+    return d->longPressMaxMs;
+}
+/*
+ *@brief:   设置长按加速曲线
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   longPressMinRespondMs:加速后的最小响应间隔 ms
+ *@param:   longPressRampFactor:缩放系数(0,1) 大于等于1时不加速
+ */
+void BaseToolButtonPolicy::setLongPressRamp(uint longPressMinRespondMs, qreal longPressRampFactor)
+{
+    d->longPressMinRespondMs = qMax(longPressMinRespondMs,1u);
+    d->longPressRampFactor = (longPressRampFactor > 0 && longPressRampFactor < 1)?
+                longPressRampFactor:1.0;
+}
+
+uint BaseToolButtonPolicy::getLongPressMinRespondMs() const
+{
+    return d->longPressMinRespondMs;
+}
+
+qreal BaseToolButtonPolicy::getLongPressRampFactor() const
+{
+    return d->longPressRampFactor;
+}
+
+void BaseToolButtonPolicy::setLongPressMaxRate(uint longPressMaxRate)
+{
+    d->longPressMaxRate = longPressMaxRate;
+}
+
+uint BaseToolButtonPolicy::getLongPressMaxRate() const
+{
+    return d->longPressMaxRate;
+}
@@ -0,0 +1,70 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  基类工具按钮的行为策略(共享，按钮单独修改时写时复制)
+ *
+ * 1.按钮的行为配置(自动check、防抖使能/策略/窗口、长按使能/响应时间/最大时间/加速曲线/限频)原本
+ * 由每个按钮各自保存，而界面中的按钮通常只有少数几种相同的配置。这里将这些配置放到共享的策略对象中，
+ * 按钮只保存一个指针；按下时刻、长按计时等运行状态仍然保存在各按钮中。策略同时作为按钮状态机核心
+ * (BaseButtonCore)的配置，核心判断防抖和长按时直接读取策略，不再复制一份参数。
+ * 2.该类使用QExplicitlySharedDataPointer实现显式共享:复制策略对象得到的是同一份数据，通过任意一个
+ * 副本修改都会作用到所有使用该策略的按钮(如统一调整防抖窗口)；需要独立的副本时使用clone()。
+ * 3.通过BaseToolButton的setBtnXxx()接口单独修改某个按钮时，按钮先复制一份私有的策略数据再修改
+ * (写时复制)，不影响共享该策略的其他按钮。
+ * 注:按钮名称(btnName)用于标识单个按钮，各按钮互不相同，所以不放在策略中。
+ */
+#ifndef BASETOOLBUTTONPOLICY_H
+#define BASETOOLBUTTONPOLICY_H
+
+#include <QExplicitlySharedDataPointer>
+#include "basedebounce.h"
+
+class BaseToolButtonPolicyData;
+
+class BaseToolButtonPolicy
+{
+public:
+    BaseToolButtonPolicy();
+    BaseToolButtonPolicy(const BaseToolButtonPolicy &other);
+    BaseToolButtonPolicy &operator=(const BaseToolButtonPolicy &other);
+    ~BaseToolButtonPolicy();
+
+    BaseToolButtonPolicy clone() const;//复制一份独立的策略
+    void detach();//与其他副本分离(数据被共享时复制一份)
+    bool isSharedWith(const BaseToolButtonPolicy &other) const;//是否与other共享同一份数据
+    static int dataSize();//策略数据的字节数
+
+    //设置/获取是否可以自动(通过点击)切换check状态
+    void setAutoChecked(bool autoChecked);
+    bool getAutoChecked() const;
+    //设置/获取防抖属性
+    void setAntiShakeEnabled(bool antiShakeEnabled);
+    bool getAntiShakeEnabled() const;
+    void setAntiShakeWindowMs(uint antiShakeMs);
+    uint getAntiShakeWindowMs() const;
+    void setAntiShakePolicy(BaseDebounce::Policy policy);
+    BaseDebounce::Policy getAntiShakePolicy() const;
+    //设置/获取长按属性
+    void setLongPressEnabled(bool longPressEnabled);
+    bool getLongPressEnabled() const;
+    void setLongPressRespondMs(uint longPressRespondMs);
+    uint getLongPressRespondMs() const;
+    void setLongPressMaxMs(uint longPressMaxMs);
+    uint getLongPressMaxMs() const;
+    void setLongPressRamp(uint longPressMinRespondMs,qreal longPressRampFactor);
+    uint getLongPressMinRespondMs() const;
+    qreal getLongPressRampFactor() const;
+    void setLongPressMaxRate(uint longPressMaxRate);
+    uint getLongPressMaxRate() const;
+
+private:
+    QExplicitlySharedDataPointer<BaseToolButtonPolicyData> d;
+};
+
+#endif // BASETOOLBUTTONPOLICY_H
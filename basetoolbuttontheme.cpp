@@ -0,0 +1,158 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  基类工具按钮的主题(隐式共享)
+ */
+#include "basetoolbuttontheme.h"
+#include <QAtomicInt>
+
+static QAtomicInt themeSerial(0);//主题内容标识计数
+
+//主题共享数据
+class BaseToolButtonThemeData : public QSharedData
+{
+public:
+    BaseToolButtonThemeData()
+    {
+        //与BTN_STYLE样式表效果一致
+        radius = 5;
+        for(int i=0;i<BaseToolButtonTheme::StateCount;i++)
+        {
+            padding[i] = 2;
+            textColor[i] = QColor(Qt::black);
+            backgroundColor[i] = QColor(Qt::lightGray);
+        }
+        padding[BaseToolButtonTheme::Pressed] = 6;
+        padding[BaseToolButtonTheme::Checked] = 6;
+        backgroundColor[BaseToolButtonTheme::Pressed] = QColor(255,165,0);//orange
+        backgroundColor[BaseToolButtonTheme::Checked] = QColor(255,165,0);
+        textColor[BaseToolButtonTheme::Disabled] = QColor(Qt::white);
+        serial = themeSerial.fetchAndAddRelaxed(1)+1;
+    }
+
+    int radius;//边角弧度半径
+    int padding[BaseToolButtonTheme::StateCount];//各状态的填充宽度
+    QColor textColor[BaseToolButtonTheme::StateCount];//各状态的前景色
+    QColor backgroundColor[BaseToolButtonTheme::StateCount];//各状态的背景色
+    quint32 serial;//内容标识
+};
+
+/*
+ *@brief:   构造函数(默认主题)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+BaseToolButtonTheme::BaseToolButtonTheme()
+    :d(new BaseToolButtonThemeData)
+{
+}
+
+BaseToolButtonTheme::BaseToolButtonTheme(const BaseToolButtonTheme &other)
+    :d(other.d)
+{
+}
+
+BaseToolButtonTheme &BaseToolButtonTheme::operator=(const BaseToolButtonTheme &other)
+{
+    d = other.d;
+    return *this;
+}
+
+BaseToolButtonTheme::~BaseToolButtonTheme()
+{
+}
+/*
+ *@brief:   设置/获取边角弧度半径
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   radius:半径
+ */
+void BaseToolButtonTheme::setRadius(int radius)
+{
+    d->radius = radius;//非const访问会触发写时复制
+    d->serial = themeSerial.fetchAndAddRelaxed(1)+1;
+}
+
+int BaseToolButtonTheme::getRadius() const
+{
+    return d->radius;
+}
+/*
+ *@brief:   设置/获取某状态的填充宽度
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   state:按钮状态
+ *@param:   padding:填充宽度
+ */
+void BaseToolButtonTheme::setPadding(State state, int padding)
+{
+    if(state < Normal || state >= StateCount)
+    {
+        return;
+    }
+    d->padding[state] = padding;
+    d->serial = themeSerial.fetchAndAddRelaxed(1)+1;
+}
+
+int BaseToolButtonTheme::getPadding(State state) const
+{
+    return (state >= Normal && state < StateCount)?d->padding[state]:0;
+}
+/*
+ *@brief:   设置/获取某状态的背景色
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   state:按钮状态
+ *@param:   color:背景色
+ */
+void BaseToolButtonTheme::setBackgroundColor(State state, const QColor &color)
+{
+    if(state < Normal || state >= StateCount)
+    {
+        return;
+    }
+    d->backgroundColor[state] = color;
+    d->serial = themeSerial.fetchAndAddRelaxed(1)+1;
+}
+
+QColor BaseToolButtonTheme::getBackgroundColor(State state) const
+{
+    return (state >= Normal && state < StateCount)?d->backgroundColor[state]:QColor();
+}
+/*
+ *@brief:   设置/获取某状态的前景(文本)色
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   state:按钮状态
+ *@param:   color:前景色
+ */
+void BaseToolButtonTheme::setTextColor(State state, const QColor &color)
+{
+    if(state < Normal || state >= StateCount)
+    {
+        return;
+    }
+    d->textColor[state] = color;
+    d->serial = themeSerial.fetchAndAddRelaxed(1)+1;
+}
+
+QColor BaseToolButtonTheme::getTextColor(State state) const
+{
+    return (state >= Normal && state < StateCount)?d->textColor[state]:QColor();
+}
+/*
+ *@brief:   获取主题内容标识，共享同一份数据的主题副本标识相同，任一属性修改后标识改变
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  quint32:内容标识
+ */
+quint32 BaseToolButtonTheme::cacheKey() const
+{
+    return d->serial;
+}
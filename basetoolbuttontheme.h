@@ -0,0 +1,65 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  基类工具按钮的主题(隐式共享)
+ *
+ * 1.为每个按钮调用setStyleSheet()会让按钮经过QStyleSheetStyle的样式表解析、polish以及规则匹配，
+ * 按钮较多时这部分开销在启动和重绘中占主要部分。这里提供一个轻量的主题对象，描述按钮的边角弧度以及
+ * normal/pressed/checked/disabled四种状态下的填充宽度、前景色和背景色，由BaseToolButton::paintEvent()
+ * 直接绘制，不经过样式表。
+ * 2.该类使用QSharedDataPointer实现隐式共享(写时复制)，多个按钮使用同一主题时只共享一份数据，复制代价
+ * 只是一个指针。
+ * 3.默认主题与basetoolbutton.cpp中的BTN_STYLE样式表效果一致。
+ */
+#ifndef BASETOOLBUTTONTHEME_H
+#define BASETOOLBUTTONTHEME_H
+
+#include <QColor>
+#include <QSharedDataPointer>
+
+class BaseToolButtonThemeData;
+
+class BaseToolButtonTheme
+{
+public:
+    //按钮状态
+    enum State
+    {
+        Normal = 0,//正常
+        Pressed,//按下
+        Checked,//选中
+        Disabled,//禁用
+        StateCount
+    };
+
+    BaseToolButtonTheme();
+    BaseToolButtonTheme(const BaseToolButtonTheme &other);
+    BaseToolButtonTheme &operator=(const BaseToolButtonTheme &other);
+    ~BaseToolButtonTheme();
+
+    //设置/获取边角弧度半径
+    void setRadius(int radius);
+    int getRadius() const;
+    //设置/获取各状态的填充宽度(控制content区域大小)
+    void setPadding(State state,int padding);
+    int getPadding(State state) const;
+    //设置/获取各状态的背景色
+    void setBackgroundColor(State state,const QColor &color);
+    QColor getBackgroundColor(State state) const;
+    //设置/获取各状态的前景(文本)色
+    void setTextColor(State state,const QColor &color);
+    QColor getTextColor(State state) const;
+
+    quint32 cacheKey() const;//主题内容标识，内容相同的主题副本标识相同，修改后标识改变
+
+private:
+    QSharedDataPointer<BaseToolButtonThemeData> d;
+};
+
+#endif // BASETOOLBUTTONTHEME_H
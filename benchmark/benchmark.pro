@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# BaseToolButton热点路径的基准测试(QtTest QBENCHMARK)
+# 默认使用offscreen平台运行，结果同时输出到终端和benchmark_result.xml
+#
+#-------------------------------------------------
+
+QT       += core gui testlib
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = tst_basetoolbutton
+TEMPLATE = app
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+include(../basetoolbutton.pri)
+
+DEFINES += BENCH_IMAGES_DIR=\\\"$$PWD/../images\\\"
+
+SOURCES += tst_basetoolbutton.cpp
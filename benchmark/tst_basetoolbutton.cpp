@@ -0,0 +1,2458 @@
+/*
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@brief:   BaseToolButton热点路径的基准测试
+ *
+ * 1.覆盖按钮构造、setBtnIcon(是否scaledUp)、setBtnIcons(并验证图标缓存BaseIconCache按LRU淘汰、不超过内存预算、
+ * 命中/未命中计数正确，且缓存随应用程序析构)、
+ * 异步加载(BaseIconLoader)单状态/多状态图标的完成、相同图标请求的合并、按钮析构或重新设置图标时取消请求，
+ * 以及加载失败的图标不缓存(文件出现后可以重新加载)、带防抖和长按(及开启统计)的按下/释放事件分发
+ * (并验证统计的计数、分位数快照和JSON导出)、
+ * QButtonGroup/BaseButtonGroup单选切换(逐个成员统计toggled信号，验证只有旧的和新的选中按钮改变状态)，样式表/非样式表按钮的paintEvent，以及长文本标签的绘制(样式每次重绘重新排版
+ * 与缓存的QStaticText对比)，以及每个按钮持有QIcon与从共享图集(BaseIconAtlas)绘制图标的内存和绘制耗时。
+ * 长按的加速曲线、限频在虚拟时钟下的信号序列，以及合并投递中继(BaseLatestRelay)只投递最新值、释放后丢弃
+ * 旧值、一个中继只能由一个按钮使用。
+ * 开启渲染缓存(BaseRenderCache)时外观相同的按钮命中同一份外观，文本/尺寸/字体/状态/布局方向改变后不再命中旧的外观，
+ * 外观哈希碰撞时比较完整的外观数据。
+ * 轻量按钮面板(BaseButtonPanel)的命中测试(含间距区域)、互斥分组(组号超过16位)、防抖及长按信号序列。
+ * 2.另外通过QTest::touchEvent注入触摸序列，验证按钮直接处理触摸事件时的信号语义(单击、防抖、多点同时按住)。
+ * 动画驱动(BaseAnimationDriver)测量N个按钮同时显示长按进度环时每帧的耗时，并验证动画结束后帧定时器停止。
+ * 3.通过管道模拟外部按键输入源(BaseInputSource)，验证按键按名称/按钮组/按钮指针路由到按钮并发出clicked，
+ * 事件时间戳与Qt输入事件使用同一单调时钟；队列满时只丢弃按下，已按下按键的释放不会丢失；evdev事件丢失
+ * (SYN_DROPPED)后重新同步，补发的释放只释放按钮。
+ * 4.用mallinfo统计共享/独立行为策略(BaseToolButtonPolicy)下10000个按钮实际占用的堆内存(每个按钮的绝对值，
+ * 同一测试中测量两种布局并比较)，并验证策略的写时复制。声明式加载器(BaseButtonLoader)在页面第一次显示时才创建按钮，JSON/CBOR
+ * 描述结果一致，重新加载时替换已创建的按钮(包括在按钮的clicked响应中重新加载)。
+ * 5.录制的输入在虚拟时钟下回放(BaseInputReplayer)，与标准轨迹比较防抖和长按的信号序列，并验证原速与最快
+ * 速度回放的轨迹相同，按下期间移出/移回按钮的事件回放后长按停止、移回后仍可单击；同时测量最快速度回放大量事件的吞吐。
+ * 6.不依赖界面的按钮状态机核心(BaseButtonCore)在虚拟时钟下的防抖/长按/自动选中序列(核心直接读取配置，以共享
+ * 策略为配置时只保存运行状态)，以及不同编译期特性组合下每秒可处理的状态转换(按下+推进+释放)次数。
+ * 按钮在虚拟时钟下的后沿防抖序列(抖动期间的按下重新开始窗口)，以及按钮组共享防抖窗口(BaseDebounceGroup)
+ * 时组内任一按钮被响应后整个组进入窗口，组外按钮不受影响。
+ * 7.多个后台线程通过BaseButtonUpdater无锁写入按钮的选中/使能/文本状态，验证每帧批量应用后各按钮为最后写入
+ * 的值且写入数等于应用数加合并数；并对比GUI线程逐次设置与写入后批量应用的耗时(含重绘)。
+ * 8.将测试图标打包为预解码的图标包(BaseIconBundle)，验证包中的像素与解码路径一致、图片直接引用映射的
+ * 内存，截断或偏移损坏的图标包无法打开，并对比启动时N个按钮设置三态图标的耗时(冷缓存解码与映射图标包)。
+ * 9.有Qt Quick模块时，比较1000个按钮的场景图版本(BaseQuickButton)与控件版本绘制整个窗口的耗时，
+ * 场景图默认使用软件后端(没有GPU的机器同样可以运行)。并向QQuickWindow发送鼠标事件，验证场景图版本
+ * 的自动选中、防抖丢弃、长按信号序列、按下后移出、releaseBtn()以及禁用图标的选择与控件版本一致。
+ * 10.未指定QT_QPA_PLATFORM时默认使用offscreen平台运行；未通过-o指定输出时，结果同时输出到终端和
+ * benchmark_result.xml(QtTest的xml格式)，方便跨版本跟踪性能趋势。
+ */
+#include <QtTest>
+#include <QApplication>
+#include <QButtonGroup>
+#include <QThread>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include "basetoolbutton.h"
+#include "baseiconcache.h"
+#include "baseiconloader.h"
+#include "baseiconatlas.h"
+#include "basetimerwheel.h"
+#include "basebuttonpanel.h"
+#include "basebuttonstats.h"
+#include "baseinputsource.h"
+#include "basebuttongroup.h"
+#include "baseanimationdriver.h"
+#include "baseinputrecorder.h"
+#include "basebuttoncore.h"
+#include "basebuttonupdater.h"
+#include "baseiconbundle.h"
+#include "baserendercache.h"
+#include "basebuttonloader.h"
+#ifdef BASE_QUICK_BUTTON
+#include <QQuickWindow>
+#include "basequickbutton.h"
+#endif
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+#ifdef Q_OS_LINUX
+#include <malloc.h>
+#include <linux/input.h>
+#endif
+#if QT_VERSION >= QT_VERSION_CHECK(5,12,0)
+#include <QCborValue>
+#endif
+
+#define BENCH_ICON_1 BENCH_IMAGES_DIR "/1.ico"
+#define BENCH_ICON_2 BENCH_IMAGES_DIR "/2.ico"
+#define BENCH_ICON_3 BENCH_IMAGES_DIR "/3.ico"
+#define BENCH_ICON_4 BENCH_IMAGES_DIR "/4.ico"
+#define BENCH_STYLE "QToolButton{border-radius:5px;padding:2px;color:black;background-color:lightGray}"\
+    "QToolButton:pressed{background-color:orange}"\
+    "QToolButton:checked{background-color:blue}"
+
+class BaseToolButtonBenchmark : public QObject
+{
+    Q_OBJECT
+
+private:
+    void sendMouseEvent(QWidget *widget,QEvent::Type type,ulong timestamp,const QPointF &pos = QPointF(5,5));
+    QByteArray goldenRecord();
+    qreal measureButtonHeap(int btnCount,bool detached);
+#ifdef BASE_QUICK_BUTTON
+    void sendQuickMouseEvent(QQuickWindow *window,QEvent::Type type,ulong timestamp,const QPointF &pos);
+#endif
+#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
+    QPointingDevice *touchDevice;
+#else
+    QTouchDevice *touchDevice;
+#endif
+
+private slots:
+    void initTestCase();
+    void construction_data();
+    void construction();
+    void panelConstruction_data();
+    void panelConstruction();
+    void panelInput();
+    void loaderPages();
+    void setBtnIcon_data();
+    void setBtnIcon();
+    void setBtnIcons_data();
+    void setBtnIcons();
+    void iconCacheLru();
+    void iconLoaderAsync();
+    void pressRelease_data();
+    void pressRelease();
+    void statsSnapshot();
+    void longPressTimerCount_data();
+    void longPressTimerCount();
+    void longPressRampRateLimit();
+    void longPressRelay();
+    void groupExclusiveSwitch_data();
+    void groupExclusiveSwitch();
+    void groupBulkCheck_data();
+    void groupBulkCheck();
+    void memoryPerButton_data();
+    void memoryPerButton();
+    void paint_data();
+    void paint();
+    void renderCacheHits();
+    void paintLabel_data();
+    void paintLabel();
+    void iconMemory_data();
+    void iconMemory();
+    void paintIcon_data();
+    void paintIcon();
+    void atlasClear();
+    void animationFrame_data();
+    void animationFrame();
+    void touchTap();
+    void touchAntiShake();
+    void touchMultiPress();
+    void feedbackIdle();
+    void inputSourceRoute();
+    void inputSourceOverflow();
+    void inputSourceResync();
+    void replayGoldenTrace();
+    void replayDragOut();
+    void replayThroughput_data();
+    void replayThroughput();
+    void coreStateMachine();
+    void debounceThrottle();
+    void debounceTrailingGroup();
+    void coreTransitions_data();
+    void coreTransitions();
+    void updaterThreads();
+    void batchedUpdates_data();
+    void batchedUpdates();
+    void iconBundle();
+    void iconStartup_data();
+    void iconStartup();
+    void quickVsWidget_data();
+    void quickVsWidget();
+    void quickButtonInput();
+};
+
+/*
+ *@brief:   获取当前已分配的堆内存(glibc的mallinfo，只统计主分配区)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  qint64:已分配的字节数 不支持时返回-1
+ */
+static qint64 heapAllocatedBytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return qint64(info.uordblks);
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    return qint64(uint(info.uordblks));
+#else
+    return -1;
+#endif
+}
+
+//状态机核心测试用的虚拟时钟
+struct BenchVirtualClock
+{
+    static qint64 nowMs(){return currentMs;}
+    static qint64 currentMs;
+};
+qint64 BenchVirtualClock::currentMs = 0;
+
+//加载器测试用:在按钮的信号响应中重新加载页面描述
+class BenchLoaderReloader : public QObject
+{
+    Q_OBJECT
+public:
+    BenchLoaderReloader(BaseButtonLoader *loader,const QByteArray &description)
+        :reloadCount(0),loader(loader),description(description){}
+
+    int reloadCount;
+
+public slots:
+    void reloadSlot()
+    {
+        if(loader->loadDescription(description))
+        {
+            reloadCount++;
+        }
+    }
+
+private:
+    BaseButtonLoader *loader;
+    QByteArray description;
+};
+
+//批量更新测试用的写线程 每个线程只写入自己的一组按钮，最后写入的值是确定的
+class BenchUpdateWriter : public QThread
+{
+public:
+    BenchUpdateWriter(BaseButtonUpdater *updater,int firstIndex,int btnCount,int count)
+        :updater(updater),firstIndex(firstIndex),btnCount(btnCount),count(count){}
+
+protected:
+    virtual void run()
+    {
+        for(int i=0;i<count;i++)
+        {
+            int index = firstIndex+i%btnCount;
+            updater->postText(index,QString::number(i));
+            updater->postChecked(index,i%2 == 1);
+            updater->postEnabled(index,i%3 != 0);
+        }
+    }
+
+private:
+    BaseButtonUpdater *updater;
+    int firstIndex;
+    int btnCount;
+    int count;
+};
+
+/*
+ *@brief:   驱动状态机核心完成指定次数的按下/推进/释放 每次按下间隔大于防抖窗口，每16次有一次长按
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   count:次数
+ *@return:  uint:所有事件掩码的计数和(防止被编译器优化掉)
+ */
+template <uint Features>
+static uint runCoreTransitions(int count)
+{
+    BaseButtonCore<BenchVirtualClock,Features> core;
+    uint eventCount = 0;
+    qint64 timestampMs = 1;
+    for(int i=0;i<count;i++)
+    {
+        eventCount += core.press(timestampMs);
+        timestampMs += (i%16 == 0)?3500:50;
+        eventCount += core.advance(timestampMs);
+        eventCount += core.release(true);
+        timestampMs += 200;
+    }
+    return eventCount;
+}
+
+/*
+ *@brief:   向按钮(或面板)发送一个带时间戳的左键鼠标事件
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   widget:按钮或面板
+ *@param:   type:事件类型(按下/按住左键移动/释放)
+ *@param:   timestamp:事件时间戳 ms
+ *@param:   pos:部件坐标系中的位置
+ */
+void BaseToolButtonBenchmark::sendMouseEvent(QWidget *widget, QEvent::Type type, ulong timestamp,
+                                             const QPointF &pos)
+{
+    Qt::MouseButton button = (type == QEvent::MouseMove)?Qt::NoButton:Qt::LeftButton;
+    Qt::MouseButtons buttons = (type == QEvent::MouseButtonRelease)?Qt::NoButton:Qt::LeftButton;
+    QMouseEvent mouseEvent(type,pos,button,buttons,Qt::NoModifier);
+    mouseEvent.setTimestamp(timestamp);
+    QCoreApplication::sendEvent(widget,&mouseEvent);
+}
+/*
+ *@brief:   向Qt Quick窗口发送指定时间戳的鼠标事件(由窗口分发给按钮)
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   window:窗口
+ *@param:   type:事件类型 按下/移动/释放(移动时按住左键)
+ *@param:   timestamp:事件时间戳
+ *@param:   pos:窗口坐标
+ */
+#ifdef BASE_QUICK_BUTTON
+void BaseToolButtonBenchmark::sendQuickMouseEvent(QQuickWindow *window, QEvent::Type type, ulong timestamp,
+                                                  const QPointF &pos)
+{
+    Qt::MouseButton button = (type == QEvent::MouseMove)?Qt::NoButton:Qt::LeftButton;
+    Qt::MouseButtons buttons = (type == QEvent::MouseButtonRelease)?Qt::NoButton:Qt::LeftButton;
+    QMouseEvent mouseEvent(type,pos,window->mapToGlobal(pos.toPoint()),button,buttons,Qt::NoModifier);
+    mouseEvent.setTimestamp(timestamp);
+    QCoreApplication::sendEvent(window,&mouseEvent);
+}
+#endif
+/*
+ *@brief:   生成回放测试用的录制数据 通过事件过滤器录制鼠标事件，在按钮外释放的事件直接追加
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@return:  QByteArray:录制数据
+ */
+QByteArray BaseToolButtonBenchmark::goldenRecord()
+{
+    BaseToolButton btnK;
+    btnK.setBtnName("k");
+    btnK.resize(60,60);
+    BaseToolButton btnJ;
+    btnJ.setBtnName("j");
+    btnJ.resize(60,60);
+    BaseInputRecorder recorder;
+    recorder.addButton(&btnK);
+    recorder.addButton(&btnJ);
+    //单击、防抖窗口内的重复点击、长按后释放
+    sendMouseEvent(&btnK,QEvent::MouseButtonPress,1000);
+    sendMouseEvent(&btnK,QEvent::MouseButtonRelease,1050);
+    sendMouseEvent(&btnK,QEvent::MouseButtonPress,1100);
+    sendMouseEvent(&btnK,QEvent::MouseButtonRelease,1150);
+    sendMouseEvent(&btnK,QEvent::MouseButtonPress,1400);
+    sendMouseEvent(&btnK,QEvent::MouseButtonRelease,2700);
+    //长按未到时间即移出按钮释放
+    sendMouseEvent(&btnK,QEvent::MouseButtonPress,2800);
+    recorder.appendEvent("k",BaseInputRecorder::ReleaseOutside,2900);
+    sendMouseEvent(&btnJ,QEvent::MouseButtonPress,2950);
+    sendMouseEvent(&btnJ,QEvent::MouseButtonRelease,2960);
+    return recorder.data();
+}
+void BaseToolButtonBenchmark::initTestCase()
+{
+    touchDevice = QTest::createTouchDevice();
+}
+//构造N个按钮
+void BaseToolButtonBenchmark::construction_data()
+{
+    QTest::addColumn<int>("btnCount");
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void BaseToolButtonBenchmark::construction()
+{
+    QFETCH(int,btnCount);
+    QBENCHMARK
+    {
+        QWidget parentWidget;
+        for(int i=0;i<btnCount;i++)
+        {
+            BaseToolButton *btn = new BaseToolButton(&parentWidget);
+            btn->setText("key");
+        }
+    }
+}
+//构造包含N个单元格的轻量按钮面板(与construction对比)
+void BaseToolButtonBenchmark::panelConstruction_data()
+{
+    construction_data();
+}
+
+void BaseToolButtonBenchmark::panelConstruction()
+{
+    QFETCH(int,btnCount);
+    QBENCHMARK
+    {
+        BaseButtonPanel panel;
+        panel.setPanelGrid(btnCount/10,10);
+        for(int i=0;i<panel.getCellCount();i++)
+        {
+            panel.setCellText(i,"key");
+        }
+    }
+}
+//面板的命中测试、互斥分组、防抖和长按 单元格98x48，间距4
+void BaseToolButtonBenchmark::panelInput()
+{
+    BaseTimerWheel *wheel = BaseTimerWheel::instance();
+    QTRY_COMPARE(wheel->activeCount(),0);
+    BaseButtonPanel panel;
+    panel.setPanelGrid(2,2);
+    panel.setPanelSpacing(4);
+    panel.resize(208,108);
+    QCOMPARE(panel.cellAt(QPoint(5,5)),0);
+    QCOMPARE(panel.cellAt(QPoint(107,5)),1);
+    QCOMPARE(panel.cellAt(QPoint(5,60)),2);
+    QCOMPARE(panel.cellAt(QPoint(200,100)),3);
+    QCOMPARE(panel.cellAt(QPoint(3,3)),-1);//左上间距
+    QCOMPARE(panel.cellAt(QPoint(103,5)),-1);//列间距
+    QCOMPARE(panel.cellAt(QPoint(5,53)),-1);//行间距
+    QCOMPARE(panel.cellAt(QPoint(300,5)),-1);
+    QCOMPARE(panel.cellRect(3),QRect(106,56,98,48));
+    QSignalSpy pressedSpy(&panel,SIGNAL(cellPressed(int)));
+    QSignalSpy clickedSpy(&panel,SIGNAL(cellClicked(int)));
+    QSignalSpy toggledSpy(&panel,SIGNAL(cellToggled(int,bool)));
+    QSignalSpy longPressSpy(&panel,SIGNAL(longPressSig(int,uint)));
+    wheel->setVirtualClock(true,400000);
+
+    //互斥分组:组号超过16位也不会截断，选中新单元格时取消旧单元格，点击已选中的单元格保持选中
+    const int groupId = 70000;
+    for(int i=0;i<2;i++)
+    {
+        panel.setCellCheckable(i,true);
+        panel.setCellGroup(i,groupId);
+    }
+    panel.setCellCheckable(2,true);
+    panel.setCellGroup(2,groupId-65536);//截断为16位时与groupId相同
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,400000,QPointF(5,5));
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,400050,QPointF(5,5));
+    QVERIFY(panel.isCellChecked(0));
+    QCOMPARE(panel.getCheckedCell(groupId),0);
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,400100,QPointF(107,5));
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,400150,QPointF(107,5));
+    QVERIFY(!panel.isCellChecked(0));
+    QVERIFY(panel.isCellChecked(1));
+    QCOMPARE(panel.getCheckedCell(groupId),1);
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,400200,QPointF(107,5));
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,400250,QPointF(107,5));
+    QVERIFY(panel.isCellChecked(1));
+    //其他组的单元格不受影响
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,400300,QPointF(5,60));
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,400350,QPointF(5,60));
+    QVERIFY(panel.isCellChecked(1));
+    QVERIFY(panel.isCellChecked(2));
+    QCOMPARE(toggledSpy.count(),4);//0选中 0取消 1选中 2选中
+    QCOMPARE(clickedSpy.count(),4);
+    //在间距区域按下不命中任何单元格
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,400400,QPointF(103,5));
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,400450,QPointF(103,5));
+    QCOMPARE(pressedSpy.count(),4);
+
+    //防抖:窗口内的按下被丢弃
+    panel.setCellAntiShakeProperty(3,true,200);
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,401000,QPointF(200,100));
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,401050,QPointF(200,100));
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,401100,QPointF(200,100));
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,401150,QPointF(200,100));
+    QCOMPARE(pressedSpy.count(),5);
+    QCOMPARE(clickedSpy.count(),5);
+
+    //长按:每100ms响应一次，到300ms结束；在单元格外释放不点击
+    panel.setCellLongPressProperty(3,true,100,300);
+    wheel->advanceTo(402000);
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,402000,QPointF(200,100));
+    wheel->advanceTo(402500);
+    QCOMPARE(longPressSpy.count(),3);
+    for(int i=0;i<3;i++)
+    {
+        QCOMPARE(longPressSpy.at(i).at(0).toInt(),3);
+        QCOMPARE(longPressSpy.at(i).at(1).toUInt(),uint(100*(i+1)));
+    }
+    QCOMPARE(wheel->activeCount(),0);
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,402500,QPointF(300,100));
+    QCOMPARE(clickedSpy.count(),5);
+    //按下后移出单元格时停止长按
+    wheel->advanceTo(403000);
+    sendMouseEvent(&panel,QEvent::MouseButtonPress,403000,QPointF(200,100));
+    wheel->advanceTo(403150);
+    sendMouseEvent(&panel,QEvent::MouseMove,403150,QPointF(5,5));
+    wheel->advanceTo(404000);
+    QCOMPARE(longPressSpy.count(),4);
+    QCOMPARE(wheel->activeCount(),0);
+    sendMouseEvent(&panel,QEvent::MouseButtonRelease,404000,QPointF(5,5));
+    QCOMPARE(clickedSpy.count(),5);
+    wheel->setVirtualClock(false);
+}
+//声明式加载:页面第一次显示时才创建，JSON与CBOR描述结果一致，组号/组内id正确，重新加载已创建的页面时替换按钮
+void BaseToolButtonBenchmark::loaderPages()
+{
+    const QByteArray jsonData = "{\"pages\":["
+            "{\"name\":\"main\",\"columns\":2,\"buttons\":["
+            "{\"name\":\"k1\",\"text\":\"1\",\"checkable\":true,\"group\":1,\"groupId\":3},"
+            "{\"name\":\"k2\",\"text\":\"2\",\"checkable\":true,\"group\":1,\"groupId\":4},"
+            "{\"name\":\"k3\",\"text\":\"3\",\"antiShake\":100}]},"
+            "{\"name\":\"other\",\"buttons\":[{\"name\":\"o1\",\"text\":\"o\"}]}]}";
+    QWidget window;
+    QWidget *mainPage = new QWidget(&window);
+    QWidget *otherPage = new QWidget(&window);
+    otherPage->hide();
+    BaseButtonLoader loader;
+    QVERIFY(loader.loadDescription(jsonData));
+    QCOMPARE(loader.getPageNames(),QStringList()<<"main"<<"other");
+    QVERIFY(loader.bindPage("main",mainPage));
+    QVERIFY(loader.bindPage("other",otherPage));
+    QSignalSpy pageBuiltSpy(&loader,SIGNAL(pageBuilt(QString,qint64,int)));
+    //容器显示之前不创建按钮
+    QCOMPARE(loader.getPageBuildTime("main"),qint64(-1));
+    QVERIFY(loader.getPageButtons("main").isEmpty());
+    QVERIFY(loader.findButton("k1") == NULL);
+
+    window.show();
+    QCOMPARE(pageBuiltSpy.count(),1);
+    QList<QVariant> arguments = pageBuiltSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toString(),QString("main"));
+    QVERIFY(arguments.at(1).toLongLong() > 0);
+    QCOMPARE(arguments.at(1).toLongLong(),loader.getPageBuildTime("main"));
+    QCOMPARE(arguments.at(2).toInt(),3);
+    QCOMPARE(loader.getPageBuildTime("other"),qint64(-1));
+    BaseToolButton *btn1 = loader.findButton("k1");
+    BaseToolButton *btn2 = loader.findButton("k2");
+    QVERIFY(btn1 != NULL && btn2 != NULL);
+    QVERIFY(btn1->isVisible());
+    QButtonGroup *btnGroup = loader.getPageGroup("main",1);
+    QVERIFY(btnGroup != NULL);
+    QCOMPARE(btnGroup->buttons().size(),2);
+    QCOMPARE(btnGroup->id(btn1),3);
+    QCOMPARE(btnGroup->id(btn2),4);
+    QVERIFY(loader.findButton("k3")->group() == NULL);
+    //第二个页面在其容器显示时创建
+    otherPage->show();
+    QCOMPARE(pageBuiltSpy.count(),1);
+    QCOMPARE(pageBuiltSpy.takeFirst().at(0).toString(),QString("other"));
+    QVERIFY(loader.findButton("o1") != NULL);
+    QVERIFY(!loader.bindPage("other",otherPage));
+
+#if QT_VERSION >= QT_VERSION_CHECK(5,12,0)
+    //同一描述的CBOR格式创建的按钮与JSON一致
+    QByteArray cborData = QCborValue::fromJsonValue(QJsonDocument::fromJson(jsonData).object()).toCbor();
+    QWidget cborPage;
+    BaseButtonLoader cborLoader;
+    QVERIFY(cborLoader.loadDescription(cborData));
+    QVERIFY(cborLoader.bindPage("main",&cborPage));
+    cborLoader.buildPage("main");
+    QList<BaseToolButton *> jsonButtons = loader.getPageButtons("main");
+    QList<BaseToolButton *> cborButtons = cborLoader.getPageButtons("main");
+    QCOMPARE(cborButtons.size(),jsonButtons.size());
+    for(int i=0;i<cborButtons.size();i++)
+    {
+        QCOMPARE(cborButtons.at(i)->getBtnName(),jsonButtons.at(i)->getBtnName());
+        QCOMPARE(cborButtons.at(i)->text(),jsonButtons.at(i)->text());
+        QCOMPARE(cborButtons.at(i)->isCheckable(),jsonButtons.at(i)->isCheckable());
+    }
+    QCOMPARE(cborLoader.getPageGroup("main",1)->id(cborLoader.findButton("k2")),4);
+#endif
+
+    //重新加载已创建的页面:原来的按钮和按钮组被删除，容器正在显示所以立即按新描述创建
+    QPointer<BaseToolButton> oldBtn = btn1;
+    QPointer<QButtonGroup> oldGroup = btnGroup;
+    QVERIFY(loader.loadDescription(QByteArray("{\"pages\":[{\"name\":\"main\",\"buttons\":["
+                                              "{\"name\":\"n1\",\"group\":2,\"groupId\":7},"
+                                              "{\"name\":\"n2\",\"group\":2,\"groupId\":8}]}]}")));
+    QVERIFY(!oldBtn.isNull() && !oldBtn->isVisible());//延迟删除
+    QCoreApplication::sendPostedEvents(NULL,QEvent::DeferredDelete);
+    QVERIFY(oldBtn.isNull());
+    QVERIFY(oldGroup.isNull());
+    QCOMPARE(pageBuiltSpy.count(),1);
+    QCOMPARE(pageBuiltSpy.takeFirst().at(2).toInt(),2);
+    QCOMPARE(loader.getPageButtons("main").size(),2);
+    QCOMPARE(mainPage->findChildren<BaseToolButton *>().size(),2);
+    QVERIFY(loader.findButton("k1") == NULL);
+    QVERIFY(loader.getPageGroup("main",1) == NULL);
+    QCOMPARE(loader.getPageGroup("main",2)->id(loader.findButton("n2")),8);
+    //未重新加载的页面不受影响
+    QVERIFY(loader.findButton("o1") != NULL);
+
+    //在页面按钮的clicked响应中重新加载该页面:发送者返回后才被删除
+    BenchLoaderReloader reloader(&loader,QByteArray("{\"pages\":[{\"name\":\"main\",\"buttons\":["
+                                                    "{\"name\":\"r1\",\"text\":\"r\"}]}]}"));
+    QPointer<BaseToolButton> clickedBtn = loader.findButton("n1");
+    connect(clickedBtn.data(),SIGNAL(clicked()),&reloader,SLOT(reloadSlot()));
+    QTest::mouseClick(clickedBtn.data(),Qt::LeftButton);
+    QCOMPARE(reloader.reloadCount,1);
+    QVERIFY(loader.findButton("n1") == NULL);
+    QVERIFY(loader.findButton("r1") != NULL);
+    QCoreApplication::sendPostedEvents(NULL,QEvent::DeferredDelete);
+    QVERIFY(clickedBtn.isNull());
+    QCOMPARE(mainPage->findChildren<BaseToolButton *>().size(),1);
+}
+//设置单状态图标 cold为每次都清空图标缓存(即解码路径)
+void BaseToolButtonBenchmark::setBtnIcon_data()
+{
+    QTest::addColumn<bool>("scaledUp");
+    QTest::addColumn<bool>("cold");
+    QTest::newRow("cached") << false << false;
+    QTest::newRow("cached-scaledUp") << true << false;
+    QTest::newRow("cold") << false << true;
+    QTest::newRow("cold-scaledUp") << true << true;
+}
+
+void BaseToolButtonBenchmark::setBtnIcon()
+{
+    QFETCH(bool,scaledUp);
+    QFETCH(bool,cold);
+    BaseToolButton btn;
+    QBENCHMARK
+    {
+        if(cold)
+        {
+            BaseIconCache::instance()->clear();
+        }
+        btn.setBtnIcon(BENCH_ICON_1,QSize(80,80),scaledUp);
+    }
+}
+//设置多状态图标
+void BaseToolButtonBenchmark::setBtnIcons_data()
+{
+    QTest::addColumn<bool>("cold");
+    QTest::newRow("cached") << false;
+    QTest::newRow("cold") << true;
+}
+
+void BaseToolButtonBenchmark::setBtnIcons()
+{
+    QFETCH(bool,cold);
+    BaseToolButton btn;
+    QBENCHMARK
+    {
+        if(cold)
+        {
+            BaseIconCache::instance()->clear();
+        }
+        btn.setBtnIcons(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(60,60));
+    }
+}
+//图标缓存的LRU淘汰、内存预算以及命中/未命中计数
+void BaseToolButtonBenchmark::iconCacheLru()
+{
+    BaseIconCache *iconCache = BaseIconCache::instance();
+    //缓存的父对象为应用程序对象，缓存的图片在QApplication析构前释放
+    QCOMPARE(iconCache->parent(),QCoreApplication::instance());
+    int oldLimit = iconCache->cacheLimit();
+    iconCache->clear();
+    iconCache->resetCounters();
+
+    //同尺寸缩放后的图标开销相同，预算只能容纳两个
+    iconCache->icon(BENCH_ICON_1,QSize(32,32),true);
+    int iconCost = iconCache->cacheCost();
+    QVERIFY(iconCost > 0);
+    iconCache->setCacheLimit(iconCost*2+iconCost/2);
+    iconCache->icon(BENCH_ICON_2,QSize(32,32),true);
+    QCOMPARE(iconCache->cacheCount(),2);
+    QVERIFY(!iconCache->icon(BENCH_ICON_1,QSize(32,32),true).isNull());//命中，1.ico成为最近使用
+    iconCache->icon(BENCH_ICON_3,QSize(32,32),true);//超出预算，淘汰最久未使用的2.ico
+    QCOMPARE(iconCache->cacheCount(),2);
+    QVERIFY(iconCache->cacheCost() <= iconCache->cacheLimit());
+    QIcon icon;
+    QVERIFY(!iconCache->findIcon(BENCH_ICON_2,QSize(32,32),true,&icon));
+    QVERIFY(iconCache->findIcon(BENCH_ICON_1,QSize(32,32),true,&icon));
+    QVERIFY(iconCache->findIcon(BENCH_ICON_3,QSize(32,32),true,&icon));
+    QVERIFY(!icon.isNull());
+    //未命中:1.ico、2.ico、3.ico的解码以及查找2.ico 命中:再次获取1.ico以及查找1.ico、3.ico
+    QCOMPARE(iconCache->hitCount(),quint64(3));
+    QCOMPARE(iconCache->missCount(),quint64(4));
+
+    //降低预算时立即淘汰，超过预算的图标正常返回但不缓存
+    iconCache->setCacheLimit(iconCost);
+    QCOMPARE(iconCache->cacheCount(),1);
+    QVERIFY(iconCache->findIcon(BENCH_ICON_3,QSize(32,32),true,&icon));
+    QVERIFY(!iconCache->icon(BENCH_ICON_4,QSize(64,64),true).isNull());
+    QVERIFY(!iconCache->findIcon(BENCH_ICON_4,QSize(64,64),true,&icon));
+    QVERIFY(iconCache->cacheCost() <= iconCost);
+
+    iconCache->resetCounters();
+    QCOMPARE(iconCache->hitCount(),quint64(0));
+    QCOMPARE(iconCache->missCount(),quint64(0));
+    iconCache->setCacheLimit(oldLimit);
+    iconCache->clear();
+}
+//异步加载图标:完成、合并、取消以及加载失败不缓存
+void BaseToolButtonBenchmark::iconLoaderAsync()
+{
+    BaseIconCache *iconCache = BaseIconCache::instance();
+    BaseIconLoader *iconLoader = BaseIconLoader::instance();
+    iconCache->clear();
+    QSignalSpy appliedSpy(iconLoader,SIGNAL(iconsApplied(int)));
+
+    //三个按钮请求相同的图标，合并为一次解码，完成后都设置为同一个缓存的图标
+    BaseToolButton btns[3];
+    for(int i=0;i<3;i++)
+    {
+        btns[i].setBtnIconAsync(BENCH_ICON_1,QSize(40,40),true);
+        QVERIFY(btns[i].icon().isNull());//默认占位图标为空图标
+    }
+    QCOMPARE(iconLoader->pendingCount(),1);
+    QTRY_COMPARE(appliedSpy.count(),1);
+    QCOMPARE(appliedSpy.at(0).at(0).toInt(),1);
+    QCOMPARE(iconLoader->pendingCount(),0);
+    QIcon icon;
+    QVERIFY(iconCache->findIcon(BENCH_ICON_1,QSize(40,40),true,&icon));
+    for(int i=0;i<3;i++)
+    {
+        QVERIFY(!btns[i].icon().isNull());
+        QCOMPARE(btns[i].icon().cacheKey(),icon.cacheKey());
+    }
+
+    //按钮析构时取消请求
+    BaseToolButton *destroyedBtn = new BaseToolButton();
+    destroyedBtn->setBtnIconAsync(BENCH_ICON_2,QSize(40,40),true);
+    QCOMPARE(iconLoader->pendingCount(),1);
+    delete destroyedBtn;
+    QCOMPARE(iconLoader->pendingCount(),0);
+    //重新(同步)设置图标时取消请求，之后到达的解码结果不会覆盖新图标
+    BaseToolButton resetBtn;
+    resetBtn.setBtnIconAsync(BENCH_ICON_3,QSize(40,40),true);
+    QCOMPARE(iconLoader->pendingCount(),1);
+    resetBtn.setBtnIcon(BENCH_ICON_4,QSize(40,40),true);
+    QCOMPARE(iconLoader->pendingCount(),0);
+    qint64 resetKey = resetBtn.icon().cacheKey();
+    QTest::qWait(100);
+    QCOMPARE(appliedSpy.count(),1);
+    QCOMPARE(resetBtn.icon().cacheKey(),resetKey);
+    QVERIFY(!iconCache->findIcon(BENCH_ICON_2,QSize(40,40),true,&icon));
+    QVERIFY(!iconCache->findIcon(BENCH_ICON_3,QSize(40,40),true,&icon));
+
+    //多状态图标在一个任务中解码，结果与同步的setBtnIcons()共享缓存
+    BaseToolButton iconsBtn;
+    iconsBtn.setBtnIconsAsync(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(50,50));
+    QCOMPARE(iconLoader->pendingCount(),1);
+    QTRY_COMPARE(appliedSpy.count(),2);
+    QVERIFY(!iconsBtn.icon().availableSizes(QIcon::Normal,QIcon::On).isEmpty());
+    QVERIFY(!iconsBtn.icon().availableSizes(QIcon::Disabled,QIcon::Off).isEmpty());
+    QVERIFY(iconCache->findIcons(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(50,50),&icon));
+    QCOMPARE(iconsBtn.icon().cacheKey(),icon.cacheKey());
+
+    //加载失败的图标(同步或异步)不缓存，文件出现后再次设置即可加载
+    QString lateIcon = QDir::temp().filePath("basetoolbutton_late_icon.ico");
+    QFile::remove(lateIcon);
+    BaseToolButton lateBtn;
+    lateBtn.setBtnIcon(lateIcon,QSize(40,40),true);
+    QVERIFY(lateBtn.icon().isNull());
+    QVERIFY(!iconCache->findIcon(lateIcon,QSize(40,40),true,&icon));
+    lateBtn.setBtnIconAsync(lateIcon,QSize(40,40),true);
+    QTRY_COMPARE(appliedSpy.count(),3);
+    QVERIFY(lateBtn.icon().isNull());
+    QVERIFY(!iconCache->findIcon(lateIcon,QSize(40,40),true,&icon));
+    QVERIFY(QFile::copy(BENCH_ICON_1,lateIcon));
+    lateBtn.setBtnIcon(lateIcon,QSize(40,40),true);
+    QVERIFY(!lateBtn.icon().isNull());
+    QVERIFY(iconCache->findIcon(lateIcon,QSize(40,40),true,&icon));
+    QFile::remove(lateIcon);
+    iconCache->clear();
+}
+//按下/释放事件分发(时间戳间隔大于防抖窗口，保证每次按下都被响应)
+void BaseToolButtonBenchmark::pressRelease_data()
+{
+    QTest::addColumn<bool>("antiShake");
+    QTest::addColumn<bool>("longPress");
+    QTest::addColumn<bool>("stats");
+    QTest::newRow("plain") << false << false << false;
+    QTest::newRow("antiShake") << true << false << false;
+    QTest::newRow("longPress") << false << true << false;
+    QTest::newRow("antiShake-longPress") << true << true << false;
+    QTest::newRow("antiShake-longPress-stats") << true << true << true;
+}
+
+void BaseToolButtonBenchmark::pressRelease()
+{
+    QFETCH(bool,antiShake);
+    QFETCH(bool,longPress);
+    QFETCH(bool,stats);
+    BaseButtonStats::setEnabled(stats);
+    BaseToolButton btn;
+    btn.resize(100,60);
+    btn.setBtnAntiShakeProperty(antiShake,200);
+    btn.setBtnLongPressProperty(longPress,500,3000);
+    int clickedCount = 0;
+    connect(&btn,&QAbstractButton::clicked,[&clickedCount](){clickedCount++;});
+    ulong timestamp = 1000;
+    QBENCHMARK
+    {
+        sendMouseEvent(&btn,QEvent::MouseButtonPress,timestamp);
+        sendMouseEvent(&btn,QEvent::MouseButtonRelease,timestamp+50);
+        timestamp += 1000;
+    }
+    QVERIFY(clickedCount > 0);
+    //长按定时由共享的时间轮提供，释放后不应残留活动定时
+    QCOMPARE(BaseTimerWheel::instance()->activeCount(),0);
+    BaseButtonStats::setEnabled(false);
+}
+//统计:直方图分位数取样本所在桶的上界，按钮及按钮组的计数(名称改变后记入新名称)，以及JSON导出
+void BaseToolButtonBenchmark::statsSnapshot()
+{
+    //1~100us各一个样本 50在[48,55]桶，90在[80,95]桶，99在[96,111]桶(不超过最大值100)
+    BaseLatencyHistogram histogram;
+    for(quint64 valueUs=1;valueUs<=100;valueUs++)
+    {
+        histogram.record(valueUs);
+    }
+    BaseHistogramSnapshot histogramSnapshot = histogram.snapshot();
+    QCOMPARE(histogramSnapshot.count,quint32(100));
+    QCOMPARE(histogramSnapshot.p50Us,quint64(55));
+    QCOMPARE(histogramSnapshot.p90Us,quint64(95));
+    QCOMPARE(histogramSnapshot.p99Us,quint64(100));
+    QCOMPARE(histogramSnapshot.maxUs,quint64(100));
+
+    BaseButtonStats::setEnabled(true);
+    BaseButtonStats::instance()->reset();
+    QButtonGroup btnGroup;
+    btnGroup.setObjectName("statsGroup");
+    BaseToolButton btn;
+    btn.resize(60,60);
+    btn.setBtnName("statsA");
+    btn.setBtnAntiShakeProperty(true,200);
+    btnGroup.addButton(&btn);
+    //单击 防抖丢弃 在按钮外释放(不点击)
+    sendMouseEvent(&btn,QEvent::MouseButtonPress,1000);
+    sendMouseEvent(&btn,QEvent::MouseButtonRelease,1050);
+    sendMouseEvent(&btn,QEvent::MouseButtonPress,1100);
+    sendMouseEvent(&btn,QEvent::MouseButtonRelease,1150);
+    sendMouseEvent(&btn,QEvent::MouseButtonPress,1500);
+    sendMouseEvent(&btn,QEvent::MouseButtonRelease,1550,QPointF(-1,-1));
+    //改名后记入新名称的记录
+    btn.setBtnName("statsB");
+    sendMouseEvent(&btn,QEvent::MouseButtonPress,2000);
+    sendMouseEvent(&btn,QEvent::MouseButtonRelease,2050);
+    BaseButtonStats::setEnabled(false);
+
+    QHash<QString,BaseButtonStatsSnapshot> snapshotHash;
+    QList<BaseButtonStatsSnapshot> snapshotList = BaseButtonStats::instance()->snapshot();
+    for(int i=0;i<snapshotList.size();i++)
+    {
+        snapshotHash.insert(QString(snapshotList.at(i).isGroup?"group:":"btn:")+snapshotList.at(i).key,
+                            snapshotList.at(i));
+    }
+    QVERIFY(snapshotHash.contains("btn:statsA"));
+    QVERIFY(snapshotHash.contains("btn:statsB"));
+    QVERIFY(snapshotHash.contains("group:statsGroup"));
+    BaseButtonStatsSnapshot btnSnapshot = snapshotHash.value("btn:statsA");
+    QCOMPARE(btnSnapshot.pressCount,quint32(2));
+    QCOMPARE(btnSnapshot.clickCount,quint32(1));
+    QCOMPARE(btnSnapshot.rejectedCount,quint32(1));
+    QCOMPARE(btnSnapshot.pressLatency.count,quint32(2));
+    QCOMPARE(btnSnapshot.clickLatency.count,quint32(1));
+    QCOMPARE(btnSnapshot.pressDuration.count,quint32(2));
+    QCOMPARE(snapshotHash.value("btn:statsB").pressCount,quint32(1));
+    QCOMPARE(snapshotHash.value("btn:statsB").clickCount,quint32(1));
+    BaseButtonStatsSnapshot groupSnapshot = snapshotHash.value("group:statsGroup");
+    QCOMPARE(groupSnapshot.pressCount,quint32(3));
+    QCOMPARE(groupSnapshot.clickCount,quint32(2));
+    QCOMPARE(groupSnapshot.rejectedCount,quint32(1));
+
+    //JSON导出与快照一致
+    QJsonObject rootObject = QJsonDocument::fromJson(BaseButtonStats::instance()->exportJson()).object();
+    QJsonArray btnArray = rootObject.value("buttons").toArray();
+    QJsonArray groupArray = rootObject.value("groups").toArray();
+    QCOMPARE(btnArray.size()+groupArray.size(),snapshotList.size());
+    bool btnFound = false;
+    for(int i=0;i<btnArray.size();i++)
+    {
+        QJsonObject statsObject = btnArray.at(i).toObject();
+        if(statsObject.value("name").toString() == "statsA")
+        {
+            btnFound = true;
+            QCOMPARE(statsObject.value("pressCount").toInt(),2);
+            QCOMPARE(statsObject.value("clickCount").toInt(),1);
+            QCOMPARE(statsObject.value("rejectedCount").toInt(),1);
+            QCOMPARE(statsObject.value("clickLatency").toObject().value("count").toInt(),1);
+        }
+    }
+    QVERIFY(btnFound);
+    bool groupFound = false;
+    for(int i=0;i<groupArray.size();i++)
+    {
+        if(groupArray.at(i).toObject().value("name").toString() == "statsGroup")
+        {
+            groupFound = true;
+            QCOMPARE(groupArray.at(i).toObject().value("pressCount").toInt(),3);
+        }
+    }
+    QVERIFY(groupFound);
+    //清零后计数归零
+    BaseButtonStats::instance()->reset();
+    snapshotList = BaseButtonStats::instance()->snapshot();
+    for(int i=0;i<snapshotList.size();i++)
+    {
+        QCOMPARE(snapshotList.at(i).pressCount,quint32(0));
+        QCOMPARE(snapshotList.at(i).pressLatency.count,quint32(0));
+    }
+}
+//N个按钮同时长按 所有长按定时共享时间轮的一个QTimer，长按时间达到最大值后停止
+void BaseToolButtonBenchmark::longPressTimerCount_data()
+{
+    QTest::addColumn<int>("btnCount");
+    QTest::newRow("1") << 1;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void BaseToolButtonBenchmark::longPressTimerCount()
+{
+    QFETCH(int,btnCount);
+    BaseTimerWheel *timerWheel = BaseTimerWheel::instance();
+    QCOMPARE(timerWheel->timerCount(),0);
+    QWidget window;
+    QList<BaseToolButton *> btnList;
+    QVector<int> longPressCounts(btnCount,0);
+    QVector<uint> maxLongPressMs(btnCount,0);
+    for(int i=0;i<btnCount;i++)
+    {
+        BaseToolButton *btn = new BaseToolButton(&window);
+        btn->resize(60,60);
+        btn->setBtnLongPressProperty(true,100,300);
+        connect(btn,&BaseToolButton::longPressSig,[&longPressCounts,&maxLongPressMs,i](uint longPressMs){
+            longPressCounts[i]++;
+            maxLongPressMs[i] = qMax(maxLongPressMs[i],longPressMs);
+        });
+        btnList.append(btn);
+    }
+    for(int i=0;i<btnCount;i++)
+    {
+        sendMouseEvent(btnList.at(i),QEvent::MouseButtonPress,1000);
+    }
+    QCOMPARE(timerWheel->activeCount(),btnCount);
+    QCOMPARE(timerWheel->timerCount(),1);
+    //长按时间在最大值处截止(100/200/300各一次)，之后定时全部停止
+    QTRY_COMPARE(timerWheel->activeCount(),0);
+    QCOMPARE(timerWheel->timerCount(),0);
+    for(int i=0;i<btnCount;i++)
+    {
+        QCOMPARE(longPressCounts.at(i),3);
+        QCOMPARE(maxLongPressMs.at(i),uint(300));
+    }
+    for(int i=0;i<btnCount;i++)
+    {
+        sendMouseEvent(btnList.at(i),QEvent::MouseButtonRelease,5000);
+    }
+    QCOMPARE(timerWheel->activeCount(),0);
+    QCOMPARE(timerWheel->timerCount(),0);
+}
+//长按加速曲线与限频 虚拟时钟下逐格推进时间轮，长按时间序列确定
+void BaseToolButtonBenchmark::longPressRampRateLimit()
+{
+    BaseTimerWheel *wheel = BaseTimerWheel::instance();
+    QTRY_COMPARE(wheel->activeCount(),0);
+    wheel->setVirtualClock(true,200000);
+    BaseToolButton btn;
+    btn.resize(60,60);
+    QSignalSpy longPressSpy(&btn,SIGNAL(longPressSig(uint)));
+    //加速曲线:间隔400ms起每次减半，最小100ms，到1500ms结束
+    btn.setBtnLongPressProperty(true,400,1500);
+    btn.setBtnLongPressRamp(100,0.5);
+    sendMouseEvent(&btn,QEvent::MouseButtonPress,200000);
+    wheel->advanceTo(203000);
+    QList<uint> longPressList;
+    for(int i=0;i<longPressSpy.count();i++)
+    {
+        longPressList.append(longPressSpy.at(i).at(0).toUInt());
+    }
+    QCOMPARE(longPressList,QList<uint>() << 400 << 600 << 700 << 800 << 900 << 1000 << 1100 << 1200
+             << 1300 << 1400 << 1500);
+    sendMouseEvent(&btn,QEvent::MouseButtonRelease,203000);
+    QCOMPARE(wheel->activeCount(),0);
+
+    //限频:间隔100ms，每秒最多4次(相邻信号至少间隔250ms)，最后一次总是发出并携带最新的长按时间
+    longPressSpy.clear();
+    btn.setBtnLongPressProperty(true,100,2000);
+    btn.setBtnLongPressRamp(100,1.0);
+    btn.setBtnLongPressRateLimit(4);
+    wheel->advanceTo(210000);
+    sendMouseEvent(&btn,QEvent::MouseButtonPress,210000);
+    wheel->advanceTo(213000);
+    longPressList.clear();
+    for(int i=0;i<longPressSpy.count();i++)
+    {
+        longPressList.append(longPressSpy.at(i).at(0).toUInt());
+    }
+    QCOMPARE(longPressList,QList<uint>() << 100 << 400 << 700 << 1000 << 1300 << 1600 << 1900 << 2000);
+    sendMouseEvent(&btn,QEvent::MouseButtonRelease,213000);
+    QCOMPARE(wheel->activeCount(),0);
+    wheel->setVirtualClock(false);
+}
+//合并投递中继:接收者处理前的多个长按时间只投递最新值，释放后丢弃尚未投递的值；一个中继只能由一个按钮使用
+void BaseToolButtonBenchmark::longPressRelay()
+{
+    BaseTimerWheel *wheel = BaseTimerWheel::instance();
+    QTRY_COMPARE(wheel->activeCount(),0);
+    wheel->setVirtualClock(true,300000);
+    BaseLatestRelay relay;
+    QSignalSpy relaySpy(&relay,SIGNAL(latestSig(uint)));
+    BaseToolButton btnA;
+    btnA.resize(60,60);
+    btnA.setBtnLongPressProperty(true,100,1000);
+    QVERIFY(btnA.setBtnLongPressRelay(&relay));
+    QCOMPARE(relay.getOwner(),static_cast<QObject *>(&btnA));
+    //其他按钮不能共享该中继
+    BaseToolButton btnB;
+    QTest::ignoreMessage(QtWarningMsg,"BaseToolButton::setBtnLongPressRelay: relay is already used by another button");
+    QVERIFY(!btnB.setBtnLongPressRelay(&relay));
+    QCOMPARE(relay.getOwner(),static_cast<QObject *>(&btnA));
+
+    //三次长按在事件循环处理前合并，只投递最新值
+    sendMouseEvent(&btnA,QEvent::MouseButtonPress,300000);
+    wheel->advanceTo(300300);
+    QCOMPARE(relay.getCoalescedCount(),quint32(2));
+    QCoreApplication::processEvents();
+    QCOMPARE(relaySpy.count(),1);
+    QCOMPARE(relaySpy.at(0).at(0).toUInt(),300u);
+    //释放前尚未投递的值被丢弃
+    wheel->advanceTo(300500);
+    sendMouseEvent(&btnA,QEvent::MouseButtonRelease,300500);
+    QCoreApplication::processEvents();
+    QCOMPARE(relaySpy.count(),1);
+    //再次按下后投递新的值
+    wheel->advanceTo(301000);
+    sendMouseEvent(&btnA,QEvent::MouseButtonPress,301000);
+    wheel->advanceTo(301100);
+    QCoreApplication::processEvents();
+    QCOMPARE(relaySpy.count(),2);
+    QCOMPARE(relaySpy.at(1).at(0).toUInt(),100u);
+    sendMouseEvent(&btnA,QEvent::MouseButtonRelease,301100);
+    //按钮解除绑定后中继可以由其他按钮使用
+    QVERIFY(btnA.setBtnLongPressRelay(NULL));
+    QVERIFY(relay.getOwner() == NULL);
+    QVERIFY(btnB.setBtnLongPressRelay(&relay));
+    QCOMPARE(relay.getOwner(),static_cast<QObject *>(&btnB));
+    wheel->setVirtualClock(false);
+}
+//单选切换(QButtonGroup/BaseButtonGroup)
+void BaseToolButtonBenchmark::groupExclusiveSwitch_data()
+{
+    QTest::addColumn<int>("btnCount");
+    QTest::addColumn<bool>("baseGroup");
+    QTest::newRow("4") << 4 << false;
+    QTest::newRow("100") << 100 << false;
+    QTest::newRow("baseGroup-4") << 4 << true;
+    QTest::newRow("baseGroup-100") << 100 << true;
+}
+
+void BaseToolButtonBenchmark::groupExclusiveSwitch()
+{
+    QFETCH(int,btnCount);
+    QFETCH(bool,baseGroup);
+    QWidget parentWidget;
+    QButtonGroup btnGroup;
+    BaseButtonGroup baseBtnGroup;
+    for(int i=0;i<btnCount;i++)
+    {
+        BaseToolButton *btn = new BaseToolButton(&parentWidget);
+        btn->setCheckable(true);
+        if(baseGroup)
+        {
+            baseBtnGroup.addButton(btn,i);
+        }
+        else
+        {
+            btnGroup.addButton(btn,i);
+        }
+    }
+    int index = 0;
+    QBENCHMARK
+    {
+        if(baseGroup)
+        {
+            baseBtnGroup.button(index)->click();
+        }
+        else
+        {
+            btnGroup.button(index)->click();
+        }
+        index = (index+1)%btnCount;
+    }
+    int oldId = (index+btnCount-1)%btnCount;
+    if(baseGroup)
+    {
+        QCOMPARE(baseBtnGroup.getCheckedId(),oldId);
+    }
+
+    //再切换一次并逐个成员统计toggled信号:只有旧的和新的选中按钮改变状态(所以只有这两个按钮重绘)
+    int newId = (oldId+btnCount/2)%btnCount;
+    QList<QSignalSpy *> spyList;
+    for(int i=0;i<btnCount;i++)
+    {
+        QAbstractButton *btn = baseGroup?static_cast<QAbstractButton *>(baseBtnGroup.button(i)):
+                                         btnGroup.button(i);
+        spyList.append(new QSignalSpy(btn,SIGNAL(toggled(bool))));
+    }
+    if(baseGroup)
+    {
+        baseBtnGroup.button(newId)->click();
+        QCOMPARE(baseBtnGroup.getCheckedId(),newId);
+    }
+    else
+    {
+        btnGroup.button(newId)->click();
+    }
+    int toggledCount = 0;
+    for(int i=0;i<btnCount;i++)
+    {
+        toggledCount += spyList.at(i)->count();
+    }
+    QCOMPARE(toggledCount,2);
+    QCOMPARE(spyList.at(oldId)->count(),1);
+    QCOMPARE(spyList.at(oldId)->at(0).at(0).toBool(),false);
+    QCOMPARE(spyList.at(newId)->count(),1);
+    QCOMPARE(spyList.at(newId)->at(0).at(0).toBool(),true);
+    qDeleteAll(spyList);
+}
+//非互斥按钮组批量选中/取消(每次只发出一次btnsCheckChanged)
+void BaseToolButtonBenchmark::groupBulkCheck_data()
+{
+    QTest::addColumn<int>("btnCount");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void BaseToolButtonBenchmark::groupBulkCheck()
+{
+    QFETCH(int,btnCount);
+    QWidget parentWidget;
+    BaseButtonGroup baseBtnGroup;
+    baseBtnGroup.setExclusive(false);
+    for(int i=0;i<btnCount;i++)
+    {
+        BaseToolButton *btn = new BaseToolButton(&parentWidget);
+        btn->setCheckable(true);
+        baseBtnGroup.addButton(btn);
+    }
+    QSignalSpy toggledSpy(&baseBtnGroup,SIGNAL(btnToggled(BaseToolButton*,int,bool)));
+    QSignalSpy bulkSpy(&baseBtnGroup,SIGNAL(btnsCheckChanged()));
+    bool checked = true;
+    QBENCHMARK
+    {
+        baseBtnGroup.setAllChecked(checked);
+        checked = !checked;
+    }
+    QCOMPARE(toggledSpy.count(),0);
+    QVERIFY(bulkSpy.count() > 0);
+}
+/*
+ *@brief:   创建N个按钮，统计实际占用的堆内存(glibc的mallinfo统计创建前后的差值，包括QWidget私有数据等)，
+ * 并验证通过共享策略修改会作用到所有共享它的按钮，单独修改过的按钮不受影响
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ *@param:   btnCount:按钮数
+ *@param:   detached:是否每个按钮修改为独立的策略
+ *@return:  qreal:每个按钮的堆内存 字节
+ */
+qreal BaseToolButtonBenchmark::measureButtonHeap(int btnCount, bool detached)
+{
+    QWidget parentWidget;
+    BaseToolButtonPolicy keyPolicy;
+    keyPolicy.setAntiShakeEnabled(true);
+    keyPolicy.setLongPressEnabled(true);
+    //先创建一个按钮，让样式、默认策略等只分配一次的数据不计入差值
+    delete new BaseToolButton(&parentWidget);
+
+    QList<BaseToolButton *> btnList;
+    btnList.reserve(btnCount);
+    qint64 heapBefore = heapAllocatedBytes();
+    for(int i=0;i<btnCount;i++)
+    {
+        BaseToolButton *btn = new BaseToolButton(&parentWidget);
+        btn->setBtnPolicy(keyPolicy);
+        if(detached)
+        {
+            btn->setBtnAntiShakeProperty(true,100+i%10);
+        }
+        btnList.append(btn);
+    }
+    qint64 heapBytes = heapAllocatedBytes()-heapBefore;
+    keyPolicy.setLongPressRespondMs(500);
+    for(int i=0;i<btnList.size();i++)
+    {
+        BaseToolButtonPolicy btnPolicy = btnList.at(i)->getBtnPolicy();
+        if(btnPolicy.isSharedWith(keyPolicy) == detached ||
+                btnPolicy.getLongPressRespondMs() != (detached?3000u:500u))
+        {
+            return -1;
+        }
+    }
+    return qreal(heapBytes)/btnCount;
+}
+//N个按钮实际占用的堆内存 同一测试中测量共享策略和每个按钮独立策略两种布局，结果为该行布局每个按钮的字节数
+void BaseToolButtonBenchmark::memoryPerButton_data()
+{
+    QTest::addColumn<int>("btnCount");
+    QTest::addColumn<bool>("detached");
+    QTest::newRow("10000-shared") << 10000 << false;
+    QTest::newRow("10000-detached") << 10000 << true;
+}
+
+void BaseToolButtonBenchmark::memoryPerButton()
+{
+    QFETCH(int,btnCount);
+    QFETCH(bool,detached);
+    if(heapAllocatedBytes() < 0)
+    {
+        QSKIP("heap measurement requires glibc mallinfo");
+    }
+    //设置与共享策略相同的值不会复制私有的策略
+    BaseToolButtonPolicy keyPolicy;
+    BaseToolButton btn;
+    btn.setBtnPolicy(keyPolicy);
+    btn.setBtnAutoChecked(keyPolicy.getAutoChecked());
+    btn.setBtnAntiShakeProperty(keyPolicy.getAntiShakeEnabled(),keyPolicy.getAntiShakeWindowMs());
+    btn.setBtnLongPressProperty(keyPolicy.getLongPressEnabled(),keyPolicy.getLongPressRespondMs(),
+                                keyPolicy.getLongPressMaxMs());
+    btn.setBtnLongPressRamp(keyPolicy.getLongPressMinRespondMs(),keyPolicy.getLongPressRampFactor());
+    btn.setBtnLongPressRateLimit(keyPolicy.getLongPressMaxRate());
+    QVERIFY(btn.getBtnPolicy().isSharedWith(keyPolicy));
+    btn.setBtnLongPressRateLimit(keyPolicy.getLongPressMaxRate()+1);
+    QVERIFY(!btn.getBtnPolicy().isSharedWith(keyPolicy));
+
+    qreal sharedBytesPerBtn = measureButtonHeap(btnCount,false);
+    qreal detachedBytesPerBtn = measureButtonHeap(btnCount,true);
+    QVERIFY(sharedBytesPerBtn > 0);
+    QVERIFY(detachedBytesPerBtn > 0);
+    //共享策略时每个按钮不保存配置，比独立策略少(独立策略每个按钮多一份策略数据)
+    QVERIFY(sharedBytesPerBtn < detachedBytesPerBtn);
+    QTest::setBenchmarkResult(detached?detachedBytesPerBtn:sharedBytesPerBtn,QTest::BytesAllocated);
+}
+//绘制(样式表/原生样式/主题/渲染缓存)
+void BaseToolButtonBenchmark::paint_data()
+{
+    QTest::addColumn<int>("paintMode");
+    QTest::newRow("styleSheet") << 0;
+    QTest::newRow("native") << 1;
+    QTest::newRow("theme") << 2;
+    QTest::newRow("theme-renderCache") << 3;
+}
+
+void BaseToolButtonBenchmark::paint()
+{
+    QFETCH(int,paintMode);
+    BaseToolButton btn;
+    btn.setToolButtonStyle(Qt::ToolButtonTextUnderIcon);
+    btn.setText("paint");
+    btn.setBtnIcon(BENCH_ICON_2,QSize(40,40));
+    btn.resize(100,80);
+    if(paintMode == 0)
+    {
+        btn.setStyleSheet(BENCH_STYLE);
+    }
+    else if(paintMode >= 2)
+    {
+        btn.setBtnThemeEnabled(true);
+        btn.setBtnRenderCacheEnabled(paintMode == 3);
+    }
+    btn.ensurePolished();
+    QPixmap target(btn.size());
+    QBENCHMARK
+    {
+        btn.render(&target);
+    }
+}
+//渲染缓存:外观相同的按钮命中同一份外观，文本/尺寸/字体/状态改变后不再命中，文本恢复后重新命中
+void BaseToolButtonBenchmark::renderCacheHits()
+{
+    BaseRenderCache *renderCache = BaseRenderCache::instance();
+    renderCache->clear();
+    BaseToolButton btnA;
+    BaseToolButton btnB;
+    BaseToolButton *buttons[2] = {&btnA,&btnB};
+    for(int i=0;i<2;i++)
+    {
+        buttons[i]->setText("7");
+        buttons[i]->setCheckable(true);
+        buttons[i]->setBtnThemeEnabled(true);
+        buttons[i]->setBtnRenderCacheEnabled(true);
+        buttons[i]->resize(60,40);
+        buttons[i]->ensurePolished();
+    }
+    QPixmap target(80,40);
+    renderCache->resetCounters();
+    btnA.render(&target);
+    btnB.render(&target);
+    QCOMPARE(renderCache->missCount(),quint64(1));
+    QCOMPARE(renderCache->hitCount(),quint64(1));
+    //文本改变没有事件通知，重绘时比较后重新计算外观哈希
+    btnB.setText("8");
+    btnB.render(&target);
+    QCOMPARE(renderCache->missCount(),quint64(2));
+    btnB.setText("7");
+    btnB.render(&target);
+    QCOMPARE(renderCache->hitCount(),quint64(2));
+    //状态不参与外观哈希，选中状态相同的按钮之间共享
+    btnB.setChecked(true);
+    btnB.render(&target);
+    QCOMPARE(renderCache->missCount(),quint64(3));
+    btnA.setChecked(true);
+    btnA.render(&target);
+    QCOMPARE(renderCache->hitCount(),quint64(3));
+    //尺寸及字体(changeEvent通知)改变
+    btnB.resize(80,40);
+    btnB.render(&target);
+    QCOMPARE(renderCache->missCount(),quint64(4));
+    QFont font = btnA.font();
+    font.setPointSize(font.pointSize()+4);
+    btnA.setFont(font);
+    btnA.render(&target);
+    QCOMPARE(renderCache->missCount(),quint64(5));
+    QCOMPARE(renderCache->hitCount(),quint64(3));
+    QCOMPARE(renderCache->cacheCount(),5);
+    //布局方向不同(从右到左)的按钮不共享外观
+    btnB.resize(60,40);
+    btnB.setLayoutDirection(Qt::RightToLeft);
+    btnB.render(&target);
+    QCOMPARE(renderCache->missCount(),quint64(6));
+    QCOMPARE(renderCache->hitCount(),quint64(3));
+    //外观哈希和状态相同(哈希碰撞)但外观数据不同的键不命中
+    BaseRenderCacheKey keyA;
+    keyA.appearance = QByteArray("appearance-a");
+    keyA.appearanceKey = 1;
+    keyA.state = 0;
+    BaseRenderCacheKey keyB = keyA;
+    keyB.appearance = QByteArray("appearance-b");
+    QVERIFY(!(keyA == keyB));
+    QCOMPARE(qHash(keyA),qHash(keyB));
+    renderCache->insert(keyA,target);
+    QPixmap pixmap;
+    QVERIFY(!renderCache->find(keyB,&pixmap));
+    QVERIFY(renderCache->find(keyA,&pixmap));
+}
+//绘制长文本标签 样式默认排版(每次重绘都重新排版)与缓存的QStaticText(居左省略/主题)对比
+void BaseToolButtonBenchmark::paintLabel_data()
+{
+    QTest::addColumn<int>("labelMode");
+    QTest::newRow("style-default") << 0;
+    QTest::newRow("style-alignLeft-elide") << 1;
+    QTest::newRow("theme") << 2;
+}
+
+void BaseToolButtonBenchmark::paintLabel()
+{
+    QFETCH(int,labelMode);
+    BaseToolButton btn;
+    btn.setText(QString::fromUtf8("Translated label text that is wider than the button 长文本标签"));
+    btn.resize(120,40);
+    if(labelMode == 1)
+    {
+        btn.setBtnTextAlignLeft();
+        btn.setBtnTextElideMode(Qt::ElideRight);
+    }
+    else if(labelMode == 2)
+    {
+        btn.setBtnThemeEnabled(true);
+    }
+    btn.ensurePolished();
+    QPixmap target(btn.size());
+    QBENCHMARK
+    {
+        btn.render(&target);
+    }
+}
+//图标占用的内存 4个图标文件x7种尺寸共28个不同图标，qicon为各按钮的QIcon引用的图片像素(相同的只计一次)，
+//atlas为图集页的像素
+void BaseToolButtonBenchmark::iconMemory_data()
+{
+    QTest::addColumn<bool>("atlas");
+    QTest::newRow("qicon") << false;
+    QTest::newRow("atlas") << true;
+}
+
+void BaseToolButtonBenchmark::iconMemory()
+{
+    QFETCH(bool,atlas);
+    const char *iconUrls[4] = {BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,BENCH_ICON_4};
+    BaseIconCache::instance()->clear();
+    BaseIconAtlas::instance()->clear();
+    QWidget parentWidget;
+    QList<BaseToolButton *> btnList;
+    for(int i=0;i<4;i++)
+    {
+        for(int iconSize=16;iconSize<=64;iconSize+=8)
+        {
+            BaseToolButton *btn = new BaseToolButton(&parentWidget);
+            if(atlas)
+            {
+                btn->setBtnAtlasIcon(iconUrls[i],QSize(iconSize,iconSize),true);
+            }
+            else
+            {
+                btn->setBtnIcon(iconUrls[i],QSize(iconSize,iconSize),true);
+            }
+            btnList.append(btn);
+        }
+    }
+    qint64 bytes = 0;
+    if(atlas)
+    {
+        //图集页面的像素内存(所有按钮共享)
+        QCOMPARE(BaseIconAtlas::instance()->iconCount(),28);
+        QVERIFY(BaseIconAtlas::instance()->pageCount() >= 1);
+        bytes = BaseIconAtlas::instance()->memoryBytes();
+    }
+    else
+    {
+        //按钮的QIcon实际引用的像素内存(隐式共享的同一份像素只计一次)，与图集同样只统计图标像素
+        QSet<qint64> pixmapKeys;
+        for(int i=0;i<btnList.size();i++)
+        {
+            QIcon icon = btnList.at(i)->icon();
+            QList<QSize> iconSizes = icon.availableSizes();
+            QVERIFY(!iconSizes.isEmpty());
+            for(int j=0;j<iconSizes.size();j++)
+            {
+                QPixmap pixmap = icon.pixmap(iconSizes.at(j));
+                if(!pixmapKeys.contains(pixmap.cacheKey()))
+                {
+                    pixmapKeys.insert(pixmap.cacheKey());
+                    bytes += qint64(pixmap.width())*pixmap.height()*pixmap.depth()/8;
+                }
+            }
+        }
+    }
+    QVERIFY(bytes > 0);
+    QTest::setBenchmarkResult(bytes,QTest::BytesAllocated);
+}
+//绘制带三态图标的按钮 每个按钮持有QIcon与从共享图集绘制对比
+void BaseToolButtonBenchmark::paintIcon_data()
+{
+    iconMemory_data();
+}
+
+void BaseToolButtonBenchmark::paintIcon()
+{
+    QFETCH(bool,atlas);
+    BaseToolButton btn;
+    btn.setToolButtonStyle(Qt::ToolButtonTextUnderIcon);
+    btn.setText("icon");
+    btn.setCheckable(true);
+    btn.setChecked(true);
+    btn.setBtnThemeEnabled(true);
+    if(atlas)
+    {
+        btn.setBtnAtlasIcons(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(40,40));
+    }
+    else
+    {
+        btn.setBtnIcons(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(40,40));
+    }
+    btn.resize(100,80);
+    btn.ensurePolished();
+    QPixmap target(btn.size());
+    QBENCHMARK
+    {
+        btn.render(&target);
+    }
+}
+//清空图集后旧区域不再绘制(装入新图标后同一位置是无关的图标)
+void BaseToolButtonBenchmark::atlasClear()
+{
+    BaseIconAtlas *atlas = BaseIconAtlas::instance();
+    atlas->clear();
+    BaseIconAtlasRegion oldRegion = atlas->region(BENCH_ICON_1,QSize(32,32),false);
+    QVERIFY(atlas->isRegionValid(oldRegion));
+    atlas->clear();
+    BaseIconAtlasRegion newRegion = atlas->region(BENCH_ICON_2,QSize(32,32),false);
+    QCOMPARE(newRegion.page,oldRegion.page);
+    QCOMPARE(newRegion.rect.topLeft(),oldRegion.rect.topLeft());
+    QVERIFY(!atlas->isRegionValid(oldRegion));
+    QVERIFY(atlas->isRegionValid(newRegion));
+
+    QImage emptyImage(40,40,QImage::Format_ARGB32_Premultiplied);
+    emptyImage.fill(Qt::transparent);
+    QImage target = emptyImage;
+    QPainter painter(&target);
+    atlas->draw(&painter,target.rect(),oldRegion);
+    QCOMPARE(target,emptyImage);
+    atlas->draw(&painter,target.rect(),newRegion);
+    painter.end();
+    QVERIFY(target != emptyImage);
+    atlas->clear();
+}
+//动画驱动的一帧(推进N个按钮的长按进度环并重绘其区域)
+void BaseToolButtonBenchmark::animationFrame_data()
+{
+    QTest::addColumn<int>("btnCount");
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+}
+
+void BaseToolButtonBenchmark::animationFrame()
+{
+    QFETCH(int,btnCount);
+    QWidget window;
+    for(int i=0;i<btnCount;i++)
+    {
+        BaseToolButton *btn = new BaseToolButton(&window);
+        btn->setGeometry((i%10)*60,(i/10)*60,60,60);
+        btn->setBtnThemeEnabled(true);
+        btn->setBtnLongPressProperty(true,60000,60000);
+        btn->setBtnFeedback(BaseToolButton::LongPressRing);
+    }
+    window.resize(600,(btnCount+9)/10*60);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QList<BaseToolButton *> btnList = window.findChildren<BaseToolButton *>();
+    for(int i=0;i<btnList.size();i++)
+    {
+        sendMouseEvent(btnList.at(i),QEvent::MouseButtonPress,0);
+    }
+    BaseAnimationDriver *driver = BaseAnimationDriver::instance();
+    QCOMPARE(driver->activeCount(),btnCount);
+    QCOMPARE(driver->timerCount(),1);
+    QBENCHMARK
+    {
+        QMetaObject::invokeMethod(driver,"frameTimerSlot",Qt::DirectConnection);
+        QCoreApplication::processEvents();
+    }
+    for(int i=0;i<btnList.size();i++)
+    {
+        btnList.at(i)->releaseBtn();
+    }
+}
+//触摸单击:按下/释放各处理一次，合成的鼠标事件不会重复触发信号
+void BaseToolButtonBenchmark::touchTap()
+{
+    QWidget window;
+    BaseToolButton *btn = new BaseToolButton(&window);
+    btn->setGeometry(10,10,100,60);
+    btn->setBtnTouchEnabled(true);
+    window.resize(200,100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QSignalSpy pressedSpy(btn,SIGNAL(pressed()));
+    QSignalSpy clickedSpy(btn,SIGNAL(clicked()));
+
+    QPoint center = btn->geometry().center();
+    QTest::touchEvent(&window,touchDevice).press(0,center,&window);
+    QVERIFY(btn->isDown());
+    QTest::touchEvent(&window,touchDevice).release(0,center,&window);
+    QVERIFY(!btn->isDown());
+    QCoreApplication::processEvents();
+    QCOMPARE(pressedSpy.count(),1);
+    QCOMPARE(clickedSpy.count(),1);
+}
+//触摸防抖:连续两次快速点击，第二次以触摸事件的时间戳判断在防抖窗口内
+void BaseToolButtonBenchmark::touchAntiShake()
+{
+    QWidget window;
+    BaseToolButton *btn = new BaseToolButton(&window);
+    btn->setGeometry(10,10,100,60);
+    btn->setBtnTouchEnabled(true);
+    btn->setBtnAntiShakeProperty(true,10000);
+    window.resize(200,100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QSignalSpy clickedSpy(btn,SIGNAL(clicked()));
+
+    QPoint center = btn->geometry().center();
+    for(int i=0;i<2;i++)
+    {
+        QTest::touchEvent(&window,touchDevice).press(0,center,&window);
+        QTest::touchEvent(&window,touchDevice).release(0,center,&window);
+    }
+    QCoreApplication::processEvents();
+    QCOMPARE(clickedSpy.count(),1);
+    QCOMPARE(btn->getBtnAntiShakeRejectedCount(),quint32(1));
+}
+//多点触摸:两个按钮同时按住，各自释放时各发出一次clicked
+void BaseToolButtonBenchmark::touchMultiPress()
+{
+    QWidget window;
+    BaseToolButton *btnA = new BaseToolButton(&window);
+    BaseToolButton *btnB = new BaseToolButton(&window);
+    btnA->setGeometry(10,10,80,60);
+    btnB->setGeometry(110,10,80,60);
+    btnA->setBtnTouchEnabled(true);
+    btnB->setBtnTouchEnabled(true);
+    window.resize(200,100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QSignalSpy clickedSpyA(btnA,SIGNAL(clicked()));
+    QSignalSpy clickedSpyB(btnB,SIGNAL(clicked()));
+
+    QPoint centerA = btnA->geometry().center();
+    QPoint centerB = btnB->geometry().center();
+    QTest::touchEvent(&window,touchDevice).press(0,centerA,&window).press(1,centerB,&window);
+    QVERIFY(btnA->isDown());
+    QVERIFY(btnB->isDown());
+    QTest::touchEvent(&window,touchDevice).release(0,centerA,&window).release(1,centerB,&window);
+    QVERIFY(!btnA->isDown());
+    QVERIFY(!btnB->isDown());
+    QCoreApplication::processEvents();
+    QCOMPARE(clickedSpyA.count(),1);
+    QCOMPARE(clickedSpyB.count(),1);
+}
+//反馈动画结束后动画驱动停止帧定时器
+void BaseToolButtonBenchmark::feedbackIdle()
+{
+    QWidget window;
+    BaseToolButton *btn = new BaseToolButton(&window);
+    btn->setGeometry(10,10,100,60);
+    btn->setCheckable(true);
+    btn->setBtnFeedback(BaseToolButton::PressRipple|BaseToolButton::CheckedFade);
+    window.resize(200,100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    BaseAnimationDriver *driver = BaseAnimationDriver::instance();
+    QTRY_COMPARE(driver->timerCount(),0);
+
+    sendMouseEvent(btn,QEvent::MouseButtonPress,0);
+    QVERIFY(driver->isActive(btn));
+    QCOMPARE(driver->timerCount(),1);
+    sendMouseEvent(btn,QEvent::MouseButtonRelease,0);
+    QVERIFY(btn->isChecked());
+    QVERIFY(driver->isActive(btn));
+    //波纹淡出和选中渐变结束后不再有活动动画
+    QTRY_COMPARE(driver->activeCount(),0);
+    QCOMPARE(driver->timerCount(),0);
+}
+//外部按键输入源:管道写入紧凑格式的按键事件，按名称和按钮组+id路由到按钮
+void BaseToolButtonBenchmark::inputSourceRoute()
+{
+#ifdef Q_OS_UNIX
+    QWidget window;
+    BaseToolButton *btnA = new BaseToolButton(&window);
+    btnA->setBtnName("keyA");
+    btnA->setBtnAntiShakeProperty(true,10000);
+    BaseToolButton *btnB = new BaseToolButton(&window);
+    QButtonGroup btnGroup;
+    btnGroup.addButton(btnB,7);
+    QSignalSpy clickedSpyA(btnA,SIGNAL(clicked()));
+    QSignalSpy clickedSpyB(btnB,SIGNAL(clicked()));
+
+    int pipeFds[2];
+    QVERIFY(::pipe(pipeFds) == 0);
+    BaseInputSource inputSource;
+    inputSource.mapKeyToButton(30,"keyA");
+    inputSource.mapKeyToGroup(31,&btnGroup,7);
+    QVERIFY(inputSource.start(pipeFds[0],BaseInputSource::RawFormat));
+    //按键码(本机字节序)+按下标记+保留
+    quint16 codes[2] = {30,31};
+    for(int i=0;i<2;i++)
+    {
+        for(int pressed=1;pressed>=0;pressed--)
+        {
+            char record[4];
+            memcpy(record,&codes[i],sizeof(quint16));
+            record[2] = char(pressed);
+            record[3] = 0;
+            QCOMPARE(int(::write(pipeFds[1],record,sizeof(record))),int(sizeof(record)));
+        }
+    }
+    QTRY_COMPARE(clickedSpyA.count(),1);
+    QTRY_COMPARE(clickedSpyB.count(),1);
+    //按键事件的时间戳与Qt输入事件为同一单调时钟，紧接着的按下仍在防抖窗口内
+    ulong nowMs = quint32(QElapsedTimer::msecsSinceReference());
+    btnA->externalPressBtn(nowMs);
+    btnA->externalReleaseBtn(nowMs+1);
+    QCOMPARE(clickedSpyA.count(),1);
+    QCOMPARE(btnA->getBtnAntiShakeRejectedCount(),quint32(1));
+    inputSource.stop();
+    ::close(pipeFds[0]);
+    ::close(pipeFds[1]);
+    QCOMPARE(inputSource.getDroppedCount(),0);
+#else
+    QSKIP("BaseInputSource reader requires a Unix platform");
+#endif
+}
+//队列满时丢弃按下(计数)，已放入按下的按键的释放使用保留的位置，不会丢失
+void BaseToolButtonBenchmark::inputSourceOverflow()
+{
+#ifdef Q_OS_UNIX
+    QWidget window;
+    BaseToolButton *btns[3];
+    QSignalSpy *clickedSpys[3];
+    int pipeFds[2];
+    QVERIFY(::pipe(pipeFds) == 0);
+    BaseInputSource inputSource(NULL,4);
+    for(int i=0;i<3;i++)
+    {
+        btns[i] = new BaseToolButton(&window);
+        clickedSpys[i] = new QSignalSpy(btns[i],SIGNAL(clicked()));
+        inputSource.mapKeyToButton(quint16(30+i),btns[i]);
+    }
+    QVERIFY(inputSource.start(pipeFds[0],BaseInputSource::RawFormat));
+    //三个按键依次按下后依次释放，写入期间GUI线程不取出事件
+    for(int pressed=1;pressed>=0;pressed--)
+    {
+        for(int i=0;i<3;i++)
+        {
+            char record[4];
+            quint16 code = quint16(30+i);
+            memcpy(record,&code,sizeof(quint16));
+            record[2] = char(pressed);
+            record[3] = 0;
+            QCOMPARE(int(::write(pipeFds[1],record,sizeof(record))),int(sizeof(record)));
+        }
+    }
+    //容量4:两个按下及其保留的释放占满队列，第三个按下被丢弃，它的释放一并丢弃
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    while(inputSource.getDroppedCount() == 0 && elapsedTimer.elapsed() < 5000)
+    {
+        QThread::msleep(1);
+    }
+    QCOMPARE(inputSource.getDroppedCount(),1);
+    QTRY_COMPARE(clickedSpys[0]->count(),1);
+    QTRY_COMPARE(clickedSpys[1]->count(),1);
+    QCOMPARE(clickedSpys[2]->count(),0);
+    for(int i=0;i<3;i++)
+    {
+        QVERIFY(!btns[i]->isDown());
+        delete clickedSpys[i];
+    }
+    inputSource.stop();
+    ::close(pipeFds[0]);
+    ::close(pipeFds[1]);
+    QCOMPARE(inputSource.getDroppedCount(),1);
+#else
+    QSKIP("BaseInputSource reader requires a Unix platform");
+#endif
+}
+//evdev事件丢失(SYN_DROPPED)后丢弃不完整的事件并重新同步:管道无法读取按键状态，按下中的按键被释放且不发出clicked
+void BaseToolButtonBenchmark::inputSourceResync()
+{
+#ifdef Q_OS_LINUX
+    QWidget window;
+    BaseToolButton *btn = new BaseToolButton(&window);
+    btn->setBtnName("keyR");
+    QSignalSpy pressedSpy(btn,SIGNAL(pressed()));
+    QSignalSpy clickedSpy(btn,SIGNAL(clicked()));
+
+    int pipeFds[2];
+    QVERIFY(::pipe(pipeFds) == 0);
+    BaseInputSource inputSource;
+    inputSource.mapKeyToButton(30,"keyR");
+    QVERIFY(inputSource.start(pipeFds[0],BaseInputSource::EvdevFormat));
+    //按下 同步 (内核缓冲区溢出)丢失 释放(不完整，丢弃) 同步
+    const quint16 types[5] = {EV_KEY,EV_SYN,EV_SYN,EV_KEY,EV_SYN};
+    const quint16 codes[5] = {30,SYN_REPORT,SYN_DROPPED,30,SYN_REPORT};
+    const qint32 values[5] = {1,0,0,0,0};
+    for(int i=0;i<5;i++)
+    {
+        struct input_event evdevEvent;
+        memset(&evdevEvent,0,sizeof(evdevEvent));
+        evdevEvent.type = types[i];
+        evdevEvent.code = codes[i];
+        evdevEvent.value = values[i];
+        QCOMPARE(int(::write(pipeFds[1],&evdevEvent,sizeof(evdevEvent))),int(sizeof(evdevEvent)));
+    }
+    QTRY_COMPARE(pressedSpy.count(),1);
+    QTRY_VERIFY(!btn->isDown());
+    QCOMPARE(clickedSpy.count(),0);
+    inputSource.stop();
+    ::close(pipeFds[0]);
+    ::close(pipeFds[1]);
+    QCOMPARE(inputSource.getDroppedCount(),0);
+#else
+    QSKIP("evdev resync requires Linux");
+#endif
+}
+//录制回放:虚拟时钟下防抖和长按的信号序列与标准轨迹一致，原速回放与最快速度回放的轨迹相同
+void BaseToolButtonBenchmark::replayGoldenTrace()
+{
+    QTRY_COMPARE(BaseTimerWheel::instance()->activeCount(),0);
+    QByteArray recordData = goldenRecord();
+    //头部10字节，10个事件共23字节(时间差不小于128ms的占2字节)
+    QCOMPARE(recordData.size(),33);
+    const QByteArray goldenTrace = "50 k clicked\n"
+                                   "700 k longPress 300\n"
+                                   "1000 k longPress 600\n"
+                                   "1300 k longPress 900\n"
+                                   "1600 k longPress 1200\n"
+                                   "1700 k clicked\n"
+                                   "1960 j clicked\n";
+    quint64 traceHashes[2] = {0,0};
+    for(int speed=BaseInputReplayer::AsFastAsPossible;speed>=BaseInputReplayer::RealTime;speed--)
+    {
+        BaseToolButton btnK;
+        btnK.setBtnName("k");
+        btnK.resize(60,60);
+        btnK.setBtnAntiShakeProperty(true,200);
+        btnK.setBtnLongPressProperty(true,300,1200);
+        BaseToolButton btnJ;
+        btnJ.setBtnName("j");
+        btnJ.resize(60,60);
+        BaseInputReplayer replayer;
+        QVERIFY(replayer.setData(recordData));
+        replayer.addButton(&btnK);
+        replayer.addButton(&btnJ);
+        replayer.setTailMs(100);
+        QSignalSpy finishedSpy(&replayer,SIGNAL(finished()));
+        QVERIFY(replayer.replay(BaseInputReplayer::Speed(speed)));
+        if(speed == BaseInputReplayer::RealTime)
+        {
+            QVERIFY(replayer.isReplaying());
+            QVERIFY(finishedSpy.wait(10000));
+        }
+        QCOMPARE(finishedSpy.count(),1);
+        QVERIFY(!BaseTimerWheel::instance()->isVirtualClock());
+        QCOMPARE(replayer.eventCount(),10);
+        QCOMPARE(replayer.trace(),goldenTrace);
+        QCOMPARE(btnK.getBtnAntiShakeRejectedCount(),quint32(1));
+        traceHashes[speed] = replayer.traceHash();
+    }
+    QCOMPARE(traceHashes[BaseInputReplayer::RealTime],traceHashes[BaseInputReplayer::AsFastAsPossible]);
+}
+//按下期间移出/移回按钮:录制为Leave/Enter事件，回放时移出即停止长按，移回后在按钮内释放仍发出clicked
+void BaseToolButtonBenchmark::replayDragOut()
+{
+    QTRY_COMPARE(BaseTimerWheel::instance()->activeCount(),0);
+    BaseToolButton recordBtn;
+    recordBtn.setBtnName("k");
+    recordBtn.resize(60,60);
+    BaseInputRecorder recorder;
+    recorder.addButton(&recordBtn);
+    QSignalSpy recordClickedSpy(&recordBtn,SIGNAL(clicked()));
+    sendMouseEvent(&recordBtn,QEvent::MouseButtonPress,1000);
+    sendMouseEvent(&recordBtn,QEvent::MouseMove,1100,QPointF(10,10));//按钮内移动不记录
+    sendMouseEvent(&recordBtn,QEvent::MouseMove,1200,QPointF(-10,10));
+    QVERIFY(!recordBtn.isDown());
+    sendMouseEvent(&recordBtn,QEvent::MouseMove,1500,QPointF(10,10));
+    QVERIFY(recordBtn.isDown());
+    sendMouseEvent(&recordBtn,QEvent::MouseButtonRelease,1600);
+    sendMouseEvent(&recordBtn,QEvent::MouseButtonPress,2000);
+    sendMouseEvent(&recordBtn,QEvent::MouseMove,2100,QPointF(80,10));
+    sendMouseEvent(&recordBtn,QEvent::MouseButtonRelease,2200,QPointF(80,10));
+    QCOMPARE(recordClickedSpy.count(),1);
+    QCOMPARE(recorder.eventCount(),7);
+
+    BaseToolButton btnK;
+    btnK.setBtnName("k");
+    btnK.resize(60,60);
+    btnK.setBtnLongPressProperty(true,300,1200);
+    QSignalSpy releasedSpy(&btnK,SIGNAL(released()));
+    BaseInputReplayer replayer;
+    QVERIFY(replayer.setData(recorder.data()));
+    replayer.addButton(&btnK);
+    replayer.setTailMs(1000);
+    QVERIFY(replayer.replay(BaseInputReplayer::AsFastAsPossible));
+    QCOMPARE(replayer.eventCount(),7);
+    //1200ms移出时长按定时(1300ms到期)已停止，之后不再有长按信号
+    QCOMPARE(replayer.trace(),QByteArray("600 k clicked\n"));
+    QCOMPARE(releasedSpy.count(),3);//在按钮外释放时按钮已弹起，不再发出released
+    QVERIFY(!btnK.isDown());
+    QCOMPARE(BaseTimerWheel::instance()->activeCount(),0);
+}
+//最快速度回放N个事件(8个按钮交替单击，带防抖和长按)，不保存轨迹文本
+void BaseToolButtonBenchmark::replayThroughput_data()
+{
+    QTest::addColumn<int>("eventCount");
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("1000000") << 1000000;
+}
+
+void BaseToolButtonBenchmark::replayThroughput()
+{
+    QFETCH(int,eventCount);
+    QTRY_COMPARE(BaseTimerWheel::instance()->activeCount(),0);
+    BaseInputRecorder recorder;
+    for(int i=0;i<eventCount/2;i++)
+    {
+        QString btnName = QString::number(i%8);
+        recorder.appendEvent(btnName,BaseInputRecorder::Press,qint64(i)*40);
+        recorder.appendEvent(btnName,BaseInputRecorder::Release,qint64(i)*40+(i%50 == 0?700:20));
+    }
+    QList<BaseToolButton *> btnList;
+    BaseInputReplayer replayer;
+    QVERIFY(replayer.setData(recorder.data()));
+    for(int i=0;i<8;i++)
+    {
+        BaseToolButton *btn = new BaseToolButton;
+        btn->setBtnName(QString::number(i));
+        btn->setBtnAntiShakeProperty(true,200);
+        btn->setBtnLongPressProperty(true,500,3000);
+        replayer.addButton(btn);
+        btnList.append(btn);
+    }
+    replayer.setTraceEnabled(false);
+    replayer.setTailMs(0);
+    QBENCHMARK_ONCE
+    {
+        QVERIFY(replayer.replay(BaseInputReplayer::AsFastAsPossible));
+    }
+    QCOMPARE(replayer.eventCount(),eventCount/2*2);
+    QVERIFY(replayer.trace().isEmpty());
+    qDeleteAll(btnList);
+}
+//状态机核心:不创建控件，在虚拟时钟下验证防抖、长按、自动选中的事件序列及禁用特性的空基类优化
+void BaseToolButtonBenchmark::coreStateMachine()
+{
+    BaseButtonCore<BenchVirtualClock> core;
+    core.config().setAntiShakeWindowMs(200);
+    core.config().setLongPressRespondMs(300);
+    core.config().setLongPressMaxMs(1200);
+    core.setCheckable(true);
+    BenchVirtualClock::currentMs = 1000;
+    QCOMPARE(core.press(0),uint(BaseButtonEvent::Pressed));
+    QCOMPARE(core.release(true),uint(BaseButtonEvent::Released|BaseButtonEvent::Clicked|BaseButtonEvent::Toggled));
+    QVERIFY(core.isChecked());
+    QCOMPARE(core.press(1100),uint(BaseButtonEvent::Rejected));
+    QCOMPARE(core.release(true),uint(BaseButtonEvent::NoEvent));
+    QCOMPARE(core.press(1400),uint(BaseButtonEvent::Pressed));
+    QCOMPARE(core.nextDeadline(),qint64(1700));
+    QList<uint> longPressList;
+    for(qint64 nowMs=1400;nowMs<=3000;nowMs+=10)
+    {
+        if(core.advance(nowMs) & BaseButtonEvent::LongPressed)
+        {
+            longPressList.append(core.longPressElapsedMs());
+        }
+    }
+    QCOMPARE(longPressList,QList<uint>() << 300 << 600 << 900 << 1200);
+    QCOMPARE(core.nextDeadline(),qint64(-1));
+    QCOMPARE(core.release(false),uint(BaseButtonEvent::Released));
+    QVERIFY(core.isChecked());
+    QCOMPARE(core.debounce().getRejectedCount(),quint32(1));
+    //未启用的特性不占用内存
+    QCOMPARE(sizeof(BaseButtonCore<BenchVirtualClock,BaseButtonFeature::NoFeature>),sizeof(bool));
+    //以共享的行为策略作为配置时核心只保存策略指针和运行状态
+    QVERIFY(sizeof(BaseButtonCore<BenchVirtualClock,BaseButtonFeature::AntiShake|BaseButtonFeature::LongPress,
+                   BaseToolButtonPolicy>) <
+            sizeof(BaseButtonCore<BenchVirtualClock,BaseButtonFeature::AntiShake|BaseButtonFeature::LongPress>));
+}
+//节流策略按固定时间片限速 时间片内只响应一次，时间片边界两侧的按下都会响应
+void BaseToolButtonBenchmark::debounceThrottle()
+{
+    BaseDebounceCore throttle(BaseDebounceCore::Throttle,200);
+    QVERIFY(throttle.acceptPress(150));
+    QVERIFY(!throttle.acceptPress(199));
+    //边界两侧间隔2ms的两次按下都响应(节流不保证最小间隔)
+    QVERIFY(throttle.acceptPress(201));
+    QVERIFY(!throttle.acceptPress(300));
+    QVERIFY(!throttle.acceptPress(399));
+    QVERIFY(throttle.acceptPress(400));
+    QCOMPARE(throttle.getRejectedCount(),quint32(3));
+    //同样的序列在前沿策略下按与上一次响应的间隔判断，边界附近的抖动被丢弃
+    BaseDebounceCore leadingEdge(BaseDebounceCore::LeadingEdge,200);
+    QVERIFY(leadingEdge.acceptPress(150));
+    QVERIFY(!leadingEdge.acceptPress(199));
+    QVERIFY(!leadingEdge.acceptPress(201));
+    QVERIFY(leadingEdge.acceptPress(400));
+}
+//后沿防抖与按钮组共享防抖窗口 事件时间戳为0时按钮使用时间轮的单调时钟，虚拟时钟下按下时刻确定
+void BaseToolButtonBenchmark::debounceTrailingGroup()
+{
+    BaseTimerWheel *wheel = BaseTimerWheel::instance();
+    QTRY_COMPARE(wheel->activeCount(),0);
+    wheel->setVirtualClock(true,500000);
+
+    //后沿:每次按下(包括被丢弃的)都重新开始窗口，距离上一次按下静默200ms后才再次响应
+    const qint64 pressMs[7] = {0,150,300,450,650,700,900};
+    const bool trailingAccepted[7] = {true,false,false,false,true,false,true};
+    //同样的序列在前沿策略下按与上一次响应的间隔判断
+    const bool leadingAccepted[7] = {true,false,true,false,true,false,true};
+    for(int policyIndex=0;policyIndex<2;policyIndex++)
+    {
+        bool trailing = (policyIndex == 0);
+        qint64 baseMs = 500000+policyIndex*10000;
+        BaseToolButton btn;
+        btn.resize(60,60);
+        btn.setBtnLongPressProperty(false);
+        btn.setBtnAntiShakeProperty(true,200);
+        btn.setBtnAntiShakePolicy(trailing?BaseDebounce::TrailingEdge:BaseDebounce::LeadingEdge);
+        QSignalSpy clickedSpy(&btn,SIGNAL(clicked()));
+        int clickedCount = 0;
+        for(int i=0;i<7;i++)
+        {
+            wheel->advanceTo(baseMs+pressMs[i]);
+            sendMouseEvent(&btn,QEvent::MouseButtonPress,0);
+            sendMouseEvent(&btn,QEvent::MouseButtonRelease,0);
+            clickedCount += (trailing?trailingAccepted[i]:leadingAccepted[i])?1:0;
+            QCOMPARE(clickedSpy.count(),clickedCount);
+        }
+        QCOMPARE(btn.getBtnAntiShakeRejectedCount(),quint32(7-clickedCount));
+    }
+
+    //按钮组共享防抖窗口:组内任一按钮被响应后，整个组在窗口内的按下都被丢弃
+    QButtonGroup buttonGroup;
+    buttonGroup.setExclusive(false);
+    BaseToolButton groupBtns[3];
+    QList<QSignalSpy *> spyList;
+    for(int i=0;i<3;i++)
+    {
+        groupBtns[i].resize(60,60);
+        groupBtns[i].setBtnLongPressProperty(false);
+        groupBtns[i].setBtnAntiShakeProperty(true,200);
+        buttonGroup.addButton(&groupBtns[i]);
+        groupBtns[i].setBtnAntiShakeGroup(&buttonGroup);
+        spyList.append(new QSignalSpy(&groupBtns[i],SIGNAL(clicked())));
+    }
+    BaseToolButton soloBtn;//不在组内的按钮独立防抖
+    soloBtn.resize(60,60);
+    soloBtn.setBtnLongPressProperty(false);
+    soloBtn.setBtnAntiShakeProperty(true,200);
+    QSignalSpy soloSpy(&soloBtn,SIGNAL(clicked()));
+
+    //前沿:按钮序号和按下时刻
+    const int leadingBtn[6] = {0,1,2,1,0,2};
+    const qint64 leadingMs[6] = {0,100,150,200,250,400};
+    for(int i=0;i<6;i++)
+    {
+        wheel->advanceTo(520000+leadingMs[i]);
+        sendMouseEvent(&groupBtns[leadingBtn[i]],QEvent::MouseButtonPress,0);
+        sendMouseEvent(&groupBtns[leadingBtn[i]],QEvent::MouseButtonRelease,0);
+        if(leadingMs[i] == 100)
+        {
+            sendMouseEvent(&soloBtn,QEvent::MouseButtonPress,0);
+            sendMouseEvent(&soloBtn,QEvent::MouseButtonRelease,0);
+        }
+    }
+    for(int i=0;i<3;i++)
+    {
+        QCOMPARE(spyList.at(i)->count(),1);
+        QCOMPARE(groupBtns[i].getBtnAntiShakeRejectedCount(),quint32(3));//共享窗口时为整个组的计数
+    }
+    QCOMPARE(soloSpy.count(),1);
+    QCOMPARE(soloBtn.getBtnAntiShakeRejectedCount(),quint32(0));
+
+    //修改组内一个按钮的策略时整个组改为后沿:其他按钮的按下同样重新开始共享的窗口
+    groupBtns[0].setBtnAntiShakePolicy(BaseDebounce::TrailingEdge);
+    const int trailingBtn[4] = {0,1,2,0};
+    const qint64 trailingMs[4] = {0,150,300,500};
+    for(int i=0;i<4;i++)
+    {
+        wheel->advanceTo(530000+trailingMs[i]);
+        sendMouseEvent(&groupBtns[trailingBtn[i]],QEvent::MouseButtonPress,0);
+        sendMouseEvent(&groupBtns[trailingBtn[i]],QEvent::MouseButtonRelease,0);
+    }
+    QCOMPARE(spyList.at(0)->count(),3);
+    QCOMPARE(spyList.at(1)->count(),1);
+    QCOMPARE(spyList.at(2)->count(),1);
+    QCOMPARE(groupBtns[0].getBtnAntiShakeRejectedCount(),quint32(5));
+    qDeleteAll(spyList);
+    wheel->setVirtualClock(false);
+}
+//状态机核心的转换吞吐 每次迭代为100万次按下/推进/释放
+void BaseToolButtonBenchmark::coreTransitions_data()
+{
+    QTest::addColumn<uint>("features");
+    QTest::newRow("none") << uint(BaseButtonFeature::NoFeature);
+    QTest::newRow("antiShake") << uint(BaseButtonFeature::AntiShake);
+    QTest::newRow("antiShake-longPress") << uint(BaseButtonFeature::AntiShake|BaseButtonFeature::LongPress);
+    QTest::newRow("all") << uint(BaseButtonFeature::AllFeatures);
+}
+
+void BaseToolButtonBenchmark::coreTransitions()
+{
+    QFETCH(uint,features);
+    const int count = 1000000;
+    uint eventCount = 0;
+    QBENCHMARK
+    {
+        switch(features)
+        {
+        case BaseButtonFeature::NoFeature:
+            eventCount = runCoreTransitions<BaseButtonFeature::NoFeature>(count);
+            break;
+        case BaseButtonFeature::AntiShake:
+            eventCount = runCoreTransitions<BaseButtonFeature::AntiShake>(count);
+            break;
+        case BaseButtonFeature::AntiShake|BaseButtonFeature::LongPress:
+            eventCount = runCoreTransitions<BaseButtonFeature::AntiShake|BaseButtonFeature::LongPress>(count);
+            break;
+        default:
+            eventCount = runCoreTransitions<BaseButtonFeature::AllFeatures>(count);
+            break;
+        }
+    }
+    QVERIFY(eventCount > 0);
+}
+//多个写线程同时写入按钮状态，每帧批量应用后各按钮为最后写入的值，写入数等于应用数加合并数
+void BaseToolButtonBenchmark::updaterThreads()
+{
+    const int threadCount = 4;
+    const int btnPerThread = 5;
+    const int count = 20000;
+    QWidget window;
+    BaseButtonUpdater updater(threadCount*btnPerThread);
+    for(int i=0;i<threadCount*btnPerThread;i++)
+    {
+        BaseToolButton *btn = new BaseToolButton(&window);
+        btn->setCheckable(true);
+        QCOMPARE(updater.addButton(btn),i);
+    }
+    QList<BenchUpdateWriter *> writerList;
+    for(int i=0;i<threadCount;i++)
+    {
+        writerList.append(new BenchUpdateWriter(&updater,i*btnPerThread,btnPerThread,count));
+        writerList.last()->start();
+    }
+    for(int i=0;i<threadCount;i++)
+    {
+        QVERIFY(writerList.at(i)->wait(30000));
+    }
+    qDeleteAll(writerList);
+    //每帧批量应用，全部应用后动画驱动停止
+    QTRY_COMPARE(updater.getAppliedCount()+updater.getCoalescedCount(),updater.getPostedCount());
+    QTRY_VERIFY(!BaseAnimationDriver::instance()->isActive(&updater));
+    QCOMPARE(updater.getPostedCount(),quint32(threadCount*count*3));
+    QVERIFY(updater.getCoalescedCount() > 0);
+    QList<BaseToolButton *> btnList = window.findChildren<BaseToolButton *>();
+    QCOMPARE(btnList.size(),threadCount*btnPerThread);
+    for(int i=0;i<btnList.size();i++)
+    {
+        int last = count-btnPerThread+i%btnPerThread;//该按钮最后一次写入的序号
+        QCOMPARE(btnList.at(i)->text(),QString::number(last));
+        QCOMPARE(btnList.at(i)->isChecked(),last%2 == 1);
+        QCOMPARE(btnList.at(i)->isEnabled(),last%3 != 0);
+    }
+    //批量应用的次数远少于写入次数，每批至少应用一个属性
+    QVERIFY(updater.getFlushCount() >= 1);
+    QVERIFY(updater.getAppliedCount() >= updater.getFlushCount());
+    QVERIFY(updater.getAppliedCount() < updater.getPostedCount());
+}
+//200个状态指示按钮，一帧内发生10000次文本/选中变化并重绘 GUI线程逐次设置与批量应用对比
+void BaseToolButtonBenchmark::batchedUpdates_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::newRow("direct") << false;
+    QTest::newRow("batched") << true;
+}
+
+void BaseToolButtonBenchmark::batchedUpdates()
+{
+    QFETCH(bool,batched);
+    const int btnCount = 200;
+    const int count = 10000;
+    QWidget window;
+    BaseButtonUpdater updater(btnCount);
+    QList<BaseToolButton *> btnList;
+    for(int i=0;i<btnCount;i++)
+    {
+        BaseToolButton *btn = new BaseToolButton(&window);
+        btn->setGeometry((i%20)*40,(i/20)*40,40,40);
+        btn->setBtnThemeEnabled(true);
+        btn->setCheckable(true);
+        updater.addButton(btn);
+        btnList.append(btn);
+    }
+    window.resize(800,(btnCount/20)*40);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QStringList textList;
+    for(int i=0;i<100;i++)
+    {
+        textList.append(QString::number(i));
+    }
+    QBENCHMARK
+    {
+        for(int i=0;i<count;i++)
+        {
+            int index = (i*7)%btnCount;
+            if(batched)
+            {
+                updater.postText(index,textList.at(i%100));
+                updater.postChecked(index,i%2 == 1);
+            }
+            else
+            {
+                btnList.at(index)->setText(textList.at(i%100));
+                btnList.at(index)->setChecked(i%2 == 1);
+            }
+        }
+        if(batched)
+        {
+            updater.flush();
+        }
+        QCoreApplication::sendPostedEvents();
+        window.repaint();
+    }
+    if(batched)
+    {
+        QVERIFY(updater.getCoalescedCount() > 0);
+    }
+}
+//图标包:像素与解码路径一致并共享映射的内存，按钮从图标包取图标；截断或偏移损坏的图标包无法打开
+void BaseToolButtonBenchmark::iconBundle()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QString bundleFile = tempDir.filePath("icons.bbib");
+    QList<QSize> iconSizes;
+    iconSizes<<QSize(32,32)<<QSize(40,40);
+    QVERIFY(BaseIconBundle::build(BENCH_IMAGES_DIR,iconSizes,true,bundleFile));
+    BaseIconBundle *iconBundle = BaseIconBundle::instance();
+    QVERIFY(iconBundle->open(bundleFile));
+    QCOMPARE(iconBundle->iconCount(),4*2*2);//4个图标*2个尺寸*是否放大
+    //像素与解码路径(图集的解码方式)一致，重复获取时共享同一份映射的像素
+    QImage decoded = QImage(BENCH_ICON_1).scaled(QSize(40,40),Qt::IgnoreAspectRatio,Qt::SmoothTransformation)
+            .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QImage bundled = iconBundle->image("1.ico",QSize(40,40),true);
+    QCOMPARE(bundled.format(),QImage::Format_ARGB32_Premultiplied);
+    QCOMPARE(bundled,decoded);
+    QCOMPARE(iconBundle->findImage(BENCH_ICON_1,QSize(40,40),true).constBits(),bundled.constBits());
+    QVERIFY(iconBundle->findImage(BENCH_ICON_1,QSize(48,48),false).isNull());
+    //只有打包目录(或setIconRoot()指定的目录)下的路径才使用图标包，其他目录的同名文件不匹配
+    QVERIFY(QDir(tempDir.path()).mkpath("other"));
+    QString otherIcon = tempDir.filePath("other/1.ico");
+    QVERIFY(QFile::copy(BENCH_ICON_1,otherIcon));
+    QVERIFY(iconBundle->findImage(otherIcon,QSize(40,40),true).isNull());
+    iconBundle->setIconRoot(tempDir.filePath("other"));
+    QCOMPARE(iconBundle->findImage(otherIcon,QSize(40,40),true).constBits(),bundled.constBits());
+    QVERIFY(iconBundle->findImage(BENCH_ICON_1,QSize(40,40),true).isNull());
+    iconBundle->setIconRoot(QString());
+
+    //按钮从图标包取图标，不再解码(不经过图标缓存)
+    BaseIconCache::instance()->clear();
+    BaseIconCache::instance()->resetCounters();
+    BaseToolButton btn;
+    btn.resize(60,60);
+    btn.setCheckable(true);
+    btn.setBtnIcons(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(32,32));
+    QVERIFY(btn.icon().isNull());
+    QCOMPARE(BaseIconCache::instance()->missCount(),quint64(0));
+    QImage normalImage = btn.grab().toImage();
+    btn.setChecked(true);
+    QVERIFY(btn.grab().toImage() != normalImage);
+    //关闭后已获取的图片仍然有效，之后设置的图标走解码路径
+    iconBundle->close();
+    QCOMPARE(bundled,decoded);
+    QCOMPARE(btn.grab().toImage().size(),normalImage.size());
+    btn.setBtnIcon(BENCH_ICON_1,QSize(32,32));
+    QVERIFY(!btn.icon().isNull());
+
+    //截断的文件无法打开(按钮仍引用原文件的映射，所以写到另一个文件)
+    QFile file(bundleFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray bundleData = file.readAll();
+    file.close();
+    QFile truncatedFile(tempDir.filePath("truncated.bbib"));
+    QVERIFY(truncatedFile.open(QIODevice::WriteOnly));
+    truncatedFile.write(bundleData.left(bundleData.size()-1));
+    truncatedFile.close();
+    QVERIFY(!iconBundle->open(truncatedFile.fileName()));
+    QVERIFY(!iconBundle->isOpen());
+    //像素数据偏移损坏(偏移加数据大小溢出回绕到文件内)的文件无法打开
+    QByteArray corruptData = bundleData;
+    quint64 corruptOffset = Q_UINT64_C(0xFFFFFFFFFFFFFF00);
+    memcpy(corruptData.data()+sizeof(BaseIconBundleHeader)+offsetof(BaseIconBundleEntry,dataOffset),
+           &corruptOffset,sizeof(corruptOffset));
+    QFile corruptFile(tempDir.filePath("corrupt.bbib"));
+    QVERIFY(corruptFile.open(QIODevice::WriteOnly));
+    corruptFile.write(corruptData);
+    corruptFile.close();
+    QVERIFY(!iconBundle->open(corruptFile.fileName()));
+    QVERIFY(!iconBundle->isOpen());
+}
+//启动时创建N个按钮并设置三态图标 decode为冷缓存解码图标文件，bundle为映射图标包(含open())
+void BaseToolButtonBenchmark::iconStartup_data()
+{
+    QTest::addColumn<bool>("bundle");
+    QTest::addColumn<int>("btnCount");
+    QTest::newRow("decode-100") << false << 100;
+    QTest::newRow("bundle-100") << true << 100;
+    QTest::newRow("decode-1000") << false << 1000;
+    QTest::newRow("bundle-1000") << true << 1000;
+}
+
+void BaseToolButtonBenchmark::iconStartup()
+{
+    QFETCH(bool,bundle);
+    QFETCH(int,btnCount);
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QString bundleFile = tempDir.filePath("icons.bbib");
+    QVERIFY(BaseIconBundle::build(BENCH_IMAGES_DIR,QList<QSize>()<<QSize(32,32),false,bundleFile));
+    BaseIconBundle::instance()->close();
+    const char *iconUrls[4] = {BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,BENCH_ICON_4};
+    QBENCHMARK
+    {
+        BaseIconCache::instance()->clear();
+        if(bundle)
+        {
+            BaseIconBundle::instance()->open(bundleFile);
+        }
+        QWidget parentWidget;
+        for(int i=0;i<btnCount;i++)
+        {
+            BaseToolButton *btn = new BaseToolButton(&parentWidget);
+            btn->setBtnIcons(iconUrls[i%4],iconUrls[(i+1)%4],iconUrls[(i+2)%4],QSize(32,32));
+        }
+        BaseIconBundle::instance()->close();
+    }
+}
+//1000个带主题和三态图标的按钮绘制整个窗口 控件版本与场景图版本对比
+void BaseToolButtonBenchmark::quickVsWidget_data()
+{
+    QTest::addColumn<bool>("quick");
+    QTest::newRow("widget") << false;
+    QTest::newRow("quick") << true;
+}
+
+void BaseToolButtonBenchmark::quickVsWidget()
+{
+    QFETCH(bool,quick);
+    const int btnCount = 1000;
+    const int columns = 40;
+    QSize windowSize(columns*40,(btnCount/columns)*40);
+    if(!quick)
+    {
+        QWidget window;
+        for(int i=0;i<btnCount;i++)
+        {
+            BaseToolButton *btn = new BaseToolButton(&window);
+            btn->setGeometry((i%columns)*40,(i/columns)*40,40,40);
+            btn->setBtnThemeEnabled(true);
+            btn->setCheckable(true);
+            btn->setChecked(i%2 == 0);
+            btn->setBtnIcons(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(32,32));
+        }
+        window.resize(windowSize);
+        window.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&window));
+        QBENCHMARK
+        {
+            window.grab();
+        }
+        return;
+    }
+#ifdef BASE_QUICK_BUTTON
+    QQuickWindow window;
+    for(int i=0;i<btnCount;i++)
+    {
+        BaseQuickButton *btn = new BaseQuickButton(window.contentItem());
+        btn->setPosition(QPointF((i%columns)*40,(i/columns)*40));
+        btn->setSize(QSizeF(40,40));
+        btn->setCheckable(true);
+        btn->setChecked(i%2 == 0);
+        btn->setBtnIcons(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(32,32));
+    }
+    window.resize(windowSize);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QBENCHMARK
+    {
+        window.grabWindow();
+    }
+    //1000个按钮只共享正常/选中两个纹理
+    QCOMPARE(BaseQuickButton::textureCount(),2);
+#else
+    QSKIP("Qt Quick module is not available");
+#endif
+}
+
+//场景图版本的输入处理:自动选中、防抖丢弃、长按信号序列、按下后移出、手动释放及禁用图标
+void BaseToolButtonBenchmark::quickButtonInput()
+{
+#ifdef BASE_QUICK_BUTTON
+    QQuickWindow window;
+    BaseQuickButton *btn = new BaseQuickButton(window.contentItem());
+    btn->setPosition(QPointF(10,10));
+    btn->setSize(QSizeF(60,60));
+    btn->setCheckable(true);
+    btn->setBtnAutoChecked(true);
+    btn->setBtnAntiShakeProperty(true,200);
+    btn->setBtnLongPressProperty(true,500,1500);
+    btn->setBtnIcons(BENCH_ICON_1,BENCH_ICON_2,QString(),QSize(32,32));
+    window.resize(100,100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QSignalSpy pressedSpy(btn,SIGNAL(pressed()));
+    QSignalSpy releasedSpy(btn,SIGNAL(released()));
+    QSignalSpy clickedSpy(btn,SIGNAL(clicked()));
+    QSignalSpy toggledSpy(btn,SIGNAL(toggled(bool)));
+    QSignalSpy longPressSpy(btn,SIGNAL(longPressSig(uint)));
+    const QPointF inside(40,40);
+    const QPointF outside(90,90);
+    //事件时间戳与长按定时使用同一虚拟时钟
+    BaseTimerWheel *wheel = BaseTimerWheel::instance();
+    wheel->setVirtualClock(true,100000);
+
+    //单击自动选中
+    sendQuickMouseEvent(&window,QEvent::MouseButtonPress,100000,inside);
+    QVERIFY(btn->isDown());
+    sendQuickMouseEvent(&window,QEvent::MouseButtonRelease,100050,inside);
+    QVERIFY(!btn->isDown());
+    QCOMPARE(clickedSpy.count(),1);
+    QCOMPARE(toggledSpy.count(),1);
+    QCOMPARE(toggledSpy.at(0).at(0).toBool(),true);
+    QVERIFY(btn->isChecked());
+    //防抖窗口内的按下被丢弃，之后的释放不做处理
+    sendQuickMouseEvent(&window,QEvent::MouseButtonPress,100100,inside);
+    QVERIFY(!btn->isDown());
+    sendQuickMouseEvent(&window,QEvent::MouseButtonRelease,100150,inside);
+    QCOMPARE(btn->getBtnAntiShakeRejectedCount(),quint32(1));
+    QCOMPARE(pressedSpy.count(),1);
+    QCOMPARE(clickedSpy.count(),1);
+    //长按:每500ms响应一次，到1500ms结束
+    wheel->advanceTo(100500);
+    sendQuickMouseEvent(&window,QEvent::MouseButtonPress,100500,inside);
+    wheel->advanceTo(102500);
+    QCOMPARE(longPressSpy.count(),3);
+    QCOMPARE(longPressSpy.at(0).at(0).toUInt(),500u);
+    QCOMPARE(longPressSpy.at(1).at(0).toUInt(),1000u);
+    QCOMPARE(longPressSpy.at(2).at(0).toUInt(),1500u);
+    sendQuickMouseEvent(&window,QEvent::MouseButtonRelease,102500,inside);
+    QCOMPARE(clickedSpy.count(),2);
+    QVERIFY(!btn->isChecked());
+    //按下后移出:显示为释放并停止长按，移回时重新按下，在按钮外释放不发出clicked
+    wheel->advanceTo(103000);
+    sendQuickMouseEvent(&window,QEvent::MouseButtonPress,103000,inside);
+    wheel->advanceTo(103200);
+    sendQuickMouseEvent(&window,QEvent::MouseMove,103200,outside);
+    QVERIFY(!btn->isDown());
+    QCOMPARE(releasedSpy.count(),3);
+    wheel->advanceTo(104000);
+    QCOMPARE(longPressSpy.count(),3);
+    sendQuickMouseEvent(&window,QEvent::MouseMove,104000,inside);
+    QVERIFY(btn->isDown());
+    QCOMPARE(pressedSpy.count(),4);
+    sendQuickMouseEvent(&window,QEvent::MouseMove,104050,outside);
+    sendQuickMouseEvent(&window,QEvent::MouseButtonRelease,104100,outside);
+    QCOMPARE(releasedSpy.count(),4);
+    QCOMPARE(clickedSpy.count(),2);
+    QVERIFY(!btn->isChecked());
+    //手动释放:发出released，不发出clicked，之后的释放事件不做处理
+    wheel->advanceTo(105000);
+    sendQuickMouseEvent(&window,QEvent::MouseButtonPress,105000,inside);
+    btn->releaseBtn();
+    QVERIFY(!btn->isDown());
+    QCOMPARE(releasedSpy.count(),5);
+    sendQuickMouseEvent(&window,QEvent::MouseButtonRelease,105050,inside);
+    wheel->advanceTo(107000);
+    QCOMPARE(releasedSpy.count(),5);
+    QCOMPARE(clickedSpy.count(),2);
+    QCOMPARE(longPressSpy.count(),3);
+    QCOMPARE(toggledSpy.count(),2);
+    wheel->setVirtualClock(false);
+
+    //禁用图标为空时以半透明绘制正常图标(不加载新的纹理)，设置禁用图标后使用禁用图标的纹理
+    QImage enabledImage = window.grabWindow();
+    int textureCount = BaseQuickButton::textureCount();
+    btn->setEnabled(false);
+    QImage disabledImage = window.grabWindow();
+    QCOMPARE(BaseQuickButton::textureCount(),textureCount);
+    QVERIFY(disabledImage != enabledImage);
+    btn->setBtnIcons(BENCH_ICON_1,BENCH_ICON_2,BENCH_ICON_3,QSize(32,32));
+    window.grabWindow();
+    QCOMPARE(BaseQuickButton::textureCount(),textureCount+1);
+#else
+    QSKIP("Qt Quick module is not available");
+#endif
+}
+
+/*
+ *@brief:   默认使用offscreen平台，并在未指定输出时同时输出终端文本和xml结果文件
+ *@author:  缪庆瑞
+ *@date:    2026.10.17
+ */
+int main(int argc, char *argv[])
+{
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM","offscreen");
+    }
+#ifdef BASE_QUICK_BUTTON
+    //场景图默认使用软件后端
+    if(qEnvironmentVariableIsEmpty("QT_QUICK_BACKEND"))
+    {
+        qputenv("QT_QUICK_BACKEND","software");
+    }
+#endif
+    QApplication app(argc,argv);
+    QStringList args = app.arguments();
+    if(!args.contains("-o"))
+    {
+        args<<"-o"<<"benchmark_result.xml,xml"<<"-o"<<"-,txt";
+    }
+    BaseToolButtonBenchmark benchmark;
+    return QTest::qExec(&benchmark,args);
+}
+
+#include "tst_basetoolbutton.moc"
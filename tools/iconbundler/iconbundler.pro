@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# 图标打包工具(构建时使用) 将图标目录按使用的尺寸预解码为BaseIconBundle图标包
+# 用法: iconbundler -s 32x32 -s 48x48 [--scaled-up] <图标目录> <输出文件>
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+TARGET = iconbundler
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/../..
+DEPENDPATH += $$PWD/../..
+
+SOURCES += main.cpp \
+    $$PWD/../../baseiconbundle.cpp
+
+HEADERS += $$PWD/../../baseiconbundle.h
@@ -0,0 +1,92 @@
+/****************************************************************************
+*
+* Copyright (C) 2019-2026 MiaoQingrui. All rights reserved.
+* Author: 缪庆瑞 <justdoit_mqr@163.com>
+*
+****************************************************************************/
+/*
+ *@author: 缪庆瑞
+ *@date:   2026.10.17
+ *@brief:  图标打包工具
+ *
+ * 1.构建时将图标目录(含子目录)中的图标按使用的各个尺寸解码为预乘像素，打包为BaseIconBundle图标包，
+ * 运行时映射该文件，按钮不再解码图标文件。
+ * 2.用法: iconbundler -s 32x32 -s 48x48 [--scaled-up] <图标目录> <输出文件>
+ *   -s/--size       图标尺寸(setBtnIcon()/setBtnIcons()的iconSize)，可以指定多次，默认32x32
+ *   --scaled-up     同时打包放大(缩放)到各尺寸的图片(setBtnIcon()的scaledUp为true时使用)
+ * 注:像素按本机字节序保存，交叉编译时应在与目标机字节序相同的机器上打包。包中记录图标目录的绝对路径，
+ * 运行时图标在其他目录时需要调用BaseIconBundle::setIconRoot()。
+ */
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QStringList>
+#include <QTextStream>
+#include "baseiconbundle.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QTextStream errorStream(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Pack button icons into a pre-decoded BaseIconBundle file.");
+    parser.addHelpOption();
+    QCommandLineOption sizeOption(QStringList()<<"s"<<"size","Icon size, may be repeated (default 32x32).",
+                                  "WxH");
+    QCommandLineOption scaledUpOption("scaled-up","Also pack images scaled to each icon size.");
+    parser.addOption(sizeOption);
+    parser.addOption(scaledUpOption);
+    parser.addPositionalArgument("iconDir","Directory of icons.");
+    parser.addPositionalArgument("output","Output bundle file.");
+    parser.process(a);
+
+    QStringList arguments = parser.positionalArguments();
+    if(arguments.size() != 2)
+    {
+        parser.showHelp(1);
+    }
+    QList<QSize> iconSizes;
+    QStringList sizeList = parser.values(sizeOption);
+    if(sizeList.isEmpty())
+    {
+        sizeList.append("32x32");
+    }
+    for(int i=0;i<sizeList.size();i++)
+    {
+        QStringList sizeParts = sizeList.at(i).toLower().split('x');
+        bool widthOk = false;
+        bool heightOk = false;
+        QSize iconSize;
+        if(sizeParts.size() == 2)
+        {
+            iconSize = QSize(sizeParts.at(0).toInt(&widthOk),sizeParts.at(1).toInt(&heightOk));
+        }
+        if(!widthOk || !heightOk || iconSize.isEmpty() || iconSize.width() > 0xFFFF ||
+                iconSize.height() > 0xFFFF)
+        {
+            errorStream<<"invalid icon size: "<<sizeList.at(i)<<"\n";
+            return 1;
+        }
+        if(!iconSizes.contains(iconSize))
+        {
+            iconSizes.append(iconSize);
+        }
+    }
+
+    QString errorString;
+    if(!BaseIconBundle::build(arguments.at(0),iconSizes,parser.isSet(scaledUpOption),arguments.at(1),
+                              &errorString))
+    {
+        errorStream<<"iconbundler: "<<errorString<<"\n";
+        return 1;
+    }
+    if(!BaseIconBundle::instance()->open(arguments.at(1)))
+    {
+        errorStream<<"iconbundler: failed to verify "<<arguments.at(1)<<"\n";
+        return 1;
+    }
+    QTextStream(stdout)<<arguments.at(1)<<": "<<BaseIconBundle::instance()->iconCount()<<" icons, "
+                      <<BaseIconBundle::instance()->mappedBytes()<<" bytes\n";
+    BaseIconBundle::instance()->close();
+    return 0;
+}
@@ -103,50 +103,44 @@ void Widget::initBaseToolButtonUi()
     ui->baseToolButtonHLayout2->addWidget(textAndIconBtn[3]);
 
     //单选按钮组
-    btnGroup = new QButtonGroup(this);
+    btnGroup = new BaseButtonGroup(this);
+    //组内按钮共享同一个主题(代替逐个设置相同的样式表)
+    BaseToolButtonTheme groupTheme;
+    groupTheme.setPadding(BaseToolButtonTheme::Pressed,2);
+    groupTheme.setPadding(BaseToolButtonTheme::Checked,2);
+    groupTheme.setBackgroundColor(BaseToolButtonTheme::Checked,QColor(Qt::blue));
     BaseToolButton *groupBtn[4];
     groupBtn[0] = new BaseToolButton();
     groupBtn[0]->setToolButtonStyle(Qt::ToolButtonIconOnly);
     groupBtn[0]->setCheckable(true);
     groupBtn[0]->setBtnIcon("./images/2.ico");
     groupBtn[0]->setBtnName("groupBtn[0]");
-    groupBtn[0]->setStyleSheet(
-                "QToolButton{border-radius:5px;padding:2px;color:black;background-color:lightGray}"
-                "QToolButton:pressed{background-color:orange}"
-                "QToolButton:checked{background-color:blue}");
+    groupBtn[0]->setBtnTheme(groupTheme);
     groupBtn[1] = new BaseToolButton();
     groupBtn[1]->setToolButtonStyle(Qt::ToolButtonIconOnly);
     groupBtn[1]->setCheckable(true);
     groupBtn[1]->setBtnIcon("./images/4.ico");
     groupBtn[1]->setBtnName("groupBtn[1]");
-    groupBtn[1]->setStyleSheet(
-                "QToolButton{border-radius:5px;padding:2px;color:black;background-color:lightGray}"
-                "QToolButton:pressed{background-color:orange}"
-                "QToolButton:checked{background-color:blue}");
+    groupBtn[1]->setBtnTheme(groupTheme);
     groupBtn[2] = new BaseToolButton();
     groupBtn[2]->setToolButtonStyle(Qt::ToolButtonIconOnly);
     groupBtn[2]->setCheckable(true);
     groupBtn[2]->setBtnIcon("./images/3.ico");
     groupBtn[2]->setBtnName("groupBtn[2]");
-    groupBtn[2]->setStyleSheet(
-                "QToolButton{border-radius:5px;padding:2px;color:black;background-color:lightGray}"
-                "QToolButton:pressed{background-color:orange}"
-                "QToolButton:checked{background-color:blue}");
+    groupBtn[2]->setBtnTheme(groupTheme);
     groupBtn[3] = new BaseToolButton();
     groupBtn[3]->setToolButtonStyle(Qt::ToolButtonIconOnly);
     groupBtn[3]->setCheckable(true);
     groupBtn[3]->setBtnIcon("./images/1.ico");
     groupBtn[3]->setBtnName("groupBtn[3]");
-    groupBtn[3]->setStyleSheet(
-                "QToolButton{border-radius:5px;padding:2px;color:black;background-color:lightGray}"
-                "QToolButton:pressed{background-color:orange}"
-                "QToolButton:checked{background-color:blue}");
+    groupBtn[3]->setBtnTheme(groupTheme);
 
     btnGroup->addButton(groupBtn[0],4);
     btnGroup->addButton(groupBtn[1],3);
     btnGroup->addButton(groupBtn[2],2);
     btnGroup->addButton(groupBtn[3],1);
-    connect(btnGroup,SIGNAL(buttonClicked(int)),this,SLOT(singleButtonsSlot(int)));
+    connect(btnGroup,SIGNAL(btnClicked(BaseToolButton*,int,QString)),
+            this,SLOT(singleButtonsSlot(BaseToolButton*,int,QString)));
 
     ui->baseToolButtonHLayout3->addWidget(groupBtn[0]);
     ui->baseToolButtonHLayout3->addWidget(groupBtn[1]);
@@ -157,13 +151,15 @@ void Widget::initBaseToolButtonUi()
  *@brief:   按钮组点击响应槽
  *@author:  缪庆瑞
  *@date:    2020.04.03
- *@param:   btnIndex:按钮组按钮index
+ *@param:   btn:被点击的按钮
+ *@param:   btnId:按钮在组中的id
+ *@param:   btnName:按钮名称
  */
-void Widget::singleButtonsSlot(int btnIndex)
+void Widget::singleButtonsSlot(BaseToolButton *btn, int btnId, const QString &btnName)
 {
-    qDebug()<<"group index:"<<btnIndex;
-    BaseToolButton *btn = qobject_cast<BaseToolButton *>(btnGroup->button(btnIndex));
-    qDebug()<<"btn name:"<<btn->getBtnName();
+    Q_UNUSED(btn)
+    qDebug()<<"group id:"<<btnId;
+    qDebug()<<"btn name:"<<btnName;
 }
 //防抖测试
 void Widget::btnClickedSlot()
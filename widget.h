@@ -7,8 +7,8 @@
 #define WIDGET_H
 
 #include <QWidget>
-#include <QButtonGroup>
 #include "basetoolbutton.h"
+#include "basebuttongroup.h"
 
 namespace Ui {
 class Widget;
@@ -26,10 +26,10 @@ private:
     void initBaseToolButtonUi();//初始化BaseToolButton功能测试界面
 
     Ui::Widget *ui;
-    QButtonGroup *btnGroup;
+    BaseButtonGroup *btnGroup;
 
 public slots:
-    void singleButtonsSlot(int btnIndex);
+    void singleButtonsSlot(BaseToolButton *btn,int btnId,const QString &btnName);
     void btnClickedSlot();
     void btnLongPressSlot(uint longPressMs);
 